@@ -985,6 +985,17 @@ bool IOFile::Flush() {
     return IsOpen() && 0 == std::fflush(m_file);
 }
 
+bool IOFile::Sync() {
+    if (!Flush()) {
+        return false;
+    }
+#ifdef _WIN32
+    return 0 == _commit(_fileno(m_file));
+#else
+    return 0 == fsync(fileno(m_file));
+#endif
+}
+
 bool IOFile::Resize(u64 size) {
     return IsOpen() && 0 ==
 #ifdef _WIN32
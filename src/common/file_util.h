@@ -271,6 +271,9 @@ public:
     bool Resize(u64 size);
     bool Flush();
 
+    // Flushes the file and waits until its contents have reached the storage device
+    bool Sync();
+
     // clear error state
     void Clear() {
         std::clearerr(m_file);
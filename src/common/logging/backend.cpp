@@ -3,13 +3,19 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <climits>
 #include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 #ifdef _WIN32
 #include <share.h>   // For _SH_DENYWR
@@ -21,11 +27,87 @@
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
 #include "common/logging/text_formatter.h"
+#include "common/ring_buffer.h"
 #include "common/string_util.h"
 #include "common/threadsafe_queue.h"
 
 namespace Log {
 
+namespace {
+
+/// Raw log message stored in the per-thread buffers, followed by payload_size bytes of payload
+struct RecordHeader {
+    std::chrono::microseconds timestamp;
+    const char* filename;
+    const char* function;
+    const char* format;
+    DeferredFormatter formatter; ///< nullptr when the payload is the formatted message
+    unsigned int line_num;
+    u32 payload_size;
+    u32 suppressed; ///< Messages dropped by the rate limiter before this one
+    Class log_class;
+    Level log_level;
+};
+static_assert(std::is_trivially_copyable_v<RecordHeader>);
+
+/// Limits how many Info and Warning messages a single call site can log each second. Messages past
+/// the limit are dropped and counted, the count is reported with the next logged message.
+class RateLimiter {
+public:
+    /**
+     * Returns true when a message can be logged.
+     * @param suppressed Set to the number of messages from the same call site that were dropped
+     * since the last one that got logged.
+     */
+    bool Check(const char* filename, unsigned int line_num, std::chrono::microseconds timestamp,
+               u32& suppressed) {
+        const std::size_t hash = (reinterpret_cast<std::uintptr_t>(filename) >> 3) ^ line_num;
+        CallSite& site = call_sites[hash % call_sites.size()];
+        if (site.filename != filename || site.line_num != line_num) {
+            // Slots are shared on hash collisions, the previous call site starts again from zero
+            site = {filename, line_num, timestamp};
+        } else if (timestamp - site.window_start >= std::chrono::seconds{1}) {
+            site.window_start = timestamp;
+            site.count = 0;
+        }
+
+        if (site.count >= MAX_MESSAGES_PER_SECOND) {
+            ++site.suppressed;
+            return false;
+        }
+        ++site.count;
+        suppressed = site.suppressed;
+        site.suppressed = 0;
+        return true;
+    }
+
+private:
+    static constexpr u32 MAX_MESSAGES_PER_SECOND = 10;
+
+    struct CallSite {
+        const char* filename = nullptr;
+        unsigned int line_num = 0;
+        std::chrono::microseconds window_start{};
+        u32 count = 0;
+        u32 suppressed = 0;
+    };
+
+    std::array<CallSite, 64> call_sites{};
+};
+
+/// Log records of a single thread. The ring is written by its thread and read by the logging
+/// thread, the rest is only accessed by its thread.
+struct ThreadRecords {
+    static constexpr std::size_t RING_SIZE = 0x10000;
+
+    Common::RingBuffer<u8, RING_SIZE> ring;
+    std::atomic_bool is_abandoned{false}; ///< The thread exited, remove the ring once it's empty
+    RateLimiter rate_limiter;
+    std::vector<u8> staging; ///< Record being built, reused to avoid allocations
+};
+
+} // Anonymous namespace
+
 /**
  * Static state as a singleton.
  */
@@ -40,9 +122,31 @@ public:
     const Impl& operator=(Impl const&) = delete;
 
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+                   const char* function, const char* format, const fmt::format_args& args) {
+        RecordHeader header;
+        if (!BeginRecord(header, log_class, log_level, filename, line_num, function, format)) {
+            return;
+        }
+        header.formatter = nullptr;
+        const std::string message = fmt::vformat(format, args);
+        PushRecord(header, reinterpret_cast<const u8*>(message.data()), message.size());
+    }
+
+    void PushDeferredEntry(Class log_class, Level log_level, const char* filename,
+                           unsigned int line_num, const char* function, const char* format,
+                           DeferredFormatter formatter, const u8* args, std::size_t args_size) {
+        RecordHeader header;
+        if (!BeginRecord(header, log_class, log_level, filename, line_num, function, format)) {
+            return;
+        }
+        if (is_deferred_formatting) {
+            header.formatter = formatter;
+            PushRecord(header, args, args_size);
+            return;
+        }
+        header.formatter = nullptr;
+        const std::string message = formatter(format, args);
+        PushRecord(header, reinterpret_cast<const u8*>(message.data()), message.size());
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -66,6 +170,10 @@ public:
         filter = f;
     }
 
+    void SetDeferredFormatting(bool enabled) {
+        is_deferred_formatting = enabled;
+    }
+
     Backend* GetBackend(std::string_view backend_name) {
         const auto it =
             std::find_if(backends.begin(), backends.end(),
@@ -76,9 +184,27 @@ public:
     }
 
 private:
+    /// Keeps the records of a thread registered while the thread is alive
+    class ThreadRecordsHandle {
+    public:
+        explicit ThreadRecordsHandle(std::shared_ptr<ThreadRecords> records_)
+            : records{std::move(records_)} {}
+
+        ~ThreadRecordsHandle() {
+            records->is_abandoned = true;
+        }
+
+        ThreadRecords& Get() const {
+            return *records;
+        }
+
+    private:
+        std::shared_ptr<ThreadRecords> records;
+    };
+
     Impl() {
         backend_thread = std::thread([&] {
-            Entry entry;
+            std::string payload;
             auto write_logs = [&](Entry& e) {
                 std::lock_guard lock{writing_mutex};
                 for (const auto& backend : backends) {
@@ -86,44 +212,190 @@ private:
                 }
             };
             while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
+                bool quit;
+                {
+                    std::unique_lock lock{sleep_mutex};
+                    is_backend_sleeping = true;
+                    sleep_cv.wait(lock, [this] { return is_quitting || HasPendingEntries(); });
+                    is_backend_sleeping = false;
+                    quit = is_quitting;
+                }
+                if (quit) {
                     break;
                 }
-                write_logs(entry);
+                WritePendingEntries(payload, write_logs, std::numeric_limits<int>::max());
             }
 
             // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a case
             // where a system is repeatedly spamming logs even on close.
             const int MAX_LOGS_TO_WRITE = filter.IsDebug() ? INT_MAX : 100;
-            int logs_written = 0;
-            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
-            }
+            WritePendingEntries(payload, write_logs, MAX_LOGS_TO_WRITE);
+            is_backend_stopped = true;
         });
     }
 
     ~Impl() {
-        Entry entry;
-        entry.final_entry = true;
-        message_queue.Push(entry);
+        {
+            std::lock_guard lock{sleep_mutex};
+            is_quitting = true;
+        }
+        sleep_cv.notify_one();
         backend_thread.join();
     }
 
-    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string message) const {
+    /// Fills the common fields of a record, returns false if the message is filtered out
+    bool BeginRecord(RecordHeader& header, Class log_class, Level log_level, const char* filename,
+                     unsigned int line_num, const char* function, const char* format) {
         using std::chrono::duration_cast;
         using std::chrono::steady_clock;
 
-        Entry entry;
-        entry.timestamp =
+        if (!filter.CheckMessage(log_class, log_level)) {
+            return false;
+        }
+
+        header.timestamp =
             duration_cast<std::chrono::microseconds>(steady_clock::now() - time_origin);
-        entry.log_class = log_class;
-        entry.log_level = log_level;
-        entry.filename = Common::TrimSourcePath(filename);
-        entry.line_num = line_nr;
-        entry.function = function;
+        header.suppressed = 0;
+        if (log_level == Level::Info || log_level == Level::Warning) {
+            auto& limiter = GetThreadRecords().rate_limiter;
+            if (!limiter.Check(filename, line_num, header.timestamp, header.suppressed)) {
+                return false;
+            }
+        }
+
+        header.filename = filename;
+        header.function = function;
+        header.format = format;
+        header.line_num = line_num;
+        header.log_class = log_class;
+        header.log_level = log_level;
+        return true;
+    }
+
+    /// Stores a record in the buffer of the calling thread. When the buffer is full, the thread
+    /// waits for the logging thread to make room, so its messages are written in order.
+    void PushRecord(RecordHeader& header, const u8* payload, std::size_t payload_size) {
+        ThreadRecords& records = GetThreadRecords();
+        auto& ring = records.ring;
+        const std::size_t record_size = sizeof(header) + payload_size;
+        if (record_size > ring.Capacity()) {
+            // Huge messages can't ever fit, queue them formatted instead
+            const char* const text = reinterpret_cast<const char*>(payload);
+            std::string message = header.formatter ? header.formatter(header.format, payload)
+                                                   : std::string(text, payload_size);
+            message_queue.Push(CreateEntry(header, std::move(message)));
+            WakeBackend();
+            return;
+        }
+
+        header.payload_size = static_cast<u32>(payload_size);
+        records.staging.resize(record_size);
+        std::memcpy(records.staging.data(), &header, sizeof(header));
+        std::memcpy(records.staging.data() + sizeof(header), payload, payload_size);
+
+        while (ring.Capacity() - ring.Size() < record_size) {
+            if (is_backend_stopped) {
+                // Nothing will empty the ring anymore
+                return;
+            }
+            WakeBackend();
+            std::this_thread::yield();
+        }
+        ring.Push(records.staging.data(), record_size);
+        WakeBackend();
+    }
+
+    ThreadRecords& GetThreadRecords() {
+        thread_local ThreadRecordsHandle handle{RegisterThread()};
+        return handle.Get();
+    }
+
+    std::shared_ptr<ThreadRecords> RegisterThread() {
+        auto records = std::make_shared<ThreadRecords>();
+        std::lock_guard lock{records_mutex};
+        thread_records.push_back(records);
+        return records;
+    }
+
+    void WakeBackend() {
+        if (!is_backend_sleeping) {
+            return;
+        }
+        // Taking the lock ensures the backend thread is either waiting or will see the new entry
+        std::lock_guard lock{sleep_mutex};
+        sleep_cv.notify_one();
+    }
+
+    bool HasPendingEntries() {
+        if (!message_queue.Empty()) {
+            return true;
+        }
+        std::lock_guard lock{records_mutex};
+        return std::any_of(thread_records.begin(), thread_records.end(),
+                           [](const auto& records) { return records->ring.Size() != 0; });
+    }
+
+    /// Formats and writes up to max_entries entries from the queue and the thread buffers
+    template <typename Func>
+    void WritePendingEntries(std::string& payload, Func&& write_logs, int max_entries) {
+        int entries_written = 0;
+        Entry entry;
+
+        std::unique_lock lock{records_mutex};
+        for (const auto& records : thread_records) {
+            auto& ring = records->ring;
+            while (entries_written < max_entries && ring.Size() != 0) {
+                // Records are pushed whole, a non-empty ring always holds a complete record
+                RecordHeader header;
+                ring.Pop(&header, sizeof(header));
+                payload.resize(header.payload_size);
+                ring.Pop(payload.data(), payload.size());
+
+                entry = CreateEntry(header, FormatPayload(header, payload));
+                write_logs(entry);
+                ++entries_written;
+            }
+        }
+
+        // Threads that exited won't push more records
+        const auto it = std::remove_if(
+            thread_records.begin(), thread_records.end(), [](const auto& records) {
+                return records->is_abandoned && records->ring.Size() == 0;
+            });
+        thread_records.erase(it, thread_records.end());
+        lock.unlock();
+
+        while (entries_written < max_entries && message_queue.Pop(entry)) {
+            write_logs(entry);
+            ++entries_written;
+        }
+    }
+
+    static std::string FormatPayload(const RecordHeader& header, std::string& payload) {
+        if (!header.formatter) {
+            return std::move(payload);
+        }
+        try {
+            return header.formatter(header.format, reinterpret_cast<const u8*>(payload.data()));
+        } catch (const fmt::format_error& error) {
+            // There's no caller left to propagate it to
+            return fmt::format("Invalid log format string \"{}\": {}", header.format,
+                               error.what());
+        }
+    }
+
+    Entry CreateEntry(const RecordHeader& header, std::string message) const {
+        Entry entry;
+        entry.timestamp = header.timestamp;
+        entry.log_class = header.log_class;
+        entry.log_level = header.log_level;
+        entry.filename = Common::TrimSourcePath(header.filename);
+        entry.line_num = header.line_num;
+        entry.function = header.function;
         entry.message = std::move(message);
+        if (header.suppressed != 0) {
+            entry.message += fmt::format(" ({} similar messages suppressed)", header.suppressed);
+        }
 
         return entry;
     }
@@ -134,6 +406,16 @@ private:
     Common::MPSCQueue<Log::Entry> message_queue;
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
+
+    std::mutex records_mutex;
+    std::vector<std::shared_ptr<ThreadRecords>> thread_records;
+    std::atomic_bool is_deferred_formatting{true};
+
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    std::atomic_bool is_backend_sleeping{false};
+    std::atomic_bool is_backend_stopped{false};
+    bool is_quitting = false;
 };
 
 void ConsoleBackend::Write(const Entry& entry) {
@@ -308,15 +590,24 @@ Backend* GetBackend(std::string_view backend_name) {
     return Impl::Instance().GetBackend(backend_name);
 }
 
+void SetDeferredFormatting(bool enabled) {
+    Impl::Instance().SetDeferredFormatting(enabled);
+}
+
+bool CheckMessage(Class log_class, Level log_level) {
+    return Impl::Instance().GetGlobalFilter().CheckMessage(log_class, log_level);
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
-    auto& instance = Impl::Instance();
-    const auto& filter = instance.GetGlobalFilter();
-    if (!filter.CheckMessage(log_class, log_level))
-        return;
+    Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function, format, args);
+}
 
-    instance.PushEntry(log_class, log_level, filename, line_num, function,
-                       fmt::vformat(format, args));
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            DeferredFormatter formatter, const u8* args, std::size_t args_size) {
+    Impl::Instance().PushDeferredEntry(log_class, log_level, filename, line_num, function, format,
+                                       formatter, args, args_size);
 }
 } // namespace Log
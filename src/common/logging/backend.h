@@ -141,4 +141,11 @@ const char* GetLevelName(Level log_level);
  * never get the message
  */
 void SetGlobalFilter(const Filter& filter);
+
+/**
+ * Selects where messages with only arithmetic and enum arguments are formatted. When enabled (the
+ * default), their arguments are copied and the logging thread formats them. When disabled, every
+ * message is formatted on the thread that logs it.
+ */
+void SetDeferredFormatting(bool enabled);
 } // namespace Log
\ No newline at end of file
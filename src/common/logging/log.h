@@ -4,9 +4,31 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <fmt/format.h>
 #include "common/common_types.h"
 
+// Lowest level compiled in, messages below it are removed from the build. Defaults to Trace in
+// debug builds and to Debug otherwise.
+#ifndef YUZU_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define YUZU_LOG_MIN_LEVEL Trace
+#else
+#define YUZU_LOG_MIN_LEVEL Debug
+#endif
+#endif
+
+// Comma terminated list of {Class::<class>, Level::<level>} pairs overriding YUZU_LOG_MIN_LEVEL
+// for specific classes (and not their subclasses).
+#ifndef YUZU_LOG_CLASS_MIN_LEVELS
+#define YUZU_LOG_CLASS_MIN_LEVELS
+#endif
+
 namespace Log {
 
 /// Specifies the severity or level of detail of the log message.
@@ -124,40 +146,103 @@ enum class Class : ClassType {
     Count              ///< Total number of logging classes
 };
 
+struct ClassMinLevel {
+    Class log_class;
+    Level level;
+};
+
+/// Compile-time minimum levels of the classes not using YUZU_LOG_MIN_LEVEL, ends with Class::Count
+constexpr ClassMinLevel CLASS_MIN_LEVELS[]{YUZU_LOG_CLASS_MIN_LEVELS{Class::Count, Level::Count}};
+
+/// Returns true if messages of the given class and level are compiled in
+constexpr bool IsCompiledIn(Class log_class, Level log_level) {
+    for (const ClassMinLevel& class_min_level : CLASS_MIN_LEVELS) {
+        if (class_min_level.log_class == log_class) {
+            return log_level >= class_min_level.level;
+        }
+    }
+    return log_level >= Level::YUZU_LOG_MIN_LEVEL;
+}
+
+/// Returns true if the global filter lets messages of the given class and level through
+bool CheckMessage(Class log_class, Level log_level);
+
 /// Logs a message to the global logger, using fmt
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
+/// Formats the arguments of a deferred message, serialized back to back in args
+using DeferredFormatter = std::string (*)(const char* format, const u8* args);
+
+/**
+ * Logs a message to the global logger without formatting it. The format string and the serialized
+ * arguments are copied to a buffer owned by the calling thread, the logging thread formats them.
+ * @param format Format string, it has to outlive the program (a string literal).
+ * @param formatter Function that formats the arguments, it has to match how they were serialized.
+ * @param args Serialized arguments.
+ * @param args_size Size in bytes of the serialized arguments.
+ */
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            DeferredFormatter formatter, const u8* args, std::size_t args_size);
+
+/// Arguments that can be copied as raw bytes and formatted later on another thread. Pointers are
+/// excluded, a const char* may point to a temporary string.
+template <typename T>
+constexpr bool IsDeferrableArg = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <typename... Args>
+std::string FormatDeferredArgs(const char* format, const u8* args) {
+    std::tuple<Args...> values;
+    std::apply(
+        [&args]([[maybe_unused]] auto&... value) {
+            ((std::memcpy(&value, args, sizeof(value)), args += sizeof(value)), ...);
+        },
+        values);
+    return std::apply(
+        [format](const auto&... value) {
+            return fmt::vformat(format, fmt::make_format_args(value...));
+        },
+        values);
+}
+
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
-    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+    if constexpr ((IsDeferrableArg<Args> && ...)) {
+        // Messages with trivial arguments, like stubbed function warnings, are formatted by the
+        // logging thread
+        std::array<u8, (sizeof(Args) + ... + 0)> serialized;
+        [[maybe_unused]] u8* data = serialized.data();
+        ((std::memcpy(data, &args, sizeof(Args)), data += sizeof(Args)), ...);
+        DeferredLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                               &FormatDeferredArgs<Args...>, serialized.data(), serialized.size());
+    } else {
+        FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                          fmt::make_format_args(args...));
+    }
 }
 
 } // namespace Log
 
-#ifdef _DEBUG
-#define LOG_TRACE(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Trace, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
-#else
-#define LOG_TRACE(log_class, fmt, ...) (void(0))
-#endif
+/**
+ * Logs a message if its class and level are compiled in and pass the global filter. The arguments
+ * are only evaluated when the message is logged.
+ */
+#define LOG_GENERIC(log_class, log_level, ...)                                                     \
+    do {                                                                                           \
+        if constexpr (::Log::IsCompiledIn(::Log::Class::log_class, ::Log::Level::log_level)) {     \
+            if (::Log::CheckMessage(::Log::Class::log_class, ::Log::Level::log_level)) {           \
+                ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::log_level, __FILE__,   \
+                                     __LINE__, __func__, __VA_ARGS__);                             \
+            }                                                                                      \
+        }                                                                                          \
+    } while (0)
 
-#define LOG_DEBUG(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Debug, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
-#define LOG_INFO(log_class, ...)                                                                   \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Info, __FILE__, __LINE__,          \
-                         __func__, __VA_ARGS__)
-#define LOG_WARNING(log_class, ...)                                                                \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Warning, __FILE__, __LINE__,       \
-                         __func__, __VA_ARGS__)
-#define LOG_ERROR(log_class, ...)                                                                  \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Error, __FILE__, __LINE__,         \
-                         __func__, __VA_ARGS__)
-#define LOG_CRITICAL(log_class, ...)                                                               \
-    ::Log::FmtLogMessage(::Log::Class::log_class, ::Log::Level::Critical, __FILE__, __LINE__,      \
-                         __func__, __VA_ARGS__)
+#define LOG_TRACE(log_class, ...) LOG_GENERIC(log_class, Trace, __VA_ARGS__)
+#define LOG_DEBUG(log_class, ...) LOG_GENERIC(log_class, Debug, __VA_ARGS__)
+#define LOG_INFO(log_class, ...) LOG_GENERIC(log_class, Info, __VA_ARGS__)
+#define LOG_WARNING(log_class, ...) LOG_GENERIC(log_class, Warning, __VA_ARGS__)
+#define LOG_ERROR(log_class, ...) LOG_GENERIC(log_class, Error, __VA_ARGS__)
+#define LOG_CRITICAL(log_class, ...) LOG_GENERIC(log_class, Critical, __VA_ARGS__)
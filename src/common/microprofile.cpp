@@ -5,3 +5,373 @@
 // Includes the MicroProfile implementation in this file for compilation
 #define MICROPROFILE_IMPL 1
 #include "common/microprofile.h"
+
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+#include "common/detached_tasks.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+
+namespace Common::ProfileCapture {
+
+#if MICROPROFILE_ENABLED
+
+namespace {
+
+constexpr std::size_t NO_TRACK = std::numeric_limits<std::size_t>::max();
+
+/// Events recorded by a single thread
+struct Track {
+    std::string name;
+    std::vector<MicroProfileLogEntry> entries;
+};
+
+/// Position of the capture in the log of a MicroProfile thread slot
+struct ThreadState {
+    ThreadIdType thread_id{};
+    u32 get{};
+    std::size_t track = NO_TRACK;
+};
+
+struct Capture {
+    std::string path;
+    u32 num_frames{};
+    u32 skip_frames{};
+    bool is_recording{};
+
+    MicroProfileLogEntry base_tick{};
+    std::vector<MicroProfileLogEntry> frame_ticks; ///< Start tick of every captured frame
+    std::array<ThreadState, MICROPROFILE_MAX_THREADS> threads{};
+    std::vector<Track> tracks;
+
+    std::vector<std::string> timer_names; ///< Timer names by timer index
+    std::vector<std::string> group_names; ///< Group names by timer index
+};
+
+/// Accumulated ticks and counts by timer index
+struct Totals {
+    std::vector<u64> ticks;
+    std::vector<u64> counts;
+};
+
+std::mutex profile_mutex;
+std::unique_ptr<Capture> current_capture;
+std::unique_ptr<Totals> current_totals;
+
+/// Number of users that need every group enabled, and the settings to restore after the last one
+u32 all_groups_users = 0;
+bool previous_force_enable = false;
+bool previous_all_groups = false;
+
+/// Enables every group, the change takes effect at the end of the next MicroProfile flip
+void AcquireAllGroups() {
+    if (all_groups_users++ == 0) {
+        previous_force_enable = MicroProfileGetForceEnable();
+        previous_all_groups = MicroProfileGetEnableAllGroups();
+        MicroProfileSetForceEnable(true);
+        MicroProfileSetEnableAllGroups(true);
+    }
+}
+
+void ReleaseAllGroups() {
+    if (--all_groups_users == 0) {
+        MicroProfileSetForceEnable(previous_force_enable);
+        MicroProfileSetEnableAllGroups(previous_all_groups);
+    }
+}
+
+MicroProfileLogEntry CurrentTick() {
+    return static_cast<MicroProfileLogEntry>(MP_TICK()) & MP_LOG_TICK_MASK;
+}
+
+/// Copies the entries logged by every thread since the last call to the capture tracks. When
+/// discard is true, the pending entries are skipped instead.
+void CollectEvents(Capture& capture, bool discard) {
+    std::lock_guard lock{MicroProfileMutex()};
+    const MicroProfile& state = *MicroProfileGet();
+    for (u32 i = 0; i < state.nNumLogs; ++i) {
+        MicroProfileThreadLog* const log = state.Pool[i];
+        ThreadState& thread = capture.threads[i];
+        if (log == nullptr || log->nActive == 0 || log->nGpu != 0) {
+            thread.track = NO_TRACK;
+            continue;
+        }
+        if (thread.track == NO_TRACK || thread.thread_id != log->nThreadId) {
+            // The slot has been taken by a new thread, its log starts from the beginning
+            thread.thread_id = log->nThreadId;
+            thread.get = 0;
+            thread.track = capture.tracks.size();
+            capture.tracks.push_back({log->ThreadName, {}});
+        }
+
+        const u32 put = log->nPut.load(std::memory_order_acquire);
+        if (!discard) {
+            u32 range[2][2]{};
+            MicroProfileGetRange(put, thread.get, range);
+            auto& entries = capture.tracks[thread.track].entries;
+            for (const auto& [begin, end] : range) {
+                entries.insert(entries.end(), log->Log + begin, log->Log + end);
+            }
+        }
+        thread.get = put;
+    }
+}
+
+/// Adds the times of the frame processed by the last MicroProfile flip to the totals
+void AccumulateTotals(Totals& totals) {
+    std::lock_guard lock{MicroProfileMutex()};
+    const MicroProfile& state = *MicroProfileGet();
+    totals.ticks.resize(state.nTotalTimers);
+    totals.counts.resize(state.nTotalTimers);
+    for (u32 i = 0; i < state.nTotalTimers; ++i) {
+        totals.ticks[i] += state.Frame[i].nTicks;
+        totals.counts[i] += state.Frame[i].nCount;
+    }
+}
+
+/// Copies the timer and group names, the capture is written outside of the MicroProfile lock
+void CollectNames(Capture& capture) {
+    std::lock_guard lock{MicroProfileMutex()};
+    const MicroProfile& state = *MicroProfileGet();
+    capture.timer_names.resize(state.nTotalTimers);
+    capture.group_names.resize(state.nTotalTimers);
+    for (u32 i = 0; i < state.nTotalTimers; ++i) {
+        capture.timer_names[i] = state.TimerInfo[i].pName;
+        capture.group_names[i] = state.GroupInfo[state.TimerToGroup[i]].pName;
+    }
+}
+
+std::string EscapeJson(std::string_view text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void WriteCapture(const Capture& capture) {
+    const double ticks_to_us = 1000000.0 / static_cast<double>(MicroProfileTicksPerSecondCpu());
+    const auto timestamp = [&](MicroProfileLogEntry entry) {
+        return static_cast<double>(MicroProfileLogTickDifference(capture.base_tick, entry)) *
+               ticks_to_us;
+    };
+
+    // Thread 0 holds the frame markers, the recorded threads start at 1
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    json += R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"yuzu"}})";
+    json += ",\n";
+    json += R"({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"Frames"}})";
+    for (std::size_t frame = 0; frame < capture.frame_ticks.size(); ++frame) {
+        json += fmt::format(",\n{{\"name\":\"Frame {}\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,"
+                            "\"tid\":0,\"ts\":{:.3f}}}",
+                            frame, timestamp(capture.frame_ticks[frame]));
+    }
+
+    const MicroProfileLogEntry end_tick = capture.frame_ticks.back();
+    std::size_t num_events = 0;
+    for (std::size_t track_index = 0; track_index < capture.tracks.size(); ++track_index) {
+        const Track& track = capture.tracks[track_index];
+        if (track.entries.empty()) {
+            continue;
+        }
+        const std::size_t tid = track_index + 1;
+        json += fmt::format(
+            ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":"
+            "\"{}\"}}}}",
+            tid, EscapeJson(track.name));
+
+        std::size_t depth = 0;
+        for (const MicroProfileLogEntry entry : track.entries) {
+            switch (MicroProfileLogType(entry)) {
+            case MP_LOG_ENTER: {
+                const auto timer = static_cast<std::size_t>(MicroProfileLogTimerIndex(entry));
+                if (timer >= capture.timer_names.size()) {
+                    continue;
+                }
+                json += fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"B\",\"pid\":1,"
+                                    "\"tid\":{},\"ts\":{:.3f}}}",
+                                    EscapeJson(capture.timer_names[timer]),
+                                    EscapeJson(capture.group_names[timer]), tid,
+                                    timestamp(entry));
+                ++depth;
+                ++num_events;
+                break;
+            }
+            case MP_LOG_LEAVE:
+                if (depth == 0) {
+                    // The scope was entered before the capture began
+                    continue;
+                }
+                json += fmt::format(",\n{{\"ph\":\"E\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}", tid,
+                                    timestamp(entry));
+                --depth;
+                break;
+            default:
+                break;
+            }
+        }
+        // Close the scopes that were still open when the capture ended
+        for (; depth > 0; --depth) {
+            json += fmt::format(",\n{{\"ph\":\"E\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}}}", tid,
+                                timestamp(end_tick));
+        }
+    }
+    json += "\n]}\n";
+
+    FileUtil::IOFile file(capture.path, "wb");
+    if (!file.IsOpen() || file.WriteBytes(json.data(), json.size()) != json.size()) {
+        LOG_ERROR(Common, "Failed to write profile capture to {}", capture.path);
+        return;
+    }
+    LOG_INFO(Common, "Wrote profile capture of {} frames and {} scopes to {}",
+             capture.frame_ticks.size() - 1, num_events, capture.path);
+}
+
+} // Anonymous namespace
+
+bool Start(std::string path, u32 num_frames, u32 skip_frames) {
+    std::lock_guard lock{profile_mutex};
+    if (current_capture) {
+        LOG_WARNING(Common, "A profile capture is already in progress");
+        return false;
+    }
+    current_capture = std::make_unique<Capture>();
+    current_capture->path = std::move(path);
+    current_capture->num_frames = std::max(num_frames, 1U);
+    current_capture->skip_frames = skip_frames;
+    LOG_INFO(Common, "Capturing {} frames to {}", current_capture->num_frames,
+             current_capture->path);
+    return true;
+}
+
+bool IsActive() {
+    std::lock_guard lock{profile_mutex};
+    return current_capture != nullptr;
+}
+
+std::string GetDefaultPath() {
+    const std::time_t now = std::time(nullptr);
+    std::array<char, 32> date{};
+    std::strftime(date.data(), date.size(), "%Y%m%d-%H%M%S", std::localtime(&now));
+    return fmt::format("{}trace-{}.json", FileUtil::GetUserPath(FileUtil::UserPath::LogDir),
+                       date.data());
+}
+
+void BeginTotals() {
+    std::lock_guard lock{profile_mutex};
+    if (current_totals) {
+        return;
+    }
+    current_totals = std::make_unique<Totals>();
+    AcquireAllGroups();
+}
+
+std::vector<TimerTotal> EndTotals() {
+    std::lock_guard lock{profile_mutex};
+    if (!current_totals) {
+        return {};
+    }
+    ReleaseAllGroups();
+    const std::unique_ptr<Totals> totals = std::move(current_totals);
+
+    std::lock_guard profile_lock{MicroProfileMutex()};
+    const MicroProfile& state = *MicroProfileGet();
+    const double ticks_to_ms = MicroProfileTickToMsMultiplier(MicroProfileTicksPerSecondCpu());
+    std::vector<TimerTotal> result;
+    for (std::size_t i = 0; i < totals->counts.size(); ++i) {
+        if (totals->counts[i] == 0) {
+            continue;
+        }
+        result.push_back({state.GroupInfo[state.TimerToGroup[i]].pName, state.TimerInfo[i].pName,
+                          totals->counts[i], static_cast<double>(totals->ticks[i]) * ticks_to_ms});
+    }
+    return result;
+}
+
+void Flip() {
+    std::lock_guard lock{profile_mutex};
+    const bool begins_recording = current_capture && !current_capture->is_recording &&
+                                  current_capture->skip_frames == 0;
+    if (begins_recording) {
+        // The active groups are updated at the end of the flip, the scopes are logged from the
+        // next frame on
+        AcquireAllGroups();
+    } else if (current_capture && current_capture->skip_frames > 0) {
+        --current_capture->skip_frames;
+    }
+
+    MicroProfileFlip();
+
+    if (current_totals) {
+        AccumulateTotals(*current_totals);
+    }
+    if (!current_capture || current_capture->skip_frames > 0) {
+        return;
+    }
+    if (begins_recording) {
+        CollectEvents(*current_capture, true);
+        current_capture->base_tick = CurrentTick();
+        current_capture->frame_ticks.push_back(current_capture->base_tick);
+        current_capture->is_recording = true;
+        return;
+    }
+    if (!current_capture->is_recording) {
+        // The capture has just run out of frames to skip, it begins on the next flip
+        return;
+    }
+
+    CollectEvents(*current_capture, false);
+    current_capture->frame_ticks.push_back(CurrentTick());
+    if (current_capture->frame_ticks.size() <= current_capture->num_frames) {
+        return;
+    }
+
+    ReleaseAllGroups();
+    CollectNames(*current_capture);
+
+    // Formatting a long capture takes a while, don't stall the emulated frame
+    std::shared_ptr<Capture> finished = std::move(current_capture);
+    DetachedTasks::AddTask([finished] { WriteCapture(*finished); });
+}
+
+#else
+
+bool Start(std::string path, u32 num_frames, u32 skip_frames) {
+    LOG_ERROR(Common, "Profile captures require MicroProfile to be enabled");
+    return false;
+}
+
+bool IsActive() {
+    return false;
+}
+
+std::string GetDefaultPath() {
+    return {};
+}
+
+void BeginTotals() {}
+
+std::vector<TimerTotal> EndTotals() {
+    return {};
+}
+
+void Flip() {}
+
+#endif
+
+} // namespace Common::ProfileCapture
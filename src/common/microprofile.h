@@ -20,7 +20,10 @@
 typedef void* HANDLE;
 #endif
 
+#include <string>
+#include <vector>
 #include <microprofile.h>
+#include "common/common_types.h"
 
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
 
@@ -32,3 +35,43 @@ typedef void* HANDLE;
 #ifdef PAGE_MASK
 #undef PAGE_MASK
 #endif
+
+namespace Common::ProfileCapture {
+
+/// Number of frames captured when no length is specified
+constexpr u32 DEFAULT_FRAME_COUNT = 120;
+
+/**
+ * Requests a headless capture of the MicroProfile scopes. Once skip_frames frames have been
+ * flipped, every group is enabled and the scopes entered and left by all the threads during the
+ * next num_frames frames are recorded. The capture is then written to path as Chrome trace-event
+ * JSON, which can be opened in chrome://tracing or the Perfetto UI.
+ * @returns false if another capture is already pending or in progress
+ */
+bool Start(std::string path, u32 num_frames, u32 skip_frames = 0);
+
+/// Returns true while a capture is pending or in progress
+bool IsActive();
+
+/// Returns a new file path in the log directory to write a capture to
+std::string GetDefaultPath();
+
+/// Time spent in a MicroProfile scope
+struct TimerTotal {
+    std::string group;
+    std::string name;
+    u64 count;       ///< Number of times the scope was left
+    double total_ms; ///< Total time spent in the scope
+};
+
+/// Enables every group and starts accumulating the time spent in each scope on every frame flip
+void BeginTotals();
+
+/// Stops accumulating and returns the totals of the scopes that were entered since BeginTotals
+std::vector<TimerTotal> EndTotals();
+
+/// Flips the MicroProfile frame and collects the events of the frame that has just ended. It has
+/// to be called instead of MicroProfileFlip.
+void Flip();
+
+} // namespace Common::ProfileCapture
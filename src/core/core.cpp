@@ -24,6 +24,7 @@
 #include "core/frontend/applets/software_keyboard.h"
 #include "core/frontend/applets/web_browser.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hardware_interrupt_manager.h"
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
@@ -35,6 +36,7 @@
 #include "core/loader/loader.h"
 #include "core/perf_stats.h"
 #include "core/settings.h"
+#include "core/snapshot.h"
 #include "core/telemetry_session.h"
 #include "file_sys/cheat_engine.h"
 #include "frontend/applets/profile_select.h"
@@ -102,6 +104,7 @@ struct System::Impl {
         core_timing.Initialize();
         cpu_core_manager.Initialize();
         kernel.Initialize();
+        interrupt_manager = std::make_unique<Core::Hardware::InterruptManager>(system);
 
         const auto current_time = std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch());
@@ -209,8 +212,10 @@ struct System::Impl {
         Service::Shutdown();
         service_manager.reset();
         cheat_engine.reset();
+        snapshot.reset();
         telemetry_session.reset();
         gpu_core.reset();
+        interrupt_manager.reset();
 
         // Close all CPU/threading state
         cpu_core_manager.Shutdown();
@@ -246,6 +251,7 @@ struct System::Impl {
     }
 
     Timing::CoreTiming core_timing;
+    std::unique_ptr<Core::Hardware::InterruptManager> interrupt_manager;
     Kernel::KernelCore kernel;
     /// RealVfsFilesystem instance
     FileSys::VirtualFilesystem virtual_filesystem;
@@ -261,6 +267,9 @@ struct System::Impl {
 
     std::unique_ptr<FileSys::CheatEngine> cheat_engine;
 
+    /// Last captured snapshot, also the parent of the next one
+    std::unique_ptr<Snapshot> snapshot;
+
     /// Frontend applets
     Service::AM::Applets::AppletManager applet_manager;
 
@@ -300,6 +309,23 @@ void System::InvalidateCpuInstructionCaches() {
     impl->cpu_core_manager.InvalidateAllInstructionCaches();
 }
 
+bool System::CaptureSnapshot() {
+    auto snapshot = Snapshot::Capture(*this, impl->snapshot.get());
+    if (snapshot == nullptr) {
+        return false;
+    }
+    impl->snapshot = std::move(snapshot);
+    return true;
+}
+
+bool System::RestoreSnapshot() {
+    if (impl->snapshot == nullptr) {
+        LOG_ERROR(Core, "No snapshot has been captured");
+        return false;
+    }
+    return impl->snapshot->Restore(*this);
+}
+
 System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::string& filepath) {
     return impl->Load(*this, emu_window, filepath);
 }
@@ -416,6 +442,14 @@ const VideoCore::RendererBase& System::Renderer() const {
     return *impl->renderer;
 }
 
+Core::Hardware::InterruptManager& System::InterruptManager() {
+    return *impl->interrupt_manager;
+}
+
+const Core::Hardware::InterruptManager& System::InterruptManager() const {
+    return *impl->interrupt_manager;
+}
+
 Kernel::KernelCore& System::Kernel() {
     return impl->kernel;
 }
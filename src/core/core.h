@@ -62,6 +62,10 @@ namespace Core::Timing {
 class CoreTiming;
 }
 
+namespace Core::Hardware {
+class InterruptManager;
+}
+
 namespace Core {
 
 class ARM_Interface;
@@ -132,9 +136,30 @@ public:
      */
     void InvalidateCpuInstructionCaches();
 
+    /**
+     * Captures a snapshot of the emulated state, replacing the previous one, see Core::Snapshot.
+     * Must be called from the emulation thread while it's not in RunLoop.
+     * @returns True if the snapshot was captured.
+     */
+    bool CaptureSnapshot();
+
+    /**
+     * Restores the last captured snapshot, with the same requirements as CaptureSnapshot.
+     * @returns True if the snapshot was restored.
+     */
+    bool RestoreSnapshot();
+
     /// Shutdown the emulated system.
     void Shutdown();
 
+    /**
+     * Initializes the emulated system without loading an application. This is meant for tools
+     * that drive the emulated hardware directly, such as the GPU command stream replayer.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns ResultStatus code, indicating if the operation succeeded.
+     */
+    ResultStatus Init(Frontend::EmuWindow& emu_window);
+
     /**
      * Load an executable application.
      * @param emu_window Reference to the host-system window used for video output and keyboard
@@ -235,6 +260,12 @@ public:
     /// Provides a constant reference to the core timing instance.
     const Timing::CoreTiming& CoreTiming() const;
 
+    /// Provides a reference to the interrupt manager instance.
+    Core::Hardware::InterruptManager& InterruptManager();
+
+    /// Provides a constant reference to the interrupt manager instance.
+    const Core::Hardware::InterruptManager& InterruptManager() const;
+
     /// Provides a reference to the kernel instance.
     Kernel::KernelCore& Kernel();
 
@@ -304,14 +335,6 @@ private:
     /// Returns the currently running CPU core
     const Cpu& CurrentCpuCore() const;
 
-    /**
-     * Initialize the emulated system.
-     * @param emu_window Reference to the host-system window used for video output and keyboard
-     *                   input.
-     * @return ResultStatus code, indicating if the operation succeeded.
-     */
-    ResultStatus Init(Frontend::EmuWindow& emu_window);
-
     struct Impl;
     std::unique_ptr<Impl> impl;
 
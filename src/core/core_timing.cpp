@@ -10,6 +10,7 @@
 #include <tuple>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/thread.h"
 #include "core/core_timing_util.h"
 
@@ -213,4 +214,45 @@ int CoreTiming::GetDowncount() const {
     return downcount;
 }
 
+CoreTiming::State CoreTiming::SaveState() {
+    MoveEvents();
+
+    State state;
+    state.global_timer = global_timer;
+    state.idled_cycles = idled_cycles;
+    state.slice_length = slice_length;
+    state.downcount = downcount;
+    state.is_global_timer_sane = is_global_timer_sane;
+    state.event_fifo_id = event_fifo_id;
+    state.events.reserve(event_queue.size());
+    for (const Event& event : event_queue) {
+        state.events.push_back({event.time, event.fifo_order, event.userdata, *event.type->name});
+    }
+    return state;
+}
+
+void CoreTiming::LoadState(const State& state) {
+    // Events scheduled from other threads in the meantime belong to the discarded timeline.
+    ts_queue.Clear();
+    unschedule_queue.Clear();
+
+    global_timer = state.global_timer;
+    idled_cycles = state.idled_cycles;
+    slice_length = state.slice_length;
+    downcount = state.downcount;
+    is_global_timer_sane = state.is_global_timer_sane;
+    event_fifo_id = state.event_fifo_id;
+
+    event_queue.clear();
+    for (const auto& event : state.events) {
+        const auto itr = event_types.find(event.name);
+        if (itr == event_types.end()) {
+            LOG_WARNING(Core_Timing, "Dropping event {} with no registered type", event.name);
+            continue;
+        }
+        event_queue.push_back({event.time, event.fifo_order, event.userdata, &itr->second});
+    }
+    std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+}
+
 } // namespace Core::Timing
@@ -39,6 +39,25 @@ struct EventType {
  */
 class CoreTiming {
 public:
+    /// The timer state and the pending events, as stored in emulation snapshots.
+    struct State {
+        struct PendingEvent {
+            s64 time;
+            u64 fifo_order;
+            u64 userdata;
+            /// Events are stored by name, as event types are only valid for a single session.
+            std::string name;
+        };
+
+        s64 global_timer;
+        s64 idled_cycles;
+        int slice_length;
+        int downcount;
+        bool is_global_timer_sane;
+        u64 event_fifo_id;
+        std::vector<PendingEvent> events;
+    };
+
     CoreTiming();
     ~CoreTiming();
 
@@ -115,6 +134,14 @@ public:
 
     int GetDowncount() const;
 
+    /// Returns the timer state along with all of the pending events.
+    /// Like the other non-threadsafe functions, this must be called from the emu thread.
+    State SaveState();
+
+    /// Replaces the timer state and the pending events with the ones of a saved state. Events of
+    /// a type that is no longer registered are dropped.
+    void LoadState(const State& state);
+
 private:
     struct Event;
 
@@ -0,0 +1,104 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include "common/assert.h"
+#include "core/crypto/multi_buffer_sha256.h"
+
+namespace Core::Crypto {
+
+namespace {
+
+using LaneWords = std::array<u32, SHA256_LANES>;
+
+constexpr std::array<u32, 64> ROUND_CONSTANTS{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr std::array<u32, 8> INITIAL_STATE{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+constexpr u32 RotateRight(u32 value, u32 amount) {
+    return (value >> amount) | (value << (32 - amount));
+}
+
+} // Anonymous namespace
+
+void MultiBufferSHA256(const std::array<const u8*, SHA256_LANES>& messages, std::size_t size,
+                       std::array<SHA256Hash, SHA256_LANES>& hashes) {
+    ASSERT(size <= SHA256_MAX_SHORT_MESSAGE_SIZE);
+
+    // Message schedule, indexed by round then lane
+    std::array<LaneWords, 64> schedule;
+    for (std::size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        std::array<u8, 64> block{};
+        std::memcpy(block.data(), messages[lane], size);
+        block[size] = 0x80;
+        const u64 size_bits = static_cast<u64>(size) * 8;
+        for (std::size_t i = 0; i < 8; ++i) {
+            block[63 - i] = static_cast<u8>(size_bits >> (i * 8));
+        }
+        for (std::size_t i = 0; i < 16; ++i) {
+            schedule[i][lane] = (static_cast<u32>(block[i * 4]) << 24) |
+                                (static_cast<u32>(block[i * 4 + 1]) << 16) |
+                                (static_cast<u32>(block[i * 4 + 2]) << 8) | block[i * 4 + 3];
+        }
+    }
+    for (std::size_t i = 16; i < 64; ++i) {
+        for (std::size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            const u32 w15 = schedule[i - 15][lane];
+            const u32 w2 = schedule[i - 2][lane];
+            const u32 s0 = RotateRight(w15, 7) ^ RotateRight(w15, 18) ^ (w15 >> 3);
+            const u32 s1 = RotateRight(w2, 17) ^ RotateRight(w2, 19) ^ (w2 >> 10);
+            schedule[i][lane] = schedule[i - 16][lane] + s0 + schedule[i - 7][lane] + s1;
+        }
+    }
+
+    std::array<LaneWords, 8> state;
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        state[i].fill(INITIAL_STATE[i]);
+    }
+    auto& [a, b, c, d, e, f, g, h] = state;
+    for (std::size_t i = 0; i < 64; ++i) {
+        for (std::size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            const u32 s1 = RotateRight(e[lane], 6) ^ RotateRight(e[lane], 11) ^
+                           RotateRight(e[lane], 25);
+            const u32 choice = (e[lane] & f[lane]) ^ (~e[lane] & g[lane]);
+            const u32 temp1 = h[lane] + s1 + choice + ROUND_CONSTANTS[i] + schedule[i][lane];
+            const u32 s0 = RotateRight(a[lane], 2) ^ RotateRight(a[lane], 13) ^
+                           RotateRight(a[lane], 22);
+            const u32 majority = (a[lane] & b[lane]) ^ (a[lane] & c[lane]) ^ (b[lane] & c[lane]);
+            const u32 temp2 = s0 + majority;
+
+            h[lane] = g[lane];
+            g[lane] = f[lane];
+            f[lane] = e[lane];
+            e[lane] = d[lane] + temp1;
+            d[lane] = c[lane];
+            c[lane] = b[lane];
+            b[lane] = a[lane];
+            a[lane] = temp1 + temp2;
+        }
+    }
+
+    for (std::size_t lane = 0; lane < SHA256_LANES; ++lane) {
+        for (std::size_t i = 0; i < state.size(); ++i) {
+            const u32 word = state[i][lane] + INITIAL_STATE[i];
+            hashes[lane][i * 4] = static_cast<u8>(word >> 24);
+            hashes[lane][i * 4 + 1] = static_cast<u8>(word >> 16);
+            hashes[lane][i * 4 + 2] = static_cast<u8>(word >> 8);
+            hashes[lane][i * 4 + 3] = static_cast<u8>(word);
+        }
+    }
+}
+
+} // namespace Core::Crypto
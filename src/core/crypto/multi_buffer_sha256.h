@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+#include "core/crypto/key_manager.h"
+
+namespace Core::Crypto {
+
+/// Number of messages hashed at once by MultiBufferSHA256
+constexpr std::size_t SHA256_LANES = 8;
+
+/// Longest message that fits in a single SHA-256 block along with its padding
+constexpr std::size_t SHA256_MAX_SHORT_MESSAGE_SIZE = 55;
+
+/**
+ * Computes the SHA-256 hashes of SHA256_LANES messages of the same size at once. The messages
+ * must be at most SHA256_MAX_SHORT_MESSAGE_SIZE bytes long, so each of them is a single block.
+ *
+ * The lanes are processed in lockstep with their state laid out as a structure of arrays, which
+ * lets the compiler turn the rounds into vector instructions. This is much faster than hashing
+ * the messages one by one when scanning binaries for keys at every offset.
+ */
+void MultiBufferSHA256(const std::array<const u8*, SHA256_LANES>& messages, std::size_t size,
+                       std::array<SHA256Hash, SHA256_LANES>& hashes);
+
+} // namespace Core::Crypto
@@ -9,9 +9,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstring>
-#include <mbedtls/sha256.h>
+#include <limits>
+#include <mutex>
+#include <thread>
 #include "common/assert.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -20,6 +23,7 @@
 #include "common/string_util.h"
 #include "common/swap.h"
 #include "core/crypto/key_manager.h"
+#include "core/crypto/multi_buffer_sha256.h"
 #include "core/crypto/partition_data_manager.h"
 #include "core/crypto/xts_encryption_layer.h"
 #include "core/file_sys/vfs.h"
@@ -240,25 +244,92 @@ static u8 CalculateMaxKeyblobSourceHash() {
 
 const u8 PartitionDataManager::MAX_KEYBLOB_SOURCE_HASH = CalculateMaxKeyblobSourceHash();
 
+namespace {
+
+/// Scans smaller than this are not worth spreading over several threads
+constexpr std::size_t MIN_PARALLEL_SCAN_SIZE = 0x10000;
+
+/// Offsets decrypted at once by each thread when searching for the master keys
+constexpr std::size_t MASTER_KEY_SCAN_BATCH = 0x1000;
+
+/**
+ * Splits the offsets [0, count) in contiguous ranges and calls func(begin, end) for each of them
+ * on its own thread, one per hardware thread.
+ */
+template <typename Func>
+void ParallelScan(std::size_t count, Func&& func) {
+    std::size_t num_threads = std::max(1U, std::thread::hardware_concurrency());
+    if (count < MIN_PARALLEL_SCAN_SIZE) {
+        num_threads = 1;
+    }
+    const std::size_t range_size = (count + num_threads - 1) / num_threads;
+
+    std::vector<std::thread> threads;
+    for (std::size_t begin = range_size; begin < count; begin += range_size) {
+        threads.emplace_back(func, begin, std::min(begin + range_size, count));
+    }
+    func(std::size_t{0}, std::min(range_size, count));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * Hashes the key_size bytes long windows of data starting every stride bytes, from the window
+ * begin to the window end excluded, and calls func(window, hash) for each of them in order until
+ * it returns false.
+ */
+template <typename Func>
+void ForEachWindowHash(const u8* data, std::size_t begin, std::size_t end, std::size_t key_size,
+                       std::size_t stride, Func&& func) {
+    std::array<const u8*, SHA256_LANES> messages{};
+    std::array<SHA256Hash, SHA256_LANES> hashes{};
+    for (std::size_t offset = begin; offset < end; offset += SHA256_LANES) {
+        const std::size_t num_lanes = std::min(SHA256_LANES, end - offset);
+        for (std::size_t lane = 0; lane < SHA256_LANES; ++lane) {
+            // Unused lanes hash the last window again
+            messages[lane] = data + (offset + std::min(lane, num_lanes - 1)) * stride;
+        }
+        MultiBufferSHA256(messages, key_size, hashes);
+        for (std::size_t lane = 0; lane < num_lanes; ++lane) {
+            if (!func(offset + lane, hashes[lane]))
+                return;
+        }
+    }
+}
+
+} // Anonymous namespace
+
 template <size_t key_size = 0x10>
 std::array<u8, key_size> FindKeyFromHex(const std::vector<u8>& binary,
                                         const std::array<u8, 0x20>& hash) {
     if (binary.size() < key_size)
         return {};
 
-    std::array<u8, 0x20> temp{};
-    for (size_t i = 0; i < binary.size() - key_size; ++i) {
-        mbedtls_sha256(binary.data() + i, key_size, temp.data(), 0);
-
-        if (temp != hash)
-            continue;
-
-        std::array<u8, key_size> out{};
-        std::memcpy(out.data(), binary.data() + i, key_size);
-        return out;
-    }
+    // The lowest matching offset wins, as if the binary was scanned from the beginning
+    constexpr std::size_t NO_MATCH = std::numeric_limits<std::size_t>::max();
+    std::atomic<std::size_t> match{NO_MATCH};
+    ParallelScan(binary.size() - key_size, [&](std::size_t begin, std::size_t end) {
+        ForEachWindowHash(binary.data(), begin, end, key_size, 1,
+                          [&](std::size_t offset, const SHA256Hash& temp) {
+                              std::size_t current = match.load(std::memory_order_relaxed);
+                              if (offset > current)
+                                  return false;
+                              if (temp != hash)
+                                  return true;
+                              while (offset < current && !match.compare_exchange_weak(current,
+                                                                                       offset)) {
+                              }
+                              return false;
+                          });
+    });
+
+    if (match == NO_MATCH)
+        return {};
 
-    return {};
+    std::array<u8, key_size> out{};
+    std::memcpy(out.data(), binary.data() + match, key_size);
+    return out;
 }
 
 std::array<u8, 16> FindKeyFromHex16(const std::vector<u8>& binary, std::array<u8, 32> hash) {
@@ -270,21 +341,43 @@ static std::array<Key128, 0x20> FindEncryptedMasterKeyFromHex(const std::vector<
     if (binary.size() < 0x10)
         return {};
 
-    SHA256Hash temp{};
-    Key128 dec_temp{};
     std::array<Key128, 0x20> out{};
-    AESCipher<Key128> cipher(key, Mode::ECB);
-    for (size_t i = 0; i < binary.size() - 0x10; ++i) {
-        cipher.Transcode(binary.data() + i, dec_temp.size(), dec_temp.data(), Op::Decrypt);
-        mbedtls_sha256(dec_temp.data(), dec_temp.size(), temp.data(), 0);
-
-        for (size_t k = 0; k < out.size(); ++k) {
-            if (temp == master_key_hashes[k]) {
-                out[k] = dec_temp;
-                break;
+    std::mutex out_mutex;
+    ParallelScan(binary.size() - 0x10, [&](std::size_t begin, std::size_t end) {
+        // Ciphers keep state between calls, every thread needs its own
+        AESCipher<Key128> cipher(key, Mode::ECB);
+        std::vector<Key128> decrypted;
+        std::vector<u8> blocks;
+        for (std::size_t batch = begin; batch < end; batch += MASTER_KEY_SCAN_BATCH) {
+            const std::size_t count = std::min(MASTER_KEY_SCAN_BATCH, end - batch);
+            decrypted.resize(count);
+
+            // The windows starting 0x10 bytes apart are consecutive ECB blocks, so each of the
+            // 0x10 interleaved sequences of windows is decrypted in a single call
+            for (std::size_t residue = 0; residue < std::min<std::size_t>(0x10, count);
+                 ++residue) {
+                const std::size_t num_blocks = (count - residue + 0xF) / 0x10;
+                blocks.resize(num_blocks * 0x10);
+                cipher.Transcode(binary.data() + batch + residue, blocks.size(), blocks.data(),
+                                 Op::Decrypt);
+                for (std::size_t i = 0; i < num_blocks; ++i) {
+                    std::memcpy(decrypted[residue + i * 0x10].data(), blocks.data() + i * 0x10,
+                                0x10);
+                }
             }
+
+            ForEachWindowHash(decrypted[0].data(), 0, count, 0x10, 0x10,
+                              [&](std::size_t index, const SHA256Hash& temp) {
+                                  const auto iter = std::find(master_key_hashes.begin(),
+                                                              master_key_hashes.end(), temp);
+                                  if (iter != master_key_hashes.end()) {
+                                      std::lock_guard lock{out_mutex};
+                                      out[iter - master_key_hashes.begin()] = decrypted[index];
+                                  }
+                                  return true;
+                              });
         }
-    }
+    });
 
     return out;
 }
@@ -45,14 +45,48 @@ u32 Cheat::KeypadValue() const {
     return Common::swap32(out) & 0x0FFFFFFF;
 }
 
+namespace {
+bool IsValidWidth(u32 width) {
+    return width == 1 || width == 2 || width == 4 || width == 8;
+}
+
+bool Compare(ComparisonOp op, u64 a, u64 b) {
+    switch (op) {
+    case ComparisonOp::GreaterThan:
+        return a > b;
+    case ComparisonOp::GreaterThanEqual:
+        return a >= b;
+    case ComparisonOp::LessThan:
+        return a < b;
+    case ComparisonOp::LessThanEqual:
+        return a <= b;
+    case ComparisonOp::Equal:
+        return a == b;
+    case ComparisonOp::Inequal:
+        return a != b;
+    default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
+bool IsValidComparison(ComparisonOp op) {
+    return op >= ComparisonOp::GreaterThan && op <= ComparisonOp::Inequal;
+}
+} // Anonymous namespace
+
 void CheatList::SetMemoryParameters(VAddr main_begin, VAddr heap_begin, VAddr main_end,
-                                    VAddr heap_end, MemoryWriter writer, MemoryReader reader) {
+                                    VAddr heap_end, MemoryWriter writer,
+                                    MemoryBlockWriter block_writer, MemoryReader reader) {
     this->main_region_begin = main_begin;
     this->main_region_end = main_end;
     this->heap_region_begin = heap_begin;
     this->heap_region_end = heap_end;
     this->writer = writer;
+    this->block_writer = block_writer;
     this->reader = reader;
+
+    Compile();
 }
 
 MICROPROFILE_DEFINE(Cheat_Engine, "Add-Ons", "Cheat Engine", MP_RGB(70, 200, 70));
@@ -61,173 +95,283 @@ void CheatList::Execute() {
     MICROPROFILE_SCOPE(Cheat_Engine);
 
     std::fill(scratch.begin(), scratch.end(), 0);
-    in_standard = false;
-    for (std::size_t i = 0; i < master_list.size(); ++i) {
-        LOG_DEBUG(Common_Filesystem, "Executing block #{:08X} ({})", i, master_list[i].first);
-        current_block = i;
-        ExecuteBlock(master_list[i].second);
-    }
+    press_state.reset();
+
+    std::size_t pc = 0;
+    while (pc < program.size()) {
+        const Instruction& instruction = program[pc++];
+        auto& register_value = scratch[instruction.register_index];
 
-    in_standard = true;
-    for (std::size_t i = 0; i < standard_list.size(); ++i) {
-        LOG_DEBUG(Common_Filesystem, "Executing block #{:08X} ({})", i, standard_list[i].first);
-        current_block = i;
-        ExecuteBlock(standard_list[i].second);
+        switch (instruction.opcode) {
+        case Opcode::Write:
+            writer(instruction.width, SanitizeAddress(instruction.address + register_value),
+                   instruction.value);
+            break;
+        case Opcode::WriteBlock: {
+            const VAddr address = instruction.address + register_value;
+            if (!IsValidRange(address, instruction.target)) {
+                LOG_ERROR(Common_Filesystem,
+                          "Cheat attempting to write {} bytes at invalid address={:016X}",
+                          instruction.target, address);
+                break;
+            }
+            block_writer(address, write_data.data() + instruction.value, instruction.target);
+            break;
+        }
+        case Opcode::Conditional:
+        case Opcode::ConditionalInput:
+            if (!EvaluateConditional(instruction)) {
+                pc = instruction.target;
+            }
+            break;
+        case Opcode::LoopBegin: {
+            auto& counter = loop_counters[instruction.loop_index];
+            counter = static_cast<s32>(instruction.value);
+            if (counter < 0) {
+                pc = instruction.target;
+            } else {
+                register_value = static_cast<u64>(counter);
+            }
+            break;
+        }
+        case Opcode::LoopEnd: {
+            auto& counter = loop_counters[instruction.loop_index];
+            if (--counter >= 0) {
+                register_value = static_cast<u64>(counter);
+                pc = instruction.target;
+            }
+            break;
+        }
+        case Opcode::LoadImmediate:
+            register_value = instruction.value;
+            break;
+        case Opcode::LoadIndexed: {
+            const VAddr address =
+                instruction.address + (instruction.use_register ? register_value : 0);
+            register_value = reader(instruction.width, SanitizeAddress(address));
+            break;
+        }
+        case Opcode::StoreIndexed: {
+            const VAddr address =
+                register_value +
+                (instruction.use_register ? scratch[instruction.offset_register_index] : 0);
+            writer(instruction.width, SanitizeAddress(address), instruction.value);
+            break;
+        }
+        case Opcode::RegisterArithmetic:
+            RegisterArithmetic(instruction);
+            break;
+        }
     }
 }
 
 CheatList::CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard)
     : master_list{std::move(master)}, standard_list{std::move(standard)}, system{&system_} {}
 
-bool CheatList::EvaluateConditional(const Cheat& cheat) const {
-    using ComparisonFunction = bool (*)(u64, u64);
-    constexpr std::array<ComparisonFunction, 6> comparison_functions{
-        [](u64 a, u64 b) { return a > b; },  [](u64 a, u64 b) { return a >= b; },
-        [](u64 a, u64 b) { return a < b; },  [](u64 a, u64 b) { return a <= b; },
-        [](u64 a, u64 b) { return a == b; }, [](u64 a, u64 b) { return a != b; },
-    };
+void CheatList::Compile() {
+    program.clear();
+    write_data.clear();
+    loop_counters.clear();
 
-    if (cheat.type == CodeType::ConditionalInput) {
-        const auto applet_resource =
-            system->ServiceManager().GetService<Service::HID::Hid>("hid")->GetAppletResource();
-        if (applet_resource == nullptr) {
-            LOG_WARNING(
-                Common_Filesystem,
-                "Attempted to evaluate input conditional, but applet resource is not initialized!");
-            return false;
+    for (const auto* segment : {&master_list, &standard_list}) {
+        for (const auto& [name, block] : *segment) {
+            if (!CompileBlock(block)) {
+                LOG_ERROR(Common_Filesystem, "Cheat '{}' is malformed and will not be executed",
+                          name);
+            }
         }
-
-        const auto press_state =
-            applet_resource
-                ->GetController<Service::HID::Controller_NPad>(Service::HID::HidController::NPad)
-                .GetAndResetPressState();
-        return ((press_state & cheat.KeypadValue()) & KEYPAD_BITMASK) != 0;
     }
 
-    ASSERT(cheat.type == CodeType::Conditional);
+    LOG_DEBUG(Common_Filesystem, "Compiled {} cheats into {} instructions",
+              master_list.size() + standard_list.size(), program.size());
+}
 
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    ASSERT(static_cast<u8>(cheat.comparison_op.Value()) < 6);
-    auto* function = comparison_functions[static_cast<u8>(cheat.comparison_op.Value())];
-    const auto addr = cheat.Address() + offset;
+bool CheatList::CompileBlock(const Block& block) {
+    const std::size_t program_begin = program.size();
+    const std::size_t write_data_begin = write_data.size();
+    const std::size_t loop_counters_begin = loop_counters.size();
 
-    return function(reader(cheat.width, SanitizeAddress(addr)), cheat.ValueWidth(8));
-}
+    const auto fail = [&] {
+        program.resize(program_begin);
+        write_data.resize(write_data_begin);
+        loop_counters.resize(loop_counters_begin);
+        return false;
+    };
 
-void CheatList::ProcessBlockPairs(const Block& block) {
-    block_pairs.clear();
+    // Indices of the conditionals and loops that haven't been closed yet
+    std::vector<std::size_t> scopes;
+    bool previous_is_write = false;
 
-    u64 scope = 0;
-    std::map<u64, u64> pairs;
+    for (const auto& cheat : block) {
+        const bool is_write = cheat.type == CodeType::WriteImmediate;
+        Instruction instruction{};
+        instruction.width = static_cast<u8>(cheat.width.Value());
+        instruction.register_index = static_cast<u8>(cheat.register_3.Value());
 
-    for (std::size_t i = 0; i < block.size(); ++i) {
-        const auto& cheat = block[i];
+        const u64 region_offset =
+            cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
 
         switch (cheat.type) {
+        case CodeType::WriteImmediate: {
+            if (!IsValidWidth(instruction.width)) {
+                return fail();
+            }
+            instruction.opcode = Opcode::Write;
+            instruction.address = cheat.Address() + region_offset;
+            instruction.value = cheat.ValueWidth(8);
+
+            // Consecutive writes to contiguous addresses, like a patch spanning several
+            // instructions, are merged into a single block write.
+            if (!previous_is_write) {
+                break;
+            }
+            Instruction& previous = program.back();
+            const u64 previous_size =
+                previous.opcode == Opcode::WriteBlock ? previous.target : previous.width;
+            if (previous.register_index != instruction.register_index ||
+                previous.address + previous_size != instruction.address) {
+                break;
+            }
+            if (previous.opcode == Opcode::Write) {
+                const std::size_t offset = write_data.size();
+                write_data.resize(offset + previous.width);
+                std::memcpy(write_data.data() + offset, &previous.value, previous.width);
+                previous.opcode = Opcode::WriteBlock;
+                previous.target = previous.width;
+                previous.value = offset;
+            }
+            const std::size_t offset = write_data.size();
+            write_data.resize(offset + instruction.width);
+            std::memcpy(write_data.data() + offset, &instruction.value, instruction.width);
+            previous.target += instruction.width;
+            previous_is_write = true;
+            continue;
+        }
         case CodeType::Conditional:
+            if (!IsValidWidth(instruction.width) || !IsValidComparison(cheat.comparison_op)) {
+                return fail();
+            }
+            instruction.opcode = Opcode::Conditional;
+            instruction.operation = static_cast<u8>(cheat.comparison_op.Value());
+            instruction.address = cheat.Address() + region_offset;
+            instruction.value = cheat.ValueWidth(8);
+            scopes.push_back(program.size());
+            break;
         case CodeType::ConditionalInput:
-            pairs.insert_or_assign(scope, i);
-            ++scope;
+            instruction.opcode = Opcode::ConditionalInput;
+            instruction.value = cheat.KeypadValue();
+            scopes.push_back(program.size());
             break;
         case CodeType::EndConditional: {
-            --scope;
-            const auto idx = pairs.at(scope);
-            block_pairs.insert_or_assign(idx, i);
-            break;
+            if (scopes.empty() || program[scopes.back()].opcode == Opcode::LoopBegin) {
+                return fail();
+            }
+            program[scopes.back()].target = static_cast<u32>(program.size());
+            scopes.pop_back();
+            previous_is_write = false;
+            continue;
         }
-        case CodeType::Loop: {
+        case CodeType::Loop:
             if (cheat.end_of_loop) {
-                --scope;
-                const auto idx = pairs.at(scope);
-                block_pairs.insert_or_assign(idx, i);
+                if (scopes.empty() || program[scopes.back()].opcode != Opcode::LoopBegin) {
+                    return fail();
+                }
+                Instruction& begin = program[scopes.back()];
+                instruction.opcode = Opcode::LoopEnd;
+                instruction.register_index = begin.register_index;
+                instruction.loop_index = begin.loop_index;
+                instruction.target = static_cast<u32>(scopes.back() + 1);
+                begin.target = static_cast<u32>(program.size() + 1);
+                scopes.pop_back();
             } else {
-                pairs.insert_or_assign(scope, i);
-                ++scope;
+                instruction.opcode = Opcode::LoopBegin;
+                instruction.loop_index = static_cast<u16>(loop_counters.size());
+                instruction.value = cheat.Value(4, sizeof(s32));
+                loop_counters.push_back(0);
+                scopes.push_back(program.size());
             }
             break;
+        case CodeType::LoadImmediate:
+            instruction.opcode = Opcode::LoadImmediate;
+            instruction.value = cheat.Value(4, 8);
+            break;
+        case CodeType::LoadIndexed:
+            if (!IsValidWidth(instruction.width)) {
+                return fail();
+            }
+            instruction.opcode = Opcode::LoadIndexed;
+            instruction.use_register = cheat.load_from_register != 0;
+            instruction.address = cheat.Address() + (instruction.use_register ? 0 : region_offset);
+            break;
+        case CodeType::StoreIndexed:
+            if (!IsValidWidth(instruction.width)) {
+                return fail();
+            }
+            instruction.opcode = Opcode::StoreIndexed;
+            instruction.use_register = cheat.add_additional_register != 0;
+            instruction.offset_register_index = static_cast<u8>(cheat.register_6.Value());
+            instruction.value = cheat.ValueWidth(4);
+            break;
+        case CodeType::RegisterArithmetic:
+            if (!IsValidWidth(instruction.width) ||
+                cheat.arithmetic_op.Value() > ArithmeticOp::RShift) {
+                return fail();
+            }
+            instruction.opcode = Opcode::RegisterArithmetic;
+            instruction.operation = static_cast<u8>(cheat.arithmetic_op.Value());
+            instruction.value = cheat.ValueWidth(4);
+            break;
+        default:
+            LOG_ERROR(Common_Filesystem, "Unknown cheat code type={:01X}",
+                      static_cast<u32>(cheat.type.Value()));
+            return fail();
         }
-        }
-    }
-}
-
-void CheatList::WriteImmediate(const Cheat& cheat) {
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    const auto& register_3 = scratch.at(cheat.register_3);
 
-    const auto addr = cheat.Address() + offset + register_3;
-    LOG_DEBUG(Common_Filesystem, "writing value={:016X} to addr={:016X}", addr,
-              cheat.Value(8, cheat.width));
-    writer(cheat.width, SanitizeAddress(addr), cheat.ValueWidth(8));
-}
-
-void CheatList::BeginConditional(const Cheat& cheat) {
-    if (EvaluateConditional(cheat)) {
-        return;
+        program.push_back(instruction);
+        previous_is_write = is_write;
     }
 
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    current_index = iter->second - 1;
-}
-
-void CheatList::EndConditional(const Cheat& cheat) {
-    LOG_DEBUG(Common_Filesystem, "Ending conditional block.");
-}
-
-void CheatList::Loop(const Cheat& cheat) {
-    if (cheat.end_of_loop.Value())
-        ASSERT(!cheat.end_of_loop.Value());
-
-    auto& register_3 = scratch.at(cheat.register_3);
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    ASSERT(iter->first < iter->second);
-
-    const s32 initial_value = static_cast<s32>(cheat.Value(4, sizeof(s32)));
-    for (s32 i = initial_value; i >= 0; --i) {
-        register_3 = static_cast<u64>(i);
-        for (std::size_t c = iter->first + 1; c < iter->second; ++c) {
-            current_index = c;
-            ExecuteSingleCheat(
-                (in_standard ? standard_list : master_list)[current_block].second[c]);
+    // Conditionals left open skip to the end of the block, but loops must be closed.
+    for (const std::size_t scope : scopes) {
+        if (program[scope].opcode == Opcode::LoopBegin) {
+            return fail();
         }
+        program[scope].target = static_cast<u32>(program.size());
     }
-
-    current_index = iter->second;
+    return true;
 }
 
-void CheatList::LoadImmediate(const Cheat& cheat) {
-    auto& register_3 = scratch.at(cheat.register_3);
+bool CheatList::EvaluateConditional(const Instruction& instruction) {
+    if (instruction.opcode == Opcode::ConditionalInput) {
+        return ((GetPressState() & instruction.value) & KEYPAD_BITMASK) != 0;
+    }
 
-    LOG_DEBUG(Common_Filesystem, "setting register={:01X} equal to value={:016X}", cheat.register_3,
-              cheat.Value(4, 8));
-    register_3 = cheat.Value(4, 8);
+    const u64 value = reader(instruction.width, SanitizeAddress(instruction.address));
+    return Compare(static_cast<ComparisonOp>(instruction.operation), value, instruction.value);
 }
 
-void CheatList::LoadIndexed(const Cheat& cheat) {
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    auto& register_3 = scratch.at(cheat.register_3);
-
-    const auto addr = (cheat.load_from_register.Value() ? register_3 : offset) + cheat.Address();
-    LOG_DEBUG(Common_Filesystem, "writing indexed value to register={:01X}, addr={:016X}",
-              cheat.register_3, addr);
-    register_3 = reader(cheat.width, SanitizeAddress(addr));
-}
+u32 CheatList::GetPressState() {
+    if (press_state) {
+        return *press_state;
+    }
 
-void CheatList::StoreIndexed(const Cheat& cheat) {
-    const auto& register_3 = scratch.at(cheat.register_3);
+    const auto applet_resource =
+        system->ServiceManager().GetService<Service::HID::Hid>("hid")->GetAppletResource();
+    if (applet_resource == nullptr) {
+        LOG_WARNING(
+            Common_Filesystem,
+            "Attempted to evaluate input conditional, but applet resource is not initialized!");
+        return 0;
+    }
 
-    const auto addr =
-        register_3 + (cheat.add_additional_register.Value() ? scratch.at(cheat.register_6) : 0);
-    LOG_DEBUG(Common_Filesystem, "writing value={:016X} to addr={:016X}",
-              cheat.Value(4, cheat.width), addr);
-    writer(cheat.width, SanitizeAddress(addr), cheat.ValueWidth(4));
+    press_state =
+        applet_resource
+            ->GetController<Service::HID::Controller_NPad>(Service::HID::HidController::NPad)
+            .GetAndResetPressState();
+    return *press_state;
 }
 
-void CheatList::RegisterArithmetic(const Cheat& cheat) {
+void CheatList::RegisterArithmetic(const Instruction& instruction) {
     using ArithmeticFunction = u64 (*)(u64, u64);
     constexpr std::array<ArithmeticFunction, 5> arithmetic_functions{
         [](u64 a, u64 b) { return a + b; },  [](u64 a, u64 b) { return a - b; },
@@ -247,32 +391,16 @@ void CheatList::RegisterArithmetic(const Cheat& cheat) {
     static_assert(sizeof(arithmetic_functions) == sizeof(arithmetic_overflow_checks),
                   "Missing or have extra arithmetic overflow checks compared to functions!");
 
-    auto& register_3 = scratch.at(cheat.register_3);
-
-    ASSERT(static_cast<u8>(cheat.arithmetic_op.Value()) < 5);
-    auto* function = arithmetic_functions[static_cast<u8>(cheat.arithmetic_op.Value())];
-    auto* overflow_function =
-        arithmetic_overflow_checks[static_cast<u8>(cheat.arithmetic_op.Value())];
-    LOG_DEBUG(Common_Filesystem, "performing arithmetic with register={:01X}, value={:016X}",
-              cheat.register_3, cheat.ValueWidth(4));
+    auto& register_value = scratch[instruction.register_index];
 
-    if (overflow_function(register_3, cheat.ValueWidth(4))) {
+    if (arithmetic_overflow_checks[instruction.operation](register_value, instruction.value)) {
         LOG_WARNING(Common_Filesystem,
                     "overflow will occur when performing arithmetic operation={:02X} with operands "
                     "a={:016X}, b={:016X}!",
-                    static_cast<u8>(cheat.arithmetic_op.Value()), register_3, cheat.ValueWidth(4));
+                    instruction.operation, register_value, instruction.value);
     }
 
-    register_3 = function(register_3, cheat.ValueWidth(4));
-}
-
-void CheatList::BeginConditionalInput(const Cheat& cheat) {
-    if (EvaluateConditional(cheat))
-        return;
-
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    current_index = iter->second - 1;
+    register_value = arithmetic_functions[instruction.operation](register_value, instruction.value);
 }
 
 VAddr CheatList::SanitizeAddress(VAddr in) const {
@@ -289,31 +417,12 @@ VAddr CheatList::SanitizeAddress(VAddr in) const {
     return in;
 }
 
-void CheatList::ExecuteSingleCheat(const Cheat& cheat) {
-    using CheatOperationFunction = void (CheatList::*)(const Cheat&);
-    constexpr std::array<CheatOperationFunction, 9> cheat_operation_functions{
-        &CheatList::WriteImmediate,        &CheatList::BeginConditional,
-        &CheatList::EndConditional,        &CheatList::Loop,
-        &CheatList::LoadImmediate,         &CheatList::LoadIndexed,
-        &CheatList::StoreIndexed,          &CheatList::RegisterArithmetic,
-        &CheatList::BeginConditionalInput,
+bool CheatList::IsValidRange(VAddr address, u64 size) const {
+    const auto in_region = [address, size](VAddr begin, VAddr end) {
+        return address >= begin && address < end && size <= end - address;
     };
-
-    const auto index = static_cast<u8>(cheat.type.Value());
-    ASSERT(index < sizeof(cheat_operation_functions));
-    const auto op = cheat_operation_functions[index];
-    (this->*op)(cheat);
-}
-
-void CheatList::ExecuteBlock(const Block& block) {
-    encountered_loops.clear();
-
-    ProcessBlockPairs(block);
-    for (std::size_t i = 0; i < block.size(); ++i) {
-        current_index = i;
-        ExecuteSingleCheat(block[i]);
-        i = current_index;
-    }
+    return in_region(main_region_begin, main_region_end) ||
+           in_region(heap_region_begin, heap_region_end);
 }
 
 CheatParser::~CheatParser() = default;
@@ -458,6 +567,10 @@ void MemoryWriteImpl(u32 width, VAddr addr, u64 value) {
         UNREACHABLE();
     }
 }
+
+void MemoryWriteBlockImpl(VAddr addr, const void* data, std::size_t size) {
+    Memory::WriteBlock(addr, data, size);
+}
 } // Anonymous namespace
 
 CheatEngine::CheatEngine(Core::System& system, std::vector<CheatList> cheats_,
@@ -473,7 +586,7 @@ CheatEngine::CheatEngine(Core::System& system, std::vector<CheatList> cheats_,
     for (auto& list : this->cheats) {
         list.SetMemoryParameters(code_region_start, vm_manager.GetHeapRegionBaseAddress(),
                                  code_region_end, vm_manager.GetHeapRegionEndAddress(),
-                                 &MemoryWriteImpl, &MemoryReadImpl);
+                                 &MemoryWriteImpl, &MemoryWriteBlockImpl, &MemoryReadImpl);
     }
 }
 
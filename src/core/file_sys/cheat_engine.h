@@ -4,8 +4,9 @@
 
 #pragma once
 
-#include <map>
-#include <set>
+#include <array>
+#include <optional>
+#include <string>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -128,36 +129,63 @@ public:
 
     // (width in bytes, address, value)
     using MemoryWriter = void (*)(u32, VAddr, u64);
+    // (address, data, size in bytes)
+    using MemoryBlockWriter = void (*)(VAddr, const void*, std::size_t);
     // (width in bytes, address) -> value
     using MemoryReader = u64 (*)(u32, VAddr);
 
+    // Also compiles the cheats, as their addresses depend on the memory regions.
     void SetMemoryParameters(VAddr main_begin, VAddr heap_begin, VAddr main_end, VAddr heap_end,
-                             MemoryWriter writer, MemoryReader reader);
+                             MemoryWriter writer, MemoryBlockWriter block_writer,
+                             MemoryReader reader);
 
     void Execute();
 
 private:
-    CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard);
-
-    void ProcessBlockPairs(const Block& block);
-    void ExecuteSingleCheat(const Cheat& cheat);
+    enum class Opcode : u8 {
+        Write,
+        WriteBlock,
+        Conditional,
+        ConditionalInput,
+        LoopBegin,
+        LoopEnd,
+        LoadImmediate,
+        LoadIndexed,
+        StoreIndexed,
+        RegisterArithmetic,
+    };
+
+    // A cheat compiled for execution, with the memory region offsets already applied and the ends
+    // of conditionals and loops resolved to instruction indices.
+    struct Instruction {
+        Opcode opcode;
+        u8 width;
+        u8 register_index;
+        // Register added to the address, for StoreIndexed
+        u8 offset_register_index;
+        // ComparisonOp or ArithmeticOp
+        u8 operation;
+        // Whether the address is relative to register_index (or offset_register_index)
+        bool use_register;
+        u16 loop_index;
+        // Instruction to jump to, or the number of bytes written by a WriteBlock
+        u32 target;
+        u64 address;
+        // Immediate value, or the offset of the data of a WriteBlock in write_data
+        u64 value;
+    };
 
-    void ExecuteBlock(const Block& block);
+    CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard);
 
-    bool EvaluateConditional(const Cheat& cheat) const;
+    void Compile();
+    bool CompileBlock(const Block& block);
 
-    // Individual cheat operations
-    void WriteImmediate(const Cheat& cheat);
-    void BeginConditional(const Cheat& cheat);
-    void EndConditional(const Cheat& cheat);
-    void Loop(const Cheat& cheat);
-    void LoadImmediate(const Cheat& cheat);
-    void LoadIndexed(const Cheat& cheat);
-    void StoreIndexed(const Cheat& cheat);
-    void RegisterArithmetic(const Cheat& cheat);
-    void BeginConditionalInput(const Cheat& cheat);
+    bool EvaluateConditional(const Instruction& instruction);
+    void RegisterArithmetic(const Instruction& instruction);
+    u32 GetPressState();
 
     VAddr SanitizeAddress(VAddr in) const;
+    bool IsValidRange(VAddr address, u64 size) const;
 
     // Master Codes are defined as codes that cannot be disabled and are run prior to all
     // others.
@@ -165,12 +193,21 @@ private:
     // All other codes
     ProgramSegment standard_list;
 
-    bool in_standard = false;
+    // All the blocks compiled back to back, master codes first
+    std::vector<Instruction> program;
+    // Data written by WriteBlock instructions, merged from consecutive WriteImmediate codes
+    std::vector<u8> write_data;
+    // Iterations left of each loop of the program
+    std::vector<s32> loop_counters;
 
     // 16 (0x0-0xF) scratch registers that can be used by cheats
     std::array<u64, 16> scratch{};
 
+    // Buttons pressed since the previous execution, read on the first ConditionalInput
+    std::optional<u32> press_state;
+
     MemoryWriter writer = nullptr;
+    MemoryBlockWriter block_writer = nullptr;
     MemoryReader reader = nullptr;
 
     u64 main_region_begin{};
@@ -178,16 +215,6 @@ private:
     u64 main_region_end{};
     u64 heap_region_end{};
 
-    u64 current_block{};
-    // The current index of the cheat within the current Block
-    u64 current_index{};
-
-    // The 'stack' of the program. When a conditional or loop statement is encountered, its index is
-    // pushed onto this queue. When a end block is encountered, the condition is checked.
-    std::map<u64, u64> block_pairs;
-
-    std::set<u64> encountered_loops;
-
     const Core::System* system;
 };
 
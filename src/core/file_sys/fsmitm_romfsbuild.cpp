@@ -22,6 +22,7 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <string_view>
 #include "common/alignment.h"
@@ -80,10 +81,11 @@ struct RomFSBuildDirectoryContext {
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildDirectoryContext> child;
-    std::shared_ptr<RomFSBuildDirectoryContext> sibling;
-    std::shared_ptr<RomFSBuildFileContext> file;
+    u32 name_hash = 0;
+    RomFSBuildDirectoryContext* parent = nullptr;
+    RomFSBuildDirectoryContext* child = nullptr;
+    RomFSBuildDirectoryContext* sibling = nullptr;
+    RomFSBuildFileContext* file = nullptr;
 };
 
 struct RomFSBuildFileContext {
@@ -91,16 +93,20 @@ struct RomFSBuildFileContext {
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
+    u32 name_hash = 0;
     u64 offset = 0;
     u64 size = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildFileContext> sibling;
+    RomFSBuildDirectoryContext* parent = nullptr;
+    RomFSBuildFileContext* sibling = nullptr;
     VirtualFile source;
 };
 
-static u32 romfs_calc_path_hash(u32 parent, std::string_view path, u32 start,
-                                std::size_t path_len) {
-    u32 hash = parent ^ 123456789;
+// The path hash is seeded with the offset of the parent entry, which is only known once every
+// entry has been visited. Each character rotates the hash before being mixed in, so the seed and
+// the name contribute independently: the name part is computed while visiting the tree and the
+// seed is combined with it when building the tables.
+static u32 romfs_calc_name_hash(std::string_view path, u32 start, std::size_t path_len) {
+    u32 hash = 0;
     for (u32 i = 0; i < path_len; i++) {
         hash = (hash >> 5) | (hash << 27);
         hash ^= path[start + i];
@@ -109,6 +115,15 @@ static u32 romfs_calc_path_hash(u32 parent, std::string_view path, u32 start,
     return hash;
 }
 
+static u32 romfs_calc_path_hash(u32 parent, u32 name_hash, std::size_t path_len) {
+    const u32 seed = parent ^ 123456789;
+    const auto rotation = static_cast<u32>((path_len * 5) % 32);
+    if (rotation == 0) {
+        return seed ^ name_hash;
+    }
+    return ((seed >> rotation) | (seed << (32 - rotation))) ^ name_hash;
+}
+
 static u64 romfs_get_hash_table_count(u64 num_entries) {
     if (num_entries < 3) {
         return 3;
@@ -126,116 +141,111 @@ static u64 romfs_get_hash_table_count(u64 num_entries) {
     return count;
 }
 
-void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext,
-                                       std::shared_ptr<RomFSBuildDirectoryContext> parent) {
-    std::vector<std::shared_ptr<RomFSBuildDirectoryContext>> child_dirs;
-
-    VirtualDir dir;
-
-    if (parent->path_len == 0)
-        dir = root_romfs;
-    else
-        dir = root_romfs->GetDirectoryRelative(parent->path);
-
-    const auto entries = dir->GetEntries();
-
-    for (const auto& kv : entries) {
-        if (kv.second == VfsEntryType::Directory) {
-            const auto child = std::make_shared<RomFSBuildDirectoryContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
-
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
-
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
-
-            if (AddDirectory(parent, child)) {
-                child_dirs.push_back(child);
-            }
-        } else {
-            const auto child = std::make_shared<RomFSBuildFileContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
-
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
-
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
-
-            child->source = root_romfs->GetFileRelative(child->path);
-
-            if (ext != nullptr) {
-                const auto ips = ext->GetFileRelative(child->path + ".ips");
-
-                if (ips != nullptr) {
-                    auto patched = PatchIPS(child->source, ips);
-                    if (patched != nullptr)
-                        child->source = std::move(patched);
-                }
-            }
+void RomFSBuildContext::VisitDirectory(const VirtualDir& romfs_dir, const VirtualDir& ext_dir,
+                                       RomFSBuildDirectoryContext* parent) {
+    // Looking up the stubs and patches by name in a single listing avoids walking the layers of
+    // the extension directory from its root for every entry
+    std::map<std::string, VfsEntryType, std::less<>> ext_entries;
+    if (ext_dir != nullptr) {
+        ext_entries = ext_dir->GetEntries();
+    }
+    const auto has_ext_file = [&ext_entries](const std::string& name) {
+        const auto iter = ext_entries.find(name);
+        return iter != ext_entries.end() && iter->second == VfsEntryType::File;
+    };
+
+    for (auto& file : romfs_dir->GetFiles()) {
+        const std::string name = file->GetName();
+        if (has_ext_file(name + ".stub"))
+            continue;
+
+        auto child = std::make_unique<RomFSBuildFileContext>();
+        // Set child's path.
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = child->cur_path_ofs + static_cast<u32>(name.size());
+        child->path = parent->path + "/" + name;
+        child->name_hash = romfs_calc_name_hash(child->path, child->cur_path_ofs, name.size());
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        child->source = std::move(file);
+
+        if (has_ext_file(name + ".ips")) {
+            auto patched = PatchIPS(child->source, ext_dir->GetFile(name + ".ips"));
+            if (patched != nullptr)
+                child->source = std::move(patched);
+        }
 
-            child->size = child->source->GetSize();
+        child->size = child->source->GetSize();
 
-            AddFile(parent, child);
-        }
+        AddFile(parent, std::move(child));
     }
 
-    for (auto& child : child_dirs) {
-        this->VisitDirectory(root_romfs, ext, child);
+    for (const auto& subdir : romfs_dir->GetSubdirectories()) {
+        const std::string name = subdir->GetName();
+        if (has_ext_file(name + ".stub"))
+            continue;
+
+        auto child = std::make_unique<RomFSBuildDirectoryContext>();
+        // Set child's path.
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = child->cur_path_ofs + static_cast<u32>(name.size());
+        child->path = parent->path + "/" + name;
+        child->name_hash = romfs_calc_name_hash(child->path, child->cur_path_ofs, name.size());
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        const auto ext_iter = ext_entries.find(name);
+        const auto ext_subdir =
+            ext_iter != ext_entries.end() && ext_iter->second == VfsEntryType::Directory
+                ? ext_dir->GetSubdirectory(name)
+                : nullptr;
+
+        auto* const added = AddDirectory(parent, std::move(child));
+        VisitDirectory(subdir, ext_subdir, added);
     }
 }
 
-bool RomFSBuildContext::AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                     std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx) {
-    // Check whether it's already in the known directories.
-    const auto existing = directories.find(dir_ctx->path);
-    if (existing != directories.end())
-        return false;
-
+RomFSBuildDirectoryContext* RomFSBuildContext::AddDirectory(
+    RomFSBuildDirectoryContext* parent_dir_ctx,
+    std::unique_ptr<RomFSBuildDirectoryContext> dir_ctx) {
     // Add a new directory.
     num_dirs++;
     dir_table_size +=
         sizeof(RomFSDirectoryEntry) + Common::AlignUp(dir_ctx->path_len - dir_ctx->cur_path_ofs, 4);
     dir_ctx->parent = parent_dir_ctx;
-    directories.emplace(dir_ctx->path, dir_ctx);
+    directories.push_back(std::move(dir_ctx));
 
-    return true;
+    return directories.back().get();
 }
 
-bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                std::shared_ptr<RomFSBuildFileContext> file_ctx) {
-    // Check whether it's already in the known files.
-    const auto existing = files.find(file_ctx->path);
-    if (existing != files.end()) {
-        return false;
-    }
-
+void RomFSBuildContext::AddFile(RomFSBuildDirectoryContext* parent_dir_ctx,
+                                std::unique_ptr<RomFSBuildFileContext> file_ctx) {
     // Add a new file.
     num_files++;
     file_table_size +=
         sizeof(RomFSFileEntry) + Common::AlignUp(file_ctx->path_len - file_ctx->cur_path_ofs, 4);
     file_ctx->parent = parent_dir_ctx;
-    files.emplace(file_ctx->path, file_ctx);
-
-    return true;
+    files.push_back(std::move(file_ctx));
 }
 
 RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
     : base(std::move(base_)), ext(std::move(ext_)) {
-    root = std::make_shared<RomFSBuildDirectoryContext>();
-    root->path = "\0";
-    directories.emplace(root->path, root);
+    directories.push_back(std::make_unique<RomFSBuildDirectoryContext>());
+    root = directories.back().get();
     num_dirs = 1;
     dir_table_size = 0x18;
 
     VisitDirectory(base, ext, root);
+
+    // Entries are laid out in path order. Names are unique within a directory, so the paths are
+    // unique and the root, with its empty path, stays first.
+    std::sort(directories.begin(), directories.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs->path < rhs->path; });
+    std::sort(files.begin(), files.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs->path < rhs->path; });
 }
 
 RomFSBuildContext::~RomFSBuildContext() = default;
@@ -255,41 +265,33 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
     std::vector<u8> dir_table(dir_table_size);
     std::vector<u8> file_table(file_table_size);
 
-    std::shared_ptr<RomFSBuildFileContext> cur_file;
-
     // Determine file offsets.
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildFileContext> prev_file = nullptr;
-    for (const auto& it : files) {
-        cur_file = it.second;
+    for (const auto& cur_file : files) {
         file_partition_size = Common::AlignUp(file_partition_size, 16);
         cur_file->offset = file_partition_size;
         file_partition_size += cur_file->size;
         cur_file->entry_offset = entry_offset;
         entry_offset += sizeof(RomFSFileEntry) +
                         Common::AlignUp(cur_file->path_len - cur_file->cur_path_ofs, 4);
-        prev_file = cur_file;
     }
     // Assign deferred parent/sibling ownership.
     for (auto it = files.rbegin(); it != files.rend(); ++it) {
-        cur_file = it->second;
+        auto* const cur_file = it->get();
         cur_file->sibling = cur_file->parent->file;
         cur_file->parent->file = cur_file;
     }
 
-    std::shared_ptr<RomFSBuildDirectoryContext> cur_dir;
-
     // Determine directory offsets.
     entry_offset = 0;
-    for (const auto& it : directories) {
-        cur_dir = it.second;
+    for (const auto& cur_dir : directories) {
         cur_dir->entry_offset = entry_offset;
         entry_offset += sizeof(RomFSDirectoryEntry) +
                         Common::AlignUp(cur_dir->path_len - cur_dir->cur_path_ofs, 4);
     }
     // Assign deferred parent/sibling ownership.
-    for (auto it = directories.rbegin(); it->second != root; ++it) {
-        cur_dir = it->second;
+    for (auto it = directories.rbegin(); it->get() != root; ++it) {
+        auto* const cur_dir = it->get();
         cur_dir->sibling = cur_dir->parent->child;
         cur_dir->parent->child = cur_dir;
     }
@@ -297,8 +299,7 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
     std::map<u64, VirtualFile> out;
 
     // Populate file tables.
-    for (const auto& it : files) {
-        cur_file = it.second;
+    for (const auto& cur_file : files) {
         RomFSFileEntry cur_entry{};
 
         cur_entry.parent = cur_file->parent->entry_offset;
@@ -308,8 +309,8 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
         cur_entry.size = cur_file->size;
 
         const auto name_size = cur_file->path_len - cur_file->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_file->parent->entry_offset, cur_file->path,
-                                               cur_file->cur_path_ofs, name_size);
+        const auto hash =
+            romfs_calc_path_hash(cur_file->parent->entry_offset, cur_file->name_hash, name_size);
         cur_entry.hash = file_hash_table[hash % file_hash_table_entry_count];
         file_hash_table[hash % file_hash_table_entry_count] = cur_file->entry_offset;
 
@@ -324,11 +325,10 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
     }
 
     // Populate dir tables.
-    for (const auto& it : directories) {
-        cur_dir = it.second;
+    for (const auto& cur_dir : directories) {
         RomFSDirectoryEntry cur_entry{};
 
-        cur_entry.parent = cur_dir == root ? 0 : cur_dir->parent->entry_offset;
+        cur_entry.parent = cur_dir.get() == root ? 0 : cur_dir->parent->entry_offset;
         cur_entry.sibling =
             cur_dir->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->sibling->entry_offset;
         cur_entry.child =
@@ -336,8 +336,8 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
         cur_entry.file = cur_dir->file == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->file->entry_offset;
 
         const auto name_size = cur_dir->path_len - cur_dir->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_dir == root ? 0 : cur_dir->parent->entry_offset,
-                                               cur_dir->path, cur_dir->cur_path_ofs, name_size);
+        const u32 parent_offset = cur_dir.get() == root ? 0 : cur_dir->parent->entry_offset;
+        const auto hash = romfs_calc_path_hash(parent_offset, cur_dir->name_hash, name_size);
         cur_entry.hash = dir_hash_table[hash % dir_hash_table_entry_count];
         dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir->entry_offset;
 
@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -48,9 +49,10 @@ public:
 private:
     VirtualDir base;
     VirtualDir ext;
-    std::shared_ptr<RomFSBuildDirectoryContext> root;
-    std::map<std::string, std::shared_ptr<RomFSBuildDirectoryContext>, std::less<>> directories;
-    std::map<std::string, std::shared_ptr<RomFSBuildFileContext>, std::less<>> files;
+    // Flat tables of every entry, sorted by path once the whole tree has been visited.
+    std::vector<std::unique_ptr<RomFSBuildDirectoryContext>> directories;
+    std::vector<std::unique_ptr<RomFSBuildFileContext>> files;
+    RomFSBuildDirectoryContext* root = nullptr;
     u64 num_dirs = 0;
     u64 num_files = 0;
     u64 dir_table_size = 0;
@@ -59,13 +61,14 @@ private:
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
-    void VisitDirectory(VirtualDir filesys, VirtualDir ext,
-                        std::shared_ptr<RomFSBuildDirectoryContext> parent);
+    void VisitDirectory(const VirtualDir& romfs_dir, const VirtualDir& ext_dir,
+                        RomFSBuildDirectoryContext* parent);
 
-    bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                      std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx);
-    bool AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                 std::shared_ptr<RomFSBuildFileContext> file_ctx);
+    RomFSBuildDirectoryContext* AddDirectory(
+        RomFSBuildDirectoryContext* parent_dir_ctx,
+        std::unique_ptr<RomFSBuildDirectoryContext> dir_ctx);
+    void AddFile(RomFSBuildDirectoryContext* parent_dir_ctx,
+                 std::unique_ptr<RomFSBuildFileContext> file_ctx);
 };
 
 } // namespace FileSys
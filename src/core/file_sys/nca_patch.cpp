@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 
 #include "common/assert.h"
 #include "core/crypto/aes_util.h"
@@ -12,167 +13,151 @@
 
 namespace FileSys {
 
-BKTR::BKTR(VirtualFile base_romfs_, VirtualFile bktr_romfs_, RelocationBlock relocation_,
-           std::vector<RelocationBucket> relocation_buckets_, SubsectionBlock subsection_,
-           std::vector<SubsectionBucket> subsection_buckets_, bool is_encrypted_,
-           Core::Crypto::Key128 key_, u64 base_offset_, u64 ivfc_offset_,
-           std::array<u8, 8> section_ctr_)
-    : relocation(relocation_), relocation_buckets(std::move(relocation_buckets_)),
-      subsection(subsection_), subsection_buckets(std::move(subsection_buckets_)),
-      base_romfs(std::move(base_romfs_)), bktr_romfs(std::move(bktr_romfs_)),
-      encrypted(is_encrypted_), key(key_), base_offset(base_offset_), ivfc_offset(ivfc_offset_),
-      section_ctr(section_ctr_) {
-    for (std::size_t i = 0; i < relocation.number_buckets - 1; ++i) {
-        relocation_buckets[i].entries.push_back({relocation.base_offsets[i + 1], 0, 0});
-    }
-
-    for (std::size_t i = 0; i < subsection.number_buckets - 1; ++i) {
-        subsection_buckets[i].entries.push_back({subsection_buckets[i + 1].entries[0].address_patch,
-                                                 {0},
-                                                 subsection_buckets[i + 1].entries[0].ctr});
-    }
-
-    relocation_buckets.back().entries.push_back({relocation.size, 0, 0});
-}
-
-BKTR::~BKTR() = default;
-
-std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
-    // Read out of bounds.
-    if (offset >= relocation.size)
-        return 0;
-    const auto relocation = GetRelocationEntry(offset);
-    const auto section_offset = offset - relocation.address_patch + relocation.address_source;
-    const auto bktr_read = relocation.from_patch;
-
-    const auto next_relocation = GetNextRelocationEntry(offset);
-
-    if (offset + length > next_relocation.address_patch) {
-        const u64 partition = next_relocation.address_patch - offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
-    }
-
-    if (!bktr_read) {
-        ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
-        return base_romfs->Read(data, length, section_offset - ivfc_offset);
-    }
-
-    if (!encrypted) {
-        return bktr_romfs->Read(data, length, section_offset);
-    }
-
-    const auto subsection = GetSubsectionEntry(section_offset);
-    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
-
-    // Calculate AES IV
+namespace {
+std::vector<u8> CalculateIV(const std::array<u8, 8>& section_ctr, u64 offset, u32 subsection_ctr) {
     std::vector<u8> iv(16);
-    auto subsection_ctr = subsection.ctr;
-    auto offset_iv = section_offset + base_offset;
     for (std::size_t i = 0; i < section_ctr.size(); ++i)
         iv[i] = section_ctr[0x8 - i - 1];
-    offset_iv >>= 4;
+    offset >>= 4;
     for (std::size_t i = 0; i < sizeof(u64); ++i) {
-        iv[0xF - i] = static_cast<u8>(offset_iv & 0xFF);
-        offset_iv >>= 8;
+        iv[0xF - i] = static_cast<u8>(offset & 0xFF);
+        offset >>= 8;
     }
     for (std::size_t i = 0; i < sizeof(u32); ++i) {
         iv[0x7 - i] = static_cast<u8>(subsection_ctr & 0xFF);
         subsection_ctr >>= 8;
     }
-    cipher.SetIV(iv);
+    return iv;
+}
 
-    const auto next_subsection = GetNextSubsectionEntry(section_offset);
+template <typename Entry>
+std::size_t FindEntry(const std::vector<Entry>& entries, u64 offset) {
+    // The last entry only marks the end of the table.
+    const auto iter = std::upper_bound(
+        entries.begin(), entries.end() - 1, offset,
+        [](u64 value, const Entry& entry) { return value < entry.address_patch; });
+    if (iter == entries.begin())
+        return 0;
+    return static_cast<std::size_t>(iter - entries.begin()) - 1;
+}
+} // Anonymous namespace
 
-    if (section_offset + length > next_subsection.address_patch) {
-        const u64 partition = next_subsection.address_patch - section_offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
-    }
+BKTR::BKTR(VirtualFile base_romfs_, VirtualFile bktr_romfs_, RelocationBlock relocation,
+           std::vector<RelocationBucket> relocation_buckets, SubsectionBlock subsection,
+           std::vector<SubsectionBucket> subsection_buckets, bool is_encrypted_,
+           Core::Crypto::Key128 key_, u64 base_offset_, u64 ivfc_offset_,
+           std::array<u8, 8> section_ctr_)
+    : size(relocation.size), base_romfs(std::move(base_romfs_)),
+      bktr_romfs(std::move(bktr_romfs_)), encrypted(is_encrypted_), key(key_),
+      base_offset(base_offset_), ivfc_offset(ivfc_offset_), section_ctr(section_ctr_) {
+    for (const auto& bucket : relocation_buckets) {
+        for (const auto& entry : bucket.entries) {
+            if (!relocation_entries.empty()) {
+                const auto& last = relocation_entries.back();
+                const u64 length = entry.address_patch - last.address_patch;
+                if (last.from_patch == entry.from_patch &&
+                    last.address_source + length == entry.address_source) {
+                    continue;
+                }
+            }
 
-    const auto block_offset = section_offset & 0xF;
-    if (block_offset != 0) {
-        auto block = bktr_romfs->ReadBytes(0x10, section_offset & ~0xF);
-        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
-        if (length + block_offset < 0x10) {
-            std::memcpy(data, block.data() + block_offset, std::min(length, block.size()));
-            return std::min(length, block.size());
+            relocation_entries.push_back(entry);
+        }
+    }
+    relocation_entries.push_back({relocation.size, 0, 0});
+
+    // The IV is derived from the offset, so subsections sharing a counter form one CTR stream.
+    for (const auto& bucket : subsection_buckets) {
+        for (const auto& entry : bucket.entries) {
+            if (!subsection_entries.empty() && subsection_entries.back().ctr == entry.ctr)
+                continue;
+            subsection_entries.push_back(entry);
         }
-
-        const auto read = 0x10 - block_offset;
-        std::memcpy(data, block.data() + block_offset, read);
-        return read + Read(data + read, length - read, offset + read);
     }
+    // The last subsection extends to the end of the BKTR romfs.
+    subsection_entries.push_back({std::numeric_limits<u64>::max(), {0}, 0});
 
-    const auto raw_read = bktr_romfs->Read(data, length, section_offset);
-    cipher.Transcode(data, raw_read, data, Core::Crypto::Op::Decrypt);
-    return raw_read;
+    ASSERT_MSG(relocation_entries.size() > 1 && subsection_entries.size() > 1,
+               "BKTR relocation or subsection block is empty.");
 }
 
-template <bool Subsection, typename BlockType, typename BucketType>
-std::pair<std::size_t, std::size_t> BKTR::SearchBucketEntry(u64 offset, BlockType block,
-                                                            BucketType buckets) const {
-    if constexpr (Subsection) {
-        const auto last_bucket = buckets[block.number_buckets - 1];
-        if (offset >= last_bucket.entries[last_bucket.number_entries].address_patch)
-            return {block.number_buckets - 1, last_bucket.number_entries};
-    } else {
-        ASSERT_MSG(offset <= block.size, "Offset is out of bounds in BKTR relocation block.");
-    }
+BKTR::~BKTR() = default;
 
-    std::size_t bucket_id = std::count_if(
-        block.base_offsets.begin() + 1, block.base_offsets.begin() + block.number_buckets,
-        [&offset](u64 base_offset) { return base_offset <= offset; });
+std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
+    // Read out of bounds.
+    if (offset >= size)
+        return 0;
+    length = std::min<u64>(length, size - offset);
+
+    std::size_t total = 0;
+    for (auto i = FindRelocationEntry(offset); length > 0; ++i) {
+        const auto& relocation = relocation_entries[i];
+        const auto section_offset = offset - relocation.address_patch + relocation.address_source;
+        const auto read_in =
+            std::min<u64>(relocation_entries[i + 1].address_patch - offset, length);
+
+        std::size_t read;
+        if (relocation.from_patch) {
+            read = ReadPatch(data, read_in, section_offset);
+        } else {
+            ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
+            read = base_romfs->Read(data, read_in, section_offset - ivfc_offset);
+        }
 
-    const auto bucket = buckets[bucket_id];
+        total += read;
+        if (read != read_in)
+            break;
 
-    if (bucket.number_entries == 1)
-        return {bucket_id, 0};
+        data += read;
+        length -= read;
+        offset += read;
+    }
 
-    std::size_t low = 0;
-    std::size_t mid = 0;
-    std::size_t high = bucket.number_entries - 1;
-    while (low <= high) {
-        mid = (low + high) / 2;
-        if (bucket.entries[mid].address_patch > offset) {
-            high = mid - 1;
-        } else {
-            if (mid == bucket.number_entries - 1 ||
-                bucket.entries[mid + 1].address_patch > offset) {
-                return {bucket_id, mid};
-            }
+    return total;
+}
 
-            low = mid + 1;
-        }
+std::size_t BKTR::ReadPatch(u8* data, std::size_t length, u64 section_offset) const {
+    if (!encrypted)
+        return bktr_romfs->Read(data, length, section_offset);
+
+    // Decryption has to start on a block boundary, unaligned reads go through a buffer.
+    const u64 aligned_offset = section_offset & ~0xFULL;
+    const std::size_t block_offset = section_offset - aligned_offset;
+    std::vector<u8> buffer;
+    u8* out = data;
+    if (block_offset != 0) {
+        buffer.resize(length + block_offset);
+        out = buffer.data();
     }
 
-    UNREACHABLE_MSG("Offset could not be found in BKTR block.");
-}
+    const auto raw_read = bktr_romfs->Read(out, length + block_offset, aligned_offset);
+    if (raw_read <= block_offset)
+        return 0;
 
-RelocationEntry BKTR::GetRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    return relocation_buckets[res.first].entries[res.second];
-}
+    // One call per subsection covered by the read, typically just one.
+    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
+    std::size_t decrypted = 0;
+    for (auto i = FindSubsectionEntry(aligned_offset); decrypted < raw_read; ++i) {
+        const u64 subsection_end = subsection_entries[i + 1].address_patch - aligned_offset;
+        const auto run = std::min<u64>(subsection_end - decrypted, raw_read - decrypted);
+        const auto& subsection = subsection_entries[i];
+        cipher.SetIV(CalculateIV(section_ctr, base_offset + aligned_offset + decrypted,
+                                 subsection.ctr));
+        cipher.Transcode(out + decrypted, run, out + decrypted, Core::Crypto::Op::Decrypt);
+        decrypted += run;
+    }
 
-RelocationEntry BKTR::GetNextRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    const auto bucket = relocation_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return relocation_buckets[res.first + 1].entries[0];
+    if (block_offset != 0)
+        std::memcpy(data, buffer.data() + block_offset, raw_read - block_offset);
+    return raw_read - block_offset;
 }
 
-SubsectionEntry BKTR::GetSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    return subsection_buckets[res.first].entries[res.second];
+std::size_t BKTR::FindRelocationEntry(u64 offset) const {
+    return FindEntry(relocation_entries, offset);
 }
 
-SubsectionEntry BKTR::GetNextSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    const auto bucket = subsection_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return subsection_buckets[res.first + 1].entries[0];
+std::size_t BKTR::FindSubsectionEntry(u64 offset) const {
+    return FindEntry(subsection_entries, offset);
 }
 
 std::string BKTR::GetName() const {
@@ -180,7 +165,7 @@ std::string BKTR::GetName() const {
 }
 
 std::size_t BKTR::GetSize() const {
-    return relocation.size;
+    return size;
 }
 
 bool BKTR::Resize(std::size_t new_size) {
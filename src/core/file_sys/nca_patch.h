@@ -12,6 +12,7 @@
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/crypto/key_manager.h"
+#include "core/file_sys/vfs.h"
 
 namespace FileSys {
 
@@ -117,20 +118,19 @@ public:
     bool Rename(std::string_view name) override;
 
 private:
-    template <bool Subsection, typename BlockType, typename BucketType>
-    std::pair<std::size_t, std::size_t> SearchBucketEntry(u64 offset, BlockType block,
-                                                          BucketType buckets) const;
-
-    RelocationEntry GetRelocationEntry(u64 offset) const;
-    RelocationEntry GetNextRelocationEntry(u64 offset) const;
-
-    SubsectionEntry GetSubsectionEntry(u64 offset) const;
-    SubsectionEntry GetNextSubsectionEntry(u64 offset) const;
-
-    RelocationBlock relocation;
-    std::vector<RelocationBucket> relocation_buckets;
-    SubsectionBlock subsection;
-    std::vector<SubsectionBucket> subsection_buckets;
+    // Reads from the BKTR romfs, decrypting it if necessary.
+    std::size_t ReadPatch(u8* data, std::size_t length, u64 section_offset) const;
+
+    // Returns the index of the entry the offset falls within.
+    std::size_t FindRelocationEntry(u64 offset) const;
+    std::size_t FindSubsectionEntry(u64 offset) const;
+
+    // The entries of all of the buckets flattened into one sorted array at construction, with
+    // adjacent entries describing one contiguous extent merged. Each array ends with an entry
+    // marking the end of the last extent.
+    std::vector<RelocationEntry> relocation_entries;
+    std::vector<SubsectionEntry> subsection_entries;
+    u64 size;
 
     // Should be the raw base romfs, decrypted.
     VirtualFile base_romfs;
@@ -9,6 +9,7 @@
 #include "core/core.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_write_back.h"
 #include "core/hle/kernel/process.h"
 
 namespace FileSys {
@@ -88,7 +89,15 @@ ResultVal<VirtualDir> SaveDataFactory::Open(SaveDataSpaceId space, const SaveDat
         return ResultCode(-1);
     }
 
-    return MakeResult<VirtualDir>(std::move(out));
+    // Writes are held in memory until the title commits them
+    auto& cached = write_back_caches[save_directory];
+    auto write_back = cached.lock();
+    if (write_back == nullptr) {
+        write_back = std::make_shared<WriteBackCache>(std::move(out));
+        cached = write_back;
+    }
+
+    return MakeResult<VirtualDir>(write_back->OpenRoot());
 }
 
 VirtualDir SaveDataFactory::GetSaveDataSpaceDirectory(SaveDataSpaceId space) const {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include "common/common_funcs.h"
@@ -14,6 +15,8 @@
 
 namespace FileSys {
 
+class WriteBackCache;
+
 enum class SaveDataSpaceId : u8 {
     NandSystem = 0,
     NandUser = 1,
@@ -77,6 +80,8 @@ public:
 
 private:
     VirtualDir dir;
+    /// Caches of the opened save data, keyed by path so every opening shares the same contents
+    std::map<std::string, std::weak_ptr<WriteBackCache>> write_back_caches;
 };
 
 } // namespace FileSys
@@ -195,6 +195,10 @@ std::size_t VfsFile::WriteBytes(const std::vector<u8>& data, std::size_t offset)
     return Write(data.data(), data.size(), offset);
 }
 
+bool VfsFile::Sync() {
+    return true;
+}
+
 std::string VfsFile::GetFullPath() const {
     if (GetContainingDirectory() == nullptr)
         return "/" + GetName();
@@ -172,6 +172,10 @@ public:
     // Renames the file to name. Returns whether or not the operation was successsful.
     virtual bool Rename(std::string_view name) = 0;
 
+    // Writes any data the file holds back to its storage device and waits for it to be stored.
+    // Returns whether or not the operation was successful.
+    virtual bool Sync();
+
     // Returns the full path of this file as a string, recursively
     virtual std::string GetFullPath() const;
 };
@@ -25,16 +25,23 @@ static bool VerifyConcatenationMapContinuity(const std::map<u64, VirtualFile>& m
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::vector<VirtualFile> files_, std::string name)
     : name(std::move(name)) {
-    std::size_t next_offset = 0;
-    for (const auto& file : files_) {
-        files[next_offset] = file;
-        next_offset += file->GetSize();
+    files.reserve(files_.size());
+    u64 next_offset = 0;
+    for (auto& file : files_) {
+        const auto size = file->GetSize();
+        files.push_back({next_offset, size, std::move(file)});
+        next_offset += size;
     }
 }
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::map<u64, VirtualFile> files_, std::string name)
-    : files(std::move(files_)), name(std::move(name)) {
-    ASSERT(VerifyConcatenationMapContinuity(files));
+    : name(std::move(name)) {
+    ASSERT(VerifyConcatenationMapContinuity(files_));
+    files.reserve(files_.size());
+    for (auto& [offset, file] : files_) {
+        const auto size = file->GetSize();
+        files.push_back({offset, size, std::move(file)});
+    }
 }
 
 ConcatenatedVfsFile::~ConcatenatedVfsFile() = default;
@@ -79,13 +86,13 @@ std::string ConcatenatedVfsFile::GetName() const {
         return "";
     if (!name.empty())
         return name;
-    return files.begin()->second->GetName();
+    return files.front().file->GetName();
 }
 
 std::size_t ConcatenatedVfsFile::GetSize() const {
     if (files.empty())
         return 0;
-    return files.rbegin()->first + files.rbegin()->second->GetSize();
+    return files.back().offset + files.back().size;
 }
 
 bool ConcatenatedVfsFile::Resize(std::size_t new_size) {
@@ -95,7 +102,7 @@ bool ConcatenatedVfsFile::Resize(std::size_t new_size) {
 std::shared_ptr<VfsDirectory> ConcatenatedVfsFile::GetContainingDirectory() const {
     if (files.empty())
         return nullptr;
-    return files.begin()->second->GetContainingDirectory();
+    return files.front().file->GetContainingDirectory();
 }
 
 bool ConcatenatedVfsFile::IsWritable() const {
@@ -107,25 +114,21 @@ bool ConcatenatedVfsFile::IsReadable() const {
 }
 
 std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    auto entry = --files.end();
-    for (auto iter = files.begin(); iter != files.end(); ++iter) {
-        if (iter->first > offset) {
-            entry = --iter;
+    std::size_t total = 0;
+    for (auto entry = FindEntry(offset); entry != files.end() && length > 0; ++entry) {
+        const auto entry_offset = offset - entry->offset;
+        const auto read_in = std::min<u64>(entry->size - entry_offset, length);
+        const auto read = entry->file->Read(data, read_in, entry_offset);
+        total += read;
+        if (read != read_in)
             break;
-        }
-    }
 
-    if (entry->first + entry->second->GetSize() <= offset)
-        return 0;
-
-    const auto read_in =
-        std::min<u64>(entry->first + entry->second->GetSize() - offset, entry->second->GetSize());
-    if (length > read_in) {
-        return entry->second->Read(data, read_in, offset - entry->first) +
-               Read(data + read_in, length - read_in, offset + read_in);
+        data += read;
+        length -= read;
+        offset += read;
     }
 
-    return entry->second->Read(data, std::min<u64>(read_in, length), offset - entry->first);
+    return total;
 }
 
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
@@ -136,4 +139,19 @@ bool ConcatenatedVfsFile::Rename(std::string_view name) {
     return false;
 }
 
+std::vector<ConcatenatedVfsFile::ConcatenationEntry>::const_iterator ConcatenatedVfsFile::FindEntry(
+    u64 offset) const {
+    auto iter = std::upper_bound(files.begin(), files.end(), offset,
+                                 [](u64 value, const ConcatenationEntry& entry) {
+                                     return value < entry.offset;
+                                 });
+    if (iter == files.begin())
+        return files.end();
+
+    --iter;
+    if (offset >= iter->offset + iter->size)
+        return files.end();
+    return iter;
+}
+
 } // namespace FileSys
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string_view>
+#include <vector>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -39,8 +40,17 @@ public:
     bool Rename(std::string_view name) override;
 
 private:
-    // Maps starting offset to file -- more efficient.
-    std::map<u64, VirtualFile> files;
+    struct ConcatenationEntry {
+        u64 offset;
+        u64 size;
+        VirtualFile file;
+    };
+
+    // Returns the entry containing offset, or files.end() if it is past the end of the file.
+    std::vector<ConcatenationEntry>::const_iterator FindEntry(u64 offset) const;
+
+    // Sorted by starting offset, the sizes are cached so reads don't query every file.
+    std::vector<ConcatenationEntry> files;
     std::string name;
 };
 
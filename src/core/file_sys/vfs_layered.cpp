@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <set>
 #include <utility>
 #include "core/file_sys/vfs_layered.h"
 
@@ -59,12 +60,11 @@ std::string LayeredVfsDirectory::GetFullPath() const {
 
 std::vector<std::shared_ptr<VfsFile>> LayeredVfsDirectory::GetFiles() const {
     std::vector<VirtualFile> out;
+    std::set<std::string, std::less<>> names;
     for (const auto& layer : dirs) {
-        for (const auto& file : layer->GetFiles()) {
-            if (std::find_if(out.begin(), out.end(), [&file](const VirtualFile& comp) {
-                    return comp->GetName() == file->GetName();
-                }) == out.end()) {
-                out.push_back(file);
+        for (auto& file : layer->GetFiles()) {
+            if (names.insert(file->GetName()).second) {
+                out.push_back(std::move(file));
             }
         }
     }
@@ -74,10 +74,12 @@ std::vector<std::shared_ptr<VfsFile>> LayeredVfsDirectory::GetFiles() const {
 
 std::vector<std::shared_ptr<VfsDirectory>> LayeredVfsDirectory::GetSubdirectories() const {
     std::vector<std::string> names;
+    std::set<std::string, std::less<>> seen;
     for (const auto& layer : dirs) {
         for (const auto& sd : layer->GetSubdirectories()) {
-            if (std::find(names.begin(), names.end(), sd->GetName()) == names.end())
-                names.push_back(sd->GetName());
+            auto name = sd->GetName();
+            if (seen.insert(name).second)
+                names.push_back(std::move(name));
         }
     }
 
@@ -263,6 +263,10 @@ bool RealVfsFile::Rename(std::string_view name) {
     return base.MoveFile(path, parent_path + DIR_SEP + std::string(name)) != nullptr;
 }
 
+bool RealVfsFile::Sync() {
+    return backing->Sync();
+}
+
 bool RealVfsFile::Close() {
     return backing->Close();
 }
@@ -0,0 +1,668 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <fmt/format.h>
+#include "common/logging/log.h"
+#include "core/file_sys/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+
+// Written at the root of the tree while a commit is in progress.
+constexpr char JOURNAL_FILENAME[] = ".yuzu_save_journal";
+// Directory at the root of the tree holding the contents of the committed files until they are
+// published.
+constexpr char STAGING_DIRNAME[] = ".yuzu_staged";
+
+// The journal starts with its state, both states have the same size so that the journal can be
+// published by overwriting it.
+constexpr std::string_view JOURNAL_PREPARED = "prepared\n";
+constexpr std::string_view JOURNAL_PUBLISHED = "publish!\n";
+static_assert(JOURNAL_PREPARED.size() == JOURNAL_PUBLISHED.size());
+
+// The state lines are followed by one line per path, in path order so that directories come
+// before their contents:
+//   "F <staged file> <path>" the staged file replaces the entry at path
+//   "D <path>"               an empty directory replaces the entry at path
+//   "X <path>"               the entry at path is removed
+constexpr char JOURNAL_FILE = 'F';
+constexpr char JOURNAL_DIRECTORY = 'D';
+constexpr char JOURNAL_REMOVED = 'X';
+
+std::string JoinPath(const std::string& directory, std::string_view name) {
+    return directory + '/' + std::string(name);
+}
+
+std::string GetParentPath(const std::string& path) {
+    return path.substr(0, path.rfind('/'));
+}
+
+std::string_view GetFilename(const std::string& path) {
+    return std::string_view(path).substr(path.rfind('/') + 1);
+}
+
+bool IsInDirectory(const std::string& path, const std::string& directory) {
+    return path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0 &&
+           path[directory.size()] == '/';
+}
+
+// Entries at the root of the tree used by the commits, they are hidden from the title.
+bool IsReservedPath(const std::string& path) {
+    return path == JoinPath("", JOURNAL_FILENAME) || path == JoinPath("", STAGING_DIRNAME);
+}
+
+bool IsValidName(std::string_view name) {
+    return !name.empty() && name != "." && name != ".." && name.find('/') == std::string::npos;
+}
+
+VirtualDir OpenDirectory(const VirtualDir& root, const std::string& path) {
+    return path.empty() ? root : root->GetDirectoryRelative(path);
+}
+
+bool WriteAndSync(VfsFile& file, const u8* data, std::size_t size) {
+    return file.Resize(size) && file.Write(data, size, 0) == size && file.Sync();
+}
+
+// Removes the file or directory name from dir, along with everything in it. Returns true if
+// there is nothing left at name.
+bool RemoveEntry(VfsDirectory& dir, std::string_view name) {
+    if (dir.GetFile(name) != nullptr) {
+        return dir.DeleteFile(name);
+    }
+    const auto subdir = dir.GetSubdirectory(name);
+    if (subdir == nullptr) {
+        return true;
+    }
+    for (const auto& file : subdir->GetFiles()) {
+        if (!subdir->DeleteFile(file->GetName())) {
+            return false;
+        }
+    }
+    for (const auto& child : subdir->GetSubdirectories()) {
+        if (!RemoveEntry(*subdir, child->GetName())) {
+            return false;
+        }
+    }
+    return dir.DeleteSubdirectory(name);
+}
+
+// Applies one line of a published journal to the tree.
+bool ReplayJournalEntry(const VirtualDir& root, const VirtualDir& staging,
+                        const std::string& line) {
+    if (line.size() < 3 || line[1] != ' ') {
+        return false;
+    }
+    std::string path = line.substr(2);
+    std::string staged_name;
+    if (line[0] == JOURNAL_FILE) {
+        const std::size_t separator = path.find(' ');
+        if (separator == std::string::npos) {
+            return false;
+        }
+        staged_name = path.substr(0, separator);
+        path.erase(0, separator + 1);
+    }
+
+    const auto dir = OpenDirectory(root, GetParentPath(path));
+    const std::string_view name = GetFilename(path);
+    if (dir == nullptr || !IsValidName(name)) {
+        return false;
+    }
+
+    switch (line[0]) {
+    case JOURNAL_REMOVED:
+        return RemoveEntry(*dir, name);
+    case JOURNAL_DIRECTORY:
+        return RemoveEntry(*dir, name) && dir->CreateSubdirectory(name) != nullptr;
+    case JOURNAL_FILE: {
+        const auto staged = staging == nullptr ? nullptr : staging->GetFile(staged_name);
+        if (staged == nullptr) {
+            return false;
+        }
+        if (dir->GetSubdirectory(name) != nullptr && !RemoveEntry(*dir, name)) {
+            return false;
+        }
+        auto file = dir->GetFile(name);
+        if (file == nullptr) {
+            file = dir->CreateFile(name);
+        }
+        const std::vector<u8> data = staged->ReadAllBytes();
+        return file != nullptr && WriteAndSync(*file, data.data(), data.size());
+    }
+    default:
+        return false;
+    }
+}
+
+// Replays a published journal onto the tree, then removes it along with the staged files. An
+// unpublished journal is removed without being replayed, rolling its commit back. Returns false,
+// keeping the journal, if it couldn't be replayed.
+bool ApplyJournal(const VirtualDir& root) {
+    const auto journal = root->GetFile(JOURNAL_FILENAME);
+    if (journal == nullptr) {
+        RemoveEntry(*root, STAGING_DIRNAME);
+        return true;
+    }
+
+    const std::vector<u8> journal_data = journal->ReadAllBytes();
+    const std::string journal_text(journal_data.begin(), journal_data.end());
+    const bool published =
+        journal_text.compare(0, JOURNAL_PUBLISHED.size(), JOURNAL_PUBLISHED) == 0;
+
+    if (published) {
+        const auto staging = root->GetSubdirectory(STAGING_DIRNAME);
+        std::istringstream stream{journal_text};
+        std::string line;
+        // The first line holds the state
+        std::getline(stream, line);
+        while (std::getline(stream, line)) {
+            if (!ReplayJournalEntry(root, staging, line)) {
+                LOG_ERROR(Service_FS, "Failed to publish '{}' of the commit of {}", line,
+                          root->GetFullPath());
+                return false;
+            }
+        }
+    } else {
+        LOG_WARNING(Service_FS, "Rolled back an unpublished commit of {}", root->GetFullPath());
+    }
+
+    if (!RemoveEntry(*root, STAGING_DIRNAME) || !root->DeleteFile(JOURNAL_FILENAME)) {
+        LOG_ERROR(Service_FS, "Failed to remove the commit journal of {}", root->GetFullPath());
+        return false;
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+WriteBackCache::WriteBackCache(VirtualDir root_) : root(std::move(root_)) {
+    ApplyJournal(root);
+}
+
+WriteBackCache::~WriteBackCache() {
+    if (!HasPendingChanges()) {
+        return;
+    }
+    LOG_WARNING(Service_FS, "Committing the changes left pending in {} on close",
+                root->GetFullPath());
+    Commit();
+}
+
+VirtualDir WriteBackCache::OpenRoot() {
+    return std::make_shared<WriteBackVfsDirectory>(shared_from_this(), "");
+}
+
+bool WriteBackCache::Commit() {
+    if (pending.empty()) {
+        return true;
+    }
+
+    // Finish a previous commit which failed to publish before staging over its files
+    if (!ApplyJournal(root)) {
+        return false;
+    }
+
+    std::string journal_text{JOURNAL_PREPARED};
+    std::vector<const std::vector<u8>*> staged_contents;
+    for (const auto& [path, entry] : pending) {
+        switch (entry.type) {
+        case VfsEntryType::None:
+            journal_text += fmt::format("{} {}\n", JOURNAL_REMOVED, path);
+            break;
+        case VfsEntryType::Directory:
+            journal_text += fmt::format("{} {}\n", JOURNAL_DIRECTORY, path);
+            break;
+        case VfsEntryType::File:
+            journal_text += fmt::format("{} {} {}\n", JOURNAL_FILE, staged_contents.size(), path);
+            staged_contents.push_back(&entry.data);
+            break;
+        }
+    }
+
+    const auto journal = root->CreateFile(JOURNAL_FILENAME);
+    if (journal == nullptr ||
+        !WriteAndSync(*journal, reinterpret_cast<const u8*>(journal_text.data()),
+                      journal_text.size())) {
+        LOG_ERROR(Service_FS, "Failed to write the commit journal of {}", root->GetFullPath());
+        root->DeleteFile(JOURNAL_FILENAME);
+        return false;
+    }
+
+    const auto staging = root->CreateSubdirectory(STAGING_DIRNAME);
+    for (std::size_t i = 0; i < staged_contents.size(); ++i) {
+        const auto& data = *staged_contents[i];
+        const auto staged = staging == nullptr ? nullptr : staging->CreateFile(std::to_string(i));
+        if (staged == nullptr || !WriteAndSync(*staged, data.data(), data.size())) {
+            LOG_ERROR(Service_FS, "Failed to stage the committed files of {}",
+                      root->GetFullPath());
+            ApplyJournal(root);
+            return false;
+        }
+    }
+
+    // Once the journal is published the commit will be completed even if interrupted
+    if (journal->Write(reinterpret_cast<const u8*>(JOURNAL_PUBLISHED.data()),
+                       JOURNAL_PUBLISHED.size(), 0) != JOURNAL_PUBLISHED.size() ||
+        !journal->Sync()) {
+        LOG_ERROR(Service_FS, "Failed to publish the commit journal of {}", root->GetFullPath());
+        ApplyJournal(root);
+        return false;
+    }
+    if (!ApplyJournal(root)) {
+        return false;
+    }
+
+    pending.clear();
+    return true;
+}
+
+bool WriteBackCache::HasPendingChanges() const {
+    return !pending.empty();
+}
+
+const VirtualDir& WriteBackCache::GetRoot() const {
+    return root;
+}
+
+VfsEntryType WriteBackCache::GetEntryType(const std::string& path) const {
+    if (path.empty()) {
+        return VfsEntryType::Directory;
+    }
+    const auto iter = pending.find(path);
+    if (iter != pending.end()) {
+        return iter->second.type;
+    }
+    if (GetBackingFile(path) != nullptr) {
+        return VfsEntryType::File;
+    }
+    if (GetBackingDirectory(path) != nullptr) {
+        return VfsEntryType::Directory;
+    }
+    return VfsEntryType::None;
+}
+
+std::vector<std::string> WriteBackCache::GetEntryNames(const std::string& path,
+                                                       VfsEntryType type) const {
+    std::vector<std::string> names;
+    if (const auto dir = GetBackingDirectory(path); dir != nullptr) {
+        const auto add_backing_entry = [&](const auto& entry) {
+            std::string name = entry->GetName();
+            const std::string entry_path = JoinPath(path, name);
+            if (!IsReservedPath(entry_path) && pending.count(entry_path) == 0) {
+                names.push_back(std::move(name));
+            }
+        };
+        if (type == VfsEntryType::File) {
+            for (const auto& file : dir->GetFiles()) {
+                add_backing_entry(file);
+            }
+        } else {
+            for (const auto& subdir : dir->GetSubdirectories()) {
+                add_backing_entry(subdir);
+            }
+        }
+    }
+
+    const std::string prefix = path + '/';
+    for (auto iter = pending.lower_bound(prefix);
+         iter != pending.end() && iter->first.compare(0, prefix.size(), prefix) == 0; ++iter) {
+        const std::string_view name = std::string_view(iter->first).substr(prefix.size());
+        if (iter->second.type == type && name.find('/') == std::string_view::npos) {
+            names.emplace_back(name);
+        }
+    }
+    return names;
+}
+
+std::size_t WriteBackCache::GetFileSize(const std::string& path) const {
+    const auto iter = pending.find(path);
+    if (iter != pending.end()) {
+        return iter->second.data.size();
+    }
+    const auto file = GetBackingFile(path);
+    return file == nullptr ? 0 : file->GetSize();
+}
+
+std::size_t WriteBackCache::ReadFile(const std::string& path, u8* data, std::size_t length,
+                                     std::size_t offset) const {
+    const auto iter = pending.find(path);
+    if (iter == pending.end()) {
+        const auto file = GetBackingFile(path);
+        return file == nullptr ? 0 : file->Read(data, length, offset);
+    }
+    const auto& contents = iter->second.data;
+    if (offset >= contents.size()) {
+        return 0;
+    }
+    const std::size_t read_size = std::min(length, contents.size() - offset);
+    std::memcpy(data, contents.data() + offset, read_size);
+    return read_size;
+}
+
+std::size_t WriteBackCache::WriteFile(const std::string& path, const u8* data, std::size_t length,
+                                      std::size_t offset) {
+    auto* const contents = LoadFile(path);
+    if (contents == nullptr) {
+        return 0;
+    }
+    if (offset + length > contents->size()) {
+        contents->resize(offset + length);
+    }
+    std::memcpy(contents->data() + offset, data, length);
+    return length;
+}
+
+bool WriteBackCache::ResizeFile(const std::string& path, std::size_t new_size) {
+    auto* const contents = LoadFile(path);
+    if (contents == nullptr) {
+        return false;
+    }
+    contents->resize(new_size);
+    return true;
+}
+
+bool WriteBackCache::CreateFile(const std::string& path) {
+    const VfsEntryType type = GetEntryType(path);
+    if (type != VfsEntryType::None) {
+        return type == VfsEntryType::File;
+    }
+    if (!CanCreate(path)) {
+        return false;
+    }
+    pending[path] = {VfsEntryType::File, {}};
+    return true;
+}
+
+bool WriteBackCache::CreateDirectory(const std::string& path) {
+    const VfsEntryType type = GetEntryType(path);
+    if (type != VfsEntryType::None) {
+        return type == VfsEntryType::Directory;
+    }
+    if (!CanCreate(path)) {
+        return false;
+    }
+    pending[path] = {VfsEntryType::Directory, {}};
+    return true;
+}
+
+bool WriteBackCache::DeleteFile(const std::string& path) {
+    if (!root->IsWritable() || GetEntryType(path) != VfsEntryType::File) {
+        return false;
+    }
+    pending[path] = {VfsEntryType::None, {}};
+    return true;
+}
+
+bool WriteBackCache::DeleteDirectory(const std::string& path, bool recursive) {
+    if (path.empty() || !root->IsWritable() || GetEntryType(path) != VfsEntryType::Directory) {
+        return false;
+    }
+    if (!recursive && (!GetEntryNames(path, VfsEntryType::File).empty() ||
+                       !GetEntryNames(path, VfsEntryType::Directory).empty())) {
+        return false;
+    }
+    EraseDescendants(path);
+    pending[path] = {VfsEntryType::None, {}};
+    return true;
+}
+
+bool WriteBackCache::RenameFile(const std::string& old_path, const std::string& new_path) {
+    if (old_path == new_path) {
+        return GetEntryType(old_path) == VfsEntryType::File;
+    }
+    if (!root->IsWritable() || GetEntryType(old_path) != VfsEntryType::File ||
+        GetEntryType(new_path) != VfsEntryType::None || !CanCreate(new_path)) {
+        return false;
+    }
+    std::vector<u8> data = std::move(*LoadFile(old_path));
+    pending[old_path] = {VfsEntryType::None, {}};
+    pending[new_path] = {VfsEntryType::File, std::move(data)};
+    return true;
+}
+
+bool WriteBackCache::RenameDirectory(const std::string& old_path, const std::string& new_path) {
+    if (old_path == new_path) {
+        return GetEntryType(old_path) == VfsEntryType::Directory;
+    }
+    if (old_path.empty() || !root->IsWritable() ||
+        GetEntryType(old_path) != VfsEntryType::Directory ||
+        GetEntryType(new_path) != VfsEntryType::None || IsInDirectory(new_path, old_path) ||
+        !CanCreate(new_path)) {
+        return false;
+    }
+    CopyDirectory(old_path, new_path);
+    EraseDescendants(old_path);
+    pending[old_path] = {VfsEntryType::None, {}};
+    return true;
+}
+
+bool WriteBackCache::IsHiddenByAncestor(const std::string& path) const {
+    for (std::string parent = GetParentPath(path); !parent.empty();
+         parent = GetParentPath(parent)) {
+        if (pending.count(parent) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+VirtualFile WriteBackCache::GetBackingFile(const std::string& path) const {
+    if (path.empty() || IsReservedPath(path) || pending.count(path) != 0 ||
+        IsHiddenByAncestor(path)) {
+        return nullptr;
+    }
+    return root->GetFileRelative(path);
+}
+
+VirtualDir WriteBackCache::GetBackingDirectory(const std::string& path) const {
+    if (path.empty()) {
+        return root;
+    }
+    if (IsReservedPath(path) || pending.count(path) != 0 || IsHiddenByAncestor(path)) {
+        return nullptr;
+    }
+    return root->GetDirectoryRelative(path);
+}
+
+std::vector<u8>* WriteBackCache::LoadFile(const std::string& path) {
+    if (!root->IsWritable()) {
+        return nullptr;
+    }
+    const auto iter = pending.find(path);
+    if (iter != pending.end()) {
+        return iter->second.type == VfsEntryType::File ? &iter->second.data : nullptr;
+    }
+    const auto file = GetBackingFile(path);
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return &pending.emplace(path, PendingEntry{VfsEntryType::File, file->ReadAllBytes()})
+                .first->second.data;
+}
+
+bool WriteBackCache::CanCreate(const std::string& path) const {
+    return root->IsWritable() && !IsReservedPath(path) && IsValidName(GetFilename(path)) &&
+           GetEntryType(GetParentPath(path)) == VfsEntryType::Directory;
+}
+
+void WriteBackCache::CopyDirectory(const std::string& old_path, const std::string& new_path) {
+    pending[new_path] = {VfsEntryType::Directory, {}};
+    for (const auto& name : GetEntryNames(old_path, VfsEntryType::File)) {
+        const std::string old_file = JoinPath(old_path, name);
+        std::vector<u8> data(GetFileSize(old_file));
+        ReadFile(old_file, data.data(), data.size(), 0);
+        pending[JoinPath(new_path, name)] = {VfsEntryType::File, std::move(data)};
+    }
+    for (const auto& name : GetEntryNames(old_path, VfsEntryType::Directory)) {
+        CopyDirectory(JoinPath(old_path, name), JoinPath(new_path, name));
+    }
+}
+
+void WriteBackCache::EraseDescendants(const std::string& path) {
+    const std::string prefix = path + '/';
+    auto iter = pending.lower_bound(prefix);
+    while (iter != pending.end() && iter->first.compare(0, prefix.size(), prefix) == 0) {
+        iter = pending.erase(iter);
+    }
+}
+
+WriteBackVfsFile::WriteBackVfsFile(std::shared_ptr<WriteBackCache> cache_, std::string path_)
+    : cache(std::move(cache_)), path(std::move(path_)) {}
+
+WriteBackVfsFile::~WriteBackVfsFile() = default;
+
+std::string WriteBackVfsFile::GetName() const {
+    return std::string(GetFilename(path));
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    return cache->GetFileSize(path);
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    return cache->ResizeFile(path, new_size);
+}
+
+std::shared_ptr<VfsDirectory> WriteBackVfsFile::GetContainingDirectory() const {
+    return std::make_shared<WriteBackVfsDirectory>(cache, GetParentPath(path));
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    return cache->GetRoot()->IsWritable();
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    return cache->GetRoot()->IsReadable();
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    return cache->ReadFile(path, data, length, offset);
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return cache->WriteFile(path, data, length, offset);
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    const std::string new_path = JoinPath(GetParentPath(path), name);
+    if (!cache->RenameFile(path, new_path)) {
+        return false;
+    }
+    path = new_path;
+    return true;
+}
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(std::shared_ptr<WriteBackCache> cache_,
+                                             std::string path_)
+    : cache(std::move(cache_)), path(std::move(path_)) {}
+
+WriteBackVfsDirectory::~WriteBackVfsDirectory() = default;
+
+bool WriteBackVfsDirectory::Commit() {
+    return cache->Commit();
+}
+
+std::shared_ptr<VfsFile> WriteBackVfsDirectory::GetFile(std::string_view name) const {
+    std::string file_path = JoinPath(path, name);
+    if (!IsValidName(name) || cache->GetEntryType(file_path) != VfsEntryType::File) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(cache, std::move(file_path));
+}
+
+std::shared_ptr<VfsDirectory> WriteBackVfsDirectory::GetSubdirectory(std::string_view name) const {
+    std::string dir_path = JoinPath(path, name);
+    if (!IsValidName(name) || cache->GetEntryType(dir_path) != VfsEntryType::Directory) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(cache, std::move(dir_path));
+}
+
+std::vector<std::shared_ptr<VfsFile>> WriteBackVfsDirectory::GetFiles() const {
+    std::vector<std::shared_ptr<VfsFile>> out;
+    for (const auto& name : cache->GetEntryNames(path, VfsEntryType::File)) {
+        out.push_back(std::make_shared<WriteBackVfsFile>(cache, JoinPath(path, name)));
+    }
+    return out;
+}
+
+std::vector<std::shared_ptr<VfsDirectory>> WriteBackVfsDirectory::GetSubdirectories() const {
+    std::vector<std::shared_ptr<VfsDirectory>> out;
+    for (const auto& name : cache->GetEntryNames(path, VfsEntryType::Directory)) {
+        out.push_back(std::make_shared<WriteBackVfsDirectory>(cache, JoinPath(path, name)));
+    }
+    return out;
+}
+
+bool WriteBackVfsDirectory::IsWritable() const {
+    return cache->GetRoot()->IsWritable();
+}
+
+bool WriteBackVfsDirectory::IsReadable() const {
+    return cache->GetRoot()->IsReadable();
+}
+
+std::string WriteBackVfsDirectory::GetName() const {
+    return path.empty() ? cache->GetRoot()->GetName() : std::string(GetFilename(path));
+}
+
+std::shared_ptr<VfsDirectory> WriteBackVfsDirectory::GetParentDirectory() const {
+    // The root of the tree is the root of the filesystem
+    if (path.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(cache, GetParentPath(path));
+}
+
+std::shared_ptr<VfsDirectory> WriteBackVfsDirectory::CreateSubdirectory(std::string_view name) {
+    std::string dir_path = JoinPath(path, name);
+    if (!cache->CreateDirectory(dir_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(cache, std::move(dir_path));
+}
+
+std::shared_ptr<VfsFile> WriteBackVfsDirectory::CreateFile(std::string_view name) {
+    std::string file_path = JoinPath(path, name);
+    if (!cache->CreateFile(file_path)) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(cache, std::move(file_path));
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectory(std::string_view name) {
+    return IsValidName(name) && cache->DeleteDirectory(JoinPath(path, name), false);
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectoryRecursive(std::string_view name) {
+    return IsValidName(name) && cache->DeleteDirectory(JoinPath(path, name), true);
+}
+
+bool WriteBackVfsDirectory::DeleteFile(std::string_view name) {
+    return IsValidName(name) && cache->DeleteFile(JoinPath(path, name));
+}
+
+bool WriteBackVfsDirectory::Rename(std::string_view name) {
+    if (path.empty()) {
+        return false;
+    }
+    const std::string new_path = JoinPath(GetParentPath(path), name);
+    if (!cache->RenameDirectory(path, new_path)) {
+        return false;
+    }
+    path = new_path;
+    return true;
+}
+
+std::string WriteBackVfsDirectory::GetFullPath() const {
+    return cache->GetRoot()->GetFullPath() + path;
+}
+
+} // namespace FileSys
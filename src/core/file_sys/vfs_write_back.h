@@ -0,0 +1,142 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// Holds the changes made to a directory tree since the last commit: the contents written to its
+// files, and the files and directories created, deleted and renamed. Nothing reaches the backing
+// directory until Commit is called, which publishes all of the pending changes at once.
+//
+// Every pending change is kept as the new state of a path: a file with its whole contents, a new
+// empty directory, or a tombstone. Each of them replaces whatever the backing directory had at
+// that path, so a renamed entry is a tombstone at its old path and a copy at its new one.
+//
+// Commits are journaled: the contents of the pending files are first staged in a hidden
+// directory and synced, then the journal listing the new state of every path is marked as
+// published and replayed onto the tree. Replaying is idempotent, so a commit interrupted by a
+// crash is rolled back or finished the next time the directory is opened, depending on whether it
+// was published.
+class WriteBackCache : public std::enable_shared_from_this<WriteBackCache> {
+public:
+    // Recovers any commit of root interrupted by a crash.
+    explicit WriteBackCache(VirtualDir root);
+    // Pending changes are committed rather than lost when the cache is destroyed.
+    ~WriteBackCache();
+
+    // Returns a directory accessing the tree through this cache.
+    VirtualDir OpenRoot();
+
+    // Publishes all of the pending changes. Returns whether or not the operation was successful.
+    // The changes stay pending on failure, a published commit which couldn't be replayed is
+    // retried by the next commit or the next time the directory is opened.
+    bool Commit();
+    // Returns whether or not some changes haven't been committed yet.
+    bool HasPendingChanges() const;
+
+    // Interface used by the files and directories of the tree. Paths are relative to the root and
+    // start with a slash, the root itself is the empty path.
+    const VirtualDir& GetRoot() const;
+    VfsEntryType GetEntryType(const std::string& path) const;
+    // Returns the names of the entries of the given type in the directory at path.
+    std::vector<std::string> GetEntryNames(const std::string& path, VfsEntryType type) const;
+    std::size_t GetFileSize(const std::string& path) const;
+    std::size_t ReadFile(const std::string& path, u8* data, std::size_t length,
+                         std::size_t offset) const;
+    std::size_t WriteFile(const std::string& path, const u8* data, std::size_t length,
+                          std::size_t offset);
+    bool ResizeFile(const std::string& path, std::size_t new_size);
+    bool CreateFile(const std::string& path);
+    bool CreateDirectory(const std::string& path);
+    bool DeleteFile(const std::string& path);
+    bool DeleteDirectory(const std::string& path, bool recursive);
+    bool RenameFile(const std::string& old_path, const std::string& new_path);
+    bool RenameDirectory(const std::string& old_path, const std::string& new_path);
+
+private:
+    // The new state of a path. An entry of type None is a tombstone.
+    struct PendingEntry {
+        VfsEntryType type;
+        std::vector<u8> data;
+    };
+
+    // Returns whether or not a pending change to an ancestor of path replaces the backing entry.
+    bool IsHiddenByAncestor(const std::string& path) const;
+    // Returns the backing file at path, or nullptr if it doesn't exist or a pending change hides
+    // it.
+    VirtualFile GetBackingFile(const std::string& path) const;
+    VirtualDir GetBackingDirectory(const std::string& path) const;
+    // Returns the pending contents of the file at path, reading them from the backing file if it
+    // has none, or nullptr if there is no file at path.
+    std::vector<u8>* LoadFile(const std::string& path);
+    // Returns whether or not a new entry can be created at path.
+    bool CanCreate(const std::string& path) const;
+    // Copies the directory at old_path and everything in it to new_path as pending entries.
+    void CopyDirectory(const std::string& old_path, const std::string& new_path);
+    void EraseDescendants(const std::string& path);
+
+    VirtualDir root;
+    std::map<std::string, PendingEntry> pending;
+};
+
+// A file of a tree accessed through a WriteBackCache.
+class WriteBackVfsFile : public VfsFile {
+public:
+    WriteBackVfsFile(std::shared_ptr<WriteBackCache> cache, std::string path);
+    ~WriteBackVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    std::shared_ptr<VfsDirectory> GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+private:
+    std::shared_ptr<WriteBackCache> cache;
+    std::string path;
+};
+
+// A directory of a tree accessed through a WriteBackCache. Changes made through it are held in
+// the cache until the tree is committed.
+class WriteBackVfsDirectory : public VfsDirectory {
+public:
+    WriteBackVfsDirectory(std::shared_ptr<WriteBackCache> cache, std::string path);
+    ~WriteBackVfsDirectory() override;
+
+    // Commits the pending changes of the whole tree, see WriteBackCache::Commit.
+    bool Commit();
+
+    std::shared_ptr<VfsFile> GetFile(std::string_view name) const override;
+    std::shared_ptr<VfsDirectory> GetSubdirectory(std::string_view name) const override;
+    std::vector<std::shared_ptr<VfsFile>> GetFiles() const override;
+    std::vector<std::shared_ptr<VfsDirectory>> GetSubdirectories() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::string GetName() const override;
+    std::shared_ptr<VfsDirectory> GetParentDirectory() const override;
+    std::shared_ptr<VfsDirectory> CreateSubdirectory(std::string_view name) override;
+    std::shared_ptr<VfsFile> CreateFile(std::string_view name) override;
+    bool DeleteSubdirectory(std::string_view name) override;
+    bool DeleteSubdirectoryRecursive(std::string_view name) override;
+    bool DeleteFile(std::string_view name) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    std::shared_ptr<WriteBackCache> cache;
+    std::string path;
+};
+
+} // namespace FileSys
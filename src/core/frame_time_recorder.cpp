@@ -0,0 +1,139 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/frame_time_recorder.h"
+
+namespace Core {
+
+namespace {
+
+constexpr std::array<const char*, static_cast<std::size_t>(FrameStage::Count)> STAGE_NAMES{
+    "game",
+    "system",
+    "present",
+};
+
+constexpr double NsToMs(double ns) {
+    return ns / 1'000'000.0;
+}
+
+/// Nearest-rank percentile of a sorted list
+s64 Percentile(const std::vector<s64>& sorted, double percent) {
+    const auto rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * sorted.size()));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // Anonymous namespace
+
+FrameTimeRecorder::FrameTimeRecorder() = default;
+
+FrameTimeRecorder::~FrameTimeRecorder() = default;
+
+void FrameTimeRecorder::Record(FrameStage stage, Clock::time_point timestamp,
+                               Clock::duration duration) {
+    StageRing& ring = rings[static_cast<std::size_t>(stage)];
+    const u64 index = ring.num_recorded.load(std::memory_order_relaxed);
+    const std::size_t slot = index % CAPACITY;
+    // Release stores let readers that see the new values also see the updated counter
+    ring.timestamps_ns[slot].store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp - start_point).count(),
+        std::memory_order_release);
+    ring.durations_ns[slot].store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+        std::memory_order_release);
+    ring.num_recorded.store(index + 1, std::memory_order_release);
+}
+
+u64 FrameTimeRecorder::GetNumRecorded(FrameStage stage) const {
+    return rings[static_cast<std::size_t>(stage)].num_recorded.load(std::memory_order_acquire);
+}
+
+FrameTimeStats FrameTimeRecorder::GetStats(FrameStage stage, std::size_t num_frames) const {
+    const std::vector<Sample> samples = ReadSamples(stage, num_frames);
+    std::vector<s64> durations_ns(samples.size());
+    std::transform(samples.begin(), samples.end(), durations_ns.begin(),
+                   [](const Sample& sample) { return sample.duration_ns; });
+    return ComputeFrameTimeStats(std::move(durations_ns));
+}
+
+bool FrameTimeRecorder::WriteCsv(const std::string& path) const {
+    FileUtil::IOFile file(path, "w");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open {} to write the frame times", path);
+        return false;
+    }
+
+    std::string csv = "stage,frame,timestamp_ms,duration_ms\n";
+    for (std::size_t stage = 0; stage < rings.size(); ++stage) {
+        const auto samples = ReadSamples(static_cast<FrameStage>(stage), MAX_READABLE_FRAMES);
+        for (const Sample& sample : samples) {
+            csv += fmt::format("{},{},{:.4f},{:.4f}\n", STAGE_NAMES[stage], sample.index,
+                               NsToMs(static_cast<double>(sample.timestamp_ns)),
+                               NsToMs(static_cast<double>(sample.duration_ns)));
+        }
+    }
+    if (file.WriteBytes(csv.data(), csv.size()) != csv.size()) {
+        LOG_ERROR(Core, "Failed to write the frame times to {}", path);
+        return false;
+    }
+    return true;
+}
+
+std::vector<FrameTimeRecorder::Sample> FrameTimeRecorder::ReadSamples(
+    FrameStage stage, std::size_t num_frames) const {
+    const StageRing& ring = rings[static_cast<std::size_t>(stage)];
+    const u64 end = ring.num_recorded.load(std::memory_order_acquire);
+    const u64 begin = end - std::min<u64>({end, num_frames, MAX_READABLE_FRAMES});
+
+    std::vector<Sample> samples;
+    samples.reserve(static_cast<std::size_t>(end - begin));
+    for (u64 index = begin; index < end; ++index) {
+        const std::size_t slot = index % CAPACITY;
+        samples.push_back({index, ring.timestamps_ns[slot].load(std::memory_order_relaxed),
+                           ring.durations_ns[slot].load(std::memory_order_relaxed)});
+    }
+
+    // The writer may have lapped the oldest samples while they were being copied, including the
+    // sample it's writing right now and hasn't counted yet
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const u64 new_end = ring.num_recorded.load(std::memory_order_relaxed) + 1;
+    if (new_end - begin > CAPACITY) {
+        const auto num_overwritten = static_cast<std::size_t>(
+            std::min<u64>(new_end - begin - CAPACITY, samples.size()));
+        samples.erase(samples.begin(), samples.begin() + num_overwritten);
+    }
+    return samples;
+}
+
+FrameTimeStats ComputeFrameTimeStats(std::vector<s64> durations_ns) {
+    FrameTimeStats stats{};
+    stats.frames = durations_ns.size();
+    if (durations_ns.empty()) {
+        return stats;
+    }
+    std::sort(durations_ns.begin(), durations_ns.end());
+
+    const s64 total = std::accumulate(durations_ns.begin(), durations_ns.end(), s64{0});
+    const s64 median = Percentile(durations_ns, 50.0);
+    const auto stutter_threshold =
+        static_cast<s64>(static_cast<double>(median) * FrameTimeRecorder::STUTTER_FACTOR);
+
+    stats.average = NsToMs(static_cast<double>(total) / static_cast<double>(stats.frames));
+    stats.p50 = NsToMs(static_cast<double>(median));
+    stats.p95 = NsToMs(static_cast<double>(Percentile(durations_ns, 95.0)));
+    stats.p99 = NsToMs(static_cast<double>(Percentile(durations_ns, 99.0)));
+    stats.max = NsToMs(static_cast<double>(durations_ns.back()));
+    stats.stutters = static_cast<std::size_t>(
+        durations_ns.end() -
+        std::upper_bound(durations_ns.begin(), durations_ns.end(), stutter_threshold));
+    return stats;
+}
+
+} // namespace Core
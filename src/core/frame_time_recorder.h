@@ -0,0 +1,100 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core {
+
+/// Points of the frame pipeline that are timed by the recorder
+enum class FrameStage : u32 {
+    Game,    ///< Frame submitted by the game, timed from the previous submission
+    System,  ///< Frame processed by the GPU thread, timed excluding frame limiting
+    Present, ///< Frame presented to the host window, timed from the previous presentation
+
+    Count,
+};
+
+/// Frame time distribution of a window of frames, all the times are in milliseconds
+struct FrameTimeStats {
+    std::size_t frames;
+    double average;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+    /// Number of frames that took longer than FrameTimeRecorder::STUTTER_FACTOR times the median
+    std::size_t stutters;
+};
+
+/**
+ * Records the timestamp and duration of every frame for each of the frame stages. Each stage has
+ * its own ring of samples, which is written by a single thread without taking any lock, so
+ * recording doesn't disturb the timing being measured. Statistics and dumps can be requested
+ * from any thread, samples overwritten while they are being read are discarded.
+ */
+class FrameTimeRecorder {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    /// Number of frames kept per stage, a bit over 18 minutes at 60 frames per second
+    static constexpr std::size_t CAPACITY = 1 << 16;
+
+    /// Frames that can be read at once, the oldest slot may be getting overwritten at any time
+    static constexpr std::size_t MAX_READABLE_FRAMES = CAPACITY - 1;
+
+    /// Frames longer than this factor times the median of their window are counted as stutters
+    static constexpr double STUTTER_FACTOR = 2.0;
+
+    FrameTimeRecorder();
+    ~FrameTimeRecorder();
+
+    /// Records a frame of a stage. A stage must always be recorded from the same thread.
+    void Record(FrameStage stage, Clock::time_point timestamp, Clock::duration duration);
+
+    /// Returns the number of frames recorded for a stage, including the overwritten ones
+    u64 GetNumRecorded(FrameStage stage) const;
+
+    /// Returns the statistics of the last num_frames frames recorded for a stage
+    FrameTimeStats GetStats(FrameStage stage,
+                            std::size_t num_frames = MAX_READABLE_FRAMES) const;
+
+    /**
+     * Writes the recorded frames of every stage to a CSV file, with a row per frame containing
+     * the stage, the frame number, its timestamp since the recorder was created and its duration.
+     * @returns true on success
+     */
+    bool WriteCsv(const std::string& path) const;
+
+private:
+    struct Sample {
+        u64 index;
+        s64 timestamp_ns;
+        s64 duration_ns;
+    };
+
+    struct StageRing {
+        std::array<std::atomic<s64>, CAPACITY> timestamps_ns{};
+        std::array<std::atomic<s64>, CAPACITY> durations_ns{};
+        std::atomic<u64> num_recorded{};
+    };
+
+    /// Copies the last num_frames samples of a stage that weren't overwritten while copying
+    std::vector<Sample> ReadSamples(FrameStage stage, std::size_t num_frames) const;
+
+    const Clock::time_point start_point = Clock::now();
+    std::array<StageRing, static_cast<std::size_t>(FrameStage::Count)> rings;
+};
+
+/// Computes the statistics of a list of frame durations in nanoseconds
+FrameTimeStats ComputeFrameTimeStats(std::vector<s64> durations_ns);
+
+} // namespace Core
@@ -73,6 +73,19 @@ public:
         return nullptr;
     }
 
+    /**
+     * Returns a GraphicsContext shared with the emu window that presents to the window itself when
+     * its buffers are swapped. It is made current on the presentation thread, while the emu window
+     * context keeps rendering on the emulation or GPU thread. It must be created from a thread
+     * where the emu window context is current.
+     *
+     * If the return value is null, then the core should assume that frames have to be presented
+     * from the thread that renders them.
+     */
+    virtual std::unique_ptr<GraphicsContext> CreatePresentationContext() const {
+        return nullptr;
+    }
+
     /**
      * Signal that a touch pressed event has occurred (e.g. mouse click pressed)
      * @param framebuffer_x Framebuffer x-coordinate that was pressed
@@ -4,9 +4,8 @@
 
 #pragma once
 
-#include <vector>
-
 #include "common/common_types.h"
+#include "core/hle/kernel/address_wait_queue.h"
 #include "core/hle/kernel/object.h"
 
 union ResultCode;
@@ -48,6 +47,14 @@ public:
     /// Waits on an address with a particular arbitration type.
     ResultCode WaitForAddress(VAddr address, ArbitrationType type, s32 value, s64 timeout_ns);
 
+    /// Removes a thread from the threads waiting on an address, when its wait times out or when
+    /// it is stopped.
+    void RemoveWaitingThread(Thread& thread);
+
+    /// Moves a thread waiting on an address to its place among the other waiting threads, after
+    /// its priority changed.
+    void UpdateWaitingThreadPriority(Thread& thread);
+
 private:
     /// Signals an address being waited on.
     ResultCode SignalToAddressOnly(VAddr address, s32 num_to_wake);
@@ -71,10 +78,13 @@ private:
     // Waits on the given address with a timeout in nanoseconds
     ResultCode WaitForAddressImpl(VAddr address, s64 timeout);
 
-    // Gets the threads waiting on an address.
-    std::vector<SharedPtr<Thread>> GetThreadsWaitingOnAddress(VAddr address) const;
+    // Wakes up num_to_wake (or all) threads waiting on an address, in priority order.
+    void WakeThreads(VAddr address, s32 num_to_wake);
 
     Core::System& system;
+
+    /// Threads waiting on addresses of this process, ordered by priority.
+    AddressWaitQueue<Thread> waiting_threads;
 };
 
 } // namespace Kernel
@@ -0,0 +1,123 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include "common/assert.h"
+#include "common/common_types.h"
+
+namespace Kernel {
+
+/**
+ * Waiters on guest addresses, kept in one list per address ordered by priority, so waking up the
+ * waiters of an address doesn't have to look at any other waiter.
+ *
+ * The links of the lists are embedded in the waiters, as an `address_wait_node` member of type
+ * Node, so a waiter is removed in constant time, for example when its wait times out. The list of
+ * an address is kept once created, as the same few addresses are waited on over and over, so
+ * waiting and waking up don't allocate either.
+ *
+ * T must provide `u32 GetPriority() const`, where lower values are higher priorities. Waiters with
+ * the same priority are kept in the order they started waiting.
+ */
+template <typename T>
+class AddressWaitQueue final {
+public:
+    struct Node {
+        T* prev = nullptr;
+        T* next = nullptr;
+        VAddr address = 0;
+        bool is_linked = false;
+    };
+
+    /// Adds a waiter on an address, behind the waiters with a higher or the same priority.
+    void Push(VAddr address, T& waiter) {
+        Node& node = waiter.address_wait_node;
+        ASSERT(!node.is_linked);
+
+        List& list = lists[address];
+        const u32 priority = waiter.GetPriority();
+
+        // Search from the back, most waiters of an address share the same priority.
+        T* prev = list.tail;
+        while (prev != nullptr && prev->GetPriority() > priority) {
+            prev = prev->address_wait_node.prev;
+        }
+
+        node.prev = prev;
+        node.next = prev != nullptr ? prev->address_wait_node.next : list.head;
+        node.address = address;
+        node.is_linked = true;
+        if (prev != nullptr) {
+            prev->address_wait_node.next = &waiter;
+        } else {
+            list.head = &waiter;
+        }
+        if (node.next != nullptr) {
+            node.next->address_wait_node.prev = &waiter;
+        } else {
+            list.tail = &waiter;
+        }
+        ++list.size;
+    }
+
+    /// Removes a waiter from the list of the address it waits on.
+    void Remove(T& waiter) {
+        Node& node = waiter.address_wait_node;
+        ASSERT(node.is_linked);
+
+        const auto iter = lists.find(node.address);
+        ASSERT(iter != lists.end());
+        List& list = iter->second;
+        if (node.prev != nullptr) {
+            node.prev->address_wait_node.next = node.next;
+        } else {
+            list.head = node.next;
+        }
+        if (node.next != nullptr) {
+            node.next->address_wait_node.prev = node.prev;
+        } else {
+            list.tail = node.prev;
+        }
+        --list.size;
+        node = {};
+    }
+
+    /// Moves a waiter to its place in its list after its priority changed.
+    void UpdatePriority(T& waiter) {
+        const VAddr address = waiter.address_wait_node.address;
+        Remove(waiter);
+        Push(address, waiter);
+    }
+
+    /// Returns true if the waiter is in the list of some address.
+    bool IsWaiting(const T& waiter) const {
+        return waiter.address_wait_node.is_linked;
+    }
+
+    /// Returns the waiter on an address with the highest priority, or nullptr if there is none.
+    T* Front(VAddr address) const {
+        const auto iter = lists.find(address);
+        return iter != lists.end() ? iter->second.head : nullptr;
+    }
+
+    /// Returns the number of waiters on an address.
+    std::size_t Count(VAddr address) const {
+        const auto iter = lists.find(address);
+        return iter != lists.end() ? iter->second.size : 0;
+    }
+
+private:
+    struct List {
+        T* head = nullptr;
+        T* tail = nullptr;
+        std::size_t size = 0;
+    };
+
+    std::unordered_map<VAddr, List> lists;
+};
+
+} // namespace Kernel
@@ -67,7 +67,6 @@ SharedPtr<WritableEvent> HLERequestContext::SleepClientThread(
     writable_event->Clear();
     thread->SetStatus(ThreadStatus::WaitHLEEvent);
     thread->SetWaitObjects({readable_event});
-    readable_event->AddWaitingThread(thread);
 
     if (timeout > 0) {
         thread->WakeAfterDelay(timeout);
@@ -330,6 +329,18 @@ std::size_t HLERequestContext::GetWriteBufferSize(int buffer_index) const {
                        : BufferDescriptorC()[buffer_index].Size();
 }
 
+VAddr HLERequestContext::GetReadBufferAddress(int buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() && BufferDescriptorA()[buffer_index].Size()};
+    return is_buffer_a ? BufferDescriptorA()[buffer_index].Address()
+                       : BufferDescriptorX()[buffer_index].Address();
+}
+
+VAddr HLERequestContext::GetWriteBufferAddress(int buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() && BufferDescriptorB()[buffer_index].Size()};
+    return is_buffer_b ? BufferDescriptorB()[buffer_index].Address()
+                       : BufferDescriptorC()[buffer_index].Address();
+}
+
 std::string HLERequestContext::Description() const {
     if (!command_header) {
         return "No command header available";
@@ -209,6 +209,13 @@ public:
     /// Helper function to get the size of the output buffer
     std::size_t GetWriteBufferSize(int buffer_index = 0) const;
 
+    /// Helper function to get the address of the input buffer, for copies that don't go through
+    /// a host buffer
+    VAddr GetReadBufferAddress(int buffer_index = 0) const;
+
+    /// Helper function to get the address of the output buffer
+    VAddr GetWriteBufferAddress(int buffer_index = 0) const;
+
     template <typename T>
     SharedPtr<T> GetCopyObject(std::size_t index) {
         return DynamicObjectCast<T>(copy_objects.at(index));
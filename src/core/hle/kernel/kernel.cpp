@@ -51,9 +51,6 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
         thread->GetStatus() == ThreadStatus::WaitSynchAll ||
         thread->GetStatus() == ThreadStatus::WaitHLEEvent) {
         // Remove the thread from each of its waiting objects' waitlists
-        for (const auto& object : thread->GetWaitObjects()) {
-            object->RemoveWaitingThread(thread.get());
-        }
         thread->ClearWaitObjects();
 
         // Invoke the wakeup callback before clearing the wait objects
@@ -81,6 +78,7 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
 
     if (thread->GetArbiterWaitAddress() != 0) {
         ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
+        thread->GetOwnerProcess()->GetAddressArbiter().RemoveWaitingThread(*thread);
         thread->SetArbiterWaitAddress(0);
     }
 
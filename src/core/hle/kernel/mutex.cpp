@@ -26,7 +26,7 @@ namespace Kernel {
 static std::pair<SharedPtr<Thread>, u32> GetHighestPriorityMutexWaitingThread(
     const SharedPtr<Thread>& current_thread, VAddr mutex_addr) {
 
-    SharedPtr<Thread> highest_priority_thread;
+    Thread* highest_priority_thread = nullptr;
     u32 num_waiters = 0;
 
     for (const auto& thread : current_thread->GetMutexWaitingThreads()) {
@@ -38,7 +38,7 @@ static std::pair<SharedPtr<Thread>, u32> GetHighestPriorityMutexWaitingThread(
         ++num_waiters;
         if (highest_priority_thread == nullptr ||
             thread->GetPriority() < highest_priority_thread->GetPriority()) {
-            highest_priority_thread = thread;
+            highest_priority_thread = thread.get();
         }
     }
 
@@ -497,10 +497,6 @@ static ResultCode WaitSynchronization(Core::System& system, Handle* index, VAddr
         return RESULT_TIMEOUT;
     }
 
-    for (auto& object : objects) {
-        object->AddWaitingThread(thread);
-    }
-
     thread->SetWaitObjects(std::move(objects));
     thread->SetStatus(ThreadStatus::WaitSynchAny);
 
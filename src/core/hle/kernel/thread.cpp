@@ -36,8 +36,15 @@ void Thread::Acquire(Thread* thread) {
     ASSERT_MSG(!ShouldWait(thread), "object unavailable!");
 }
 
-Thread::Thread(KernelCore& kernel) : WaitObject{kernel} {}
-Thread::~Thread() = default;
+Thread::Thread(KernelCore& kernel) : WaitObject{kernel} {
+    for (auto& node : wait_list_nodes) {
+        node.thread = this;
+    }
+}
+
+Thread::~Thread() {
+    ClearWaitObjects();
+}
 
 void Thread::Stop() {
     // Cancel any outstanding wakeup events for this thread
@@ -48,11 +55,13 @@ void Thread::Stop() {
     SetStatus(ThreadStatus::Dead);
     WakeupAllWaitingThreads();
 
-    // Clean up any dangling references in objects that this thread was waiting for
-    for (auto& wait_object : wait_objects) {
-        wait_object->RemoveWaitingThread(this);
+    if (arb_wait_address != 0) {
+        owner_process->GetAddressArbiter().RemoveWaitingThread(*this);
+        arb_wait_address = 0;
     }
-    wait_objects.clear();
+
+    // Clean up any dangling references in objects that this thread was waiting for
+    ClearWaitObjects();
 
     owner_process->UnregisterThread(this);
 
@@ -314,6 +323,11 @@ void Thread::UpdatePriority() {
 
     SetCurrentPriority(new_priority);
 
+    if (arb_wait_address != 0) {
+        // Ensure that the thread is within the correct location in the arbiter's waiting list.
+        owner_process->GetAddressArbiter().UpdateWaitingThreadPriority(*this);
+    }
+
     if (!lock_owner) {
         return;
     }
@@ -331,6 +345,21 @@ void Thread::ChangeCore(u32 core, u64 mask) {
     SetCoreAndAffinityMask(core, mask);
 }
 
+void Thread::SetWaitObjects(ThreadWaitObjects objects) {
+    ClearWaitObjects();
+    wait_objects = std::move(objects);
+    for (std::size_t i = 0; i < wait_objects.size(); ++i) {
+        wait_objects[i]->AddWaitingThread(wait_list_nodes[i]);
+    }
+}
+
+void Thread::ClearWaitObjects() {
+    for (std::size_t i = 0; i < wait_objects.size(); ++i) {
+        wait_objects[i]->RemoveWaitingThread(wait_list_nodes[i]);
+    }
+    wait_objects.clear();
+}
+
 bool Thread::AllWaitObjectsReady() const {
     return std::none_of(
         wait_objects.begin(), wait_objects.end(),
@@ -4,13 +4,16 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <boost/container/static_vector.hpp>
 #include "common/common_types.h"
 #include "core/arm/arm_interface.h"
+#include "core/hle/kernel/address_wait_queue.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/wait_object.h"
 #include "core/hle/result.h"
@@ -92,7 +95,11 @@ public:
 
     using ThreadContext = Core::ARM_Interface::ThreadContext;
 
-    using ThreadWaitObjects = std::vector<SharedPtr<WaitObject>>;
+    /// Maximum number of objects a thread can wait on at once, the WaitSynchronization limit.
+    static constexpr std::size_t MaxWaitObjects = 0x40;
+
+    using ThreadWaitObjects =
+        boost::container::static_vector<SharedPtr<WaitObject>, MaxWaitObjects>;
 
     using WakeupCallback = std::function<bool(ThreadWakeupReason reason, SharedPtr<Thread> thread,
                                               SharedPtr<WaitObject> object, std::size_t index)>;
@@ -308,13 +315,11 @@ public:
         return wait_objects;
     }
 
-    void SetWaitObjects(ThreadWaitObjects objects) {
-        wait_objects = std::move(objects);
-    }
+    /// Sets the objects the thread waits on, and adds it to their lists of waiting threads.
+    void SetWaitObjects(ThreadWaitObjects objects);
 
-    void ClearWaitObjects() {
-        wait_objects.clear();
-    }
+    /// Removes the thread from the lists of waiting threads of its wait objects, and clears them.
+    void ClearWaitObjects();
 
     /// Determines whether all the objects this thread is waiting on are ready.
     bool AllWaitObjectsReady() const;
@@ -423,6 +428,8 @@ public:
     }
 
 private:
+    friend class AddressWaitQueue<Thread>;
+
     explicit Thread(KernelCore& kernel);
     ~Thread() override;
 
@@ -467,6 +474,9 @@ private:
     /// passed to WaitSynchronization1/N.
     ThreadWaitObjects wait_objects;
 
+    /// Links of the thread in the waiting lists of its wait objects, one for each of them.
+    std::array<WaitListNode, MaxWaitObjects> wait_list_nodes;
+
     /// List of threads that are waiting for a mutex that is held by this thread.
     MutexWaitingThreads wait_mutex_threads;
 
@@ -482,6 +492,8 @@ private:
 
     /// If waiting for an AddressArbiter, this is the address being waited on.
     VAddr arb_wait_address{0};
+    /// Links of the thread in the AddressArbiter list of the threads waiting on arb_wait_address.
+    AddressWaitQueue<Thread>::Node address_wait_node;
 
     /// Handle used as userdata to reference this object when inserting into the CoreTiming queue.
     Handle callback_handle = 0;
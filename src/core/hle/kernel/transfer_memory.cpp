@@ -34,6 +34,14 @@ u64 TransferMemory::GetSize() const {
     return memory_size;
 }
 
+VAddr TransferMemory::GetBaseAddress() const {
+    return base_address;
+}
+
+const Process* TransferMemory::GetOwnerProcess() const {
+    return owner_process;
+}
+
 ResultCode TransferMemory::MapMemory(VAddr address, u64 size, MemoryPermission permissions) {
     if (memory_size != size) {
         return ERR_INVALID_SIZE;
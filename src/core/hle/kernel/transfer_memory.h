@@ -55,6 +55,12 @@ public:
     /// Gets the size of the memory backing this instance in bytes.
     u64 GetSize() const;
 
+    /// Gets the address of the memory this instance was created from.
+    VAddr GetBaseAddress() const;
+
+    /// Gets the process that created this instance.
+    const Process* GetOwnerProcess() const;
+
     /// Attempts to map transfer memory with the given range and memory permissions.
     ///
     /// @param address     The base address to being mapping memory at.
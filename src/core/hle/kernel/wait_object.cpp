@@ -17,26 +17,41 @@ namespace Kernel {
 WaitObject::WaitObject(KernelCore& kernel) : Object{kernel} {}
 WaitObject::~WaitObject() = default;
 
-void WaitObject::AddWaitingThread(SharedPtr<Thread> thread) {
-    auto itr = std::find(waiting_threads.begin(), waiting_threads.end(), thread);
-    if (itr == waiting_threads.end())
-        waiting_threads.push_back(std::move(thread));
+void WaitObject::AddWaitingThread(WaitListNode& node) {
+    ASSERT(node.thread != nullptr && node.prev == nullptr && node.next == nullptr);
+
+    node.prev = waiting_threads_tail;
+    if (waiting_threads_tail != nullptr) {
+        waiting_threads_tail->next = &node;
+    } else {
+        waiting_threads_head = &node;
+    }
+    waiting_threads_tail = &node;
 }
 
-void WaitObject::RemoveWaitingThread(Thread* thread) {
-    auto itr = std::find(waiting_threads.begin(), waiting_threads.end(), thread);
-    // If a thread passed multiple handles to the same object,
-    // the kernel might attempt to remove the thread from the object's
-    // waiting threads list multiple times.
-    if (itr != waiting_threads.end())
-        waiting_threads.erase(itr);
+void WaitObject::RemoveWaitingThread(WaitListNode& node) {
+    if (node.prev != nullptr) {
+        node.prev->next = node.next;
+    } else {
+        ASSERT(waiting_threads_head == &node);
+        waiting_threads_head = node.next;
+    }
+    if (node.next != nullptr) {
+        node.next->prev = node.prev;
+    } else {
+        ASSERT(waiting_threads_tail == &node);
+        waiting_threads_tail = node.prev;
+    }
+    node.prev = nullptr;
+    node.next = nullptr;
 }
 
 SharedPtr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
     Thread* candidate = nullptr;
     u32 candidate_priority = THREADPRIO_LOWEST + 1;
 
-    for (const auto& thread : waiting_threads) {
+    for (const WaitListNode* node = waiting_threads_head; node != nullptr; node = node->next) {
+        Thread* const thread = node->thread;
         const ThreadStatus thread_status = thread->GetStatus();
 
         // The list of waiting threads must not contain threads that are not waiting to be awakened.
@@ -48,7 +63,7 @@ SharedPtr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
         if (thread->GetPriority() >= candidate_priority)
             continue;
 
-        if (ShouldWait(thread.get()))
+        if (ShouldWait(thread))
             continue;
 
         // A thread is ready to run if it's either in ThreadStatus::WaitSynchAny or
@@ -59,7 +74,7 @@ SharedPtr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
         }
 
         if (ready_to_run) {
-            candidate = thread.get();
+            candidate = thread;
             candidate_priority = thread->GetPriority();
         }
     }
@@ -84,8 +99,6 @@ void WaitObject::WakeupWaitingThread(SharedPtr<Thread> thread) {
 
     const std::size_t index = thread->GetWaitObjectIndex(this);
 
-    for (const auto& object : thread->GetWaitObjects())
-        object->RemoveWaitingThread(thread.get());
     thread->ClearWaitObjects();
 
     thread->CancelWakeupTimer();
@@ -107,8 +120,14 @@ void WaitObject::WakeupAllWaitingThreads() {
     }
 }
 
-const std::vector<SharedPtr<Thread>>& WaitObject::GetWaitingThreads() const {
-    return waiting_threads;
+std::vector<SharedPtr<Thread>> WaitObject::GetWaitingThreads() const {
+    std::vector<SharedPtr<Thread>> threads;
+    for (const WaitListNode* node = waiting_threads_head; node != nullptr; node = node->next) {
+        if (std::find(threads.begin(), threads.end(), node->thread) == threads.end()) {
+            threads.emplace_back(node->thread);
+        }
+    }
+    return threads;
 }
 
 } // namespace Kernel
@@ -13,6 +13,17 @@ namespace Kernel {
 class KernelCore;
 class Thread;
 
+/**
+ * Link of a thread in the list of the threads waiting on a WaitObject. Threads embed one for each
+ * of the objects they can wait on at once, so waiting doesn't allocate and a thread leaves the list
+ * of an object in constant time when it's woken up or its wait times out.
+ */
+struct WaitListNode {
+    Thread* thread = nullptr;
+    WaitListNode* prev = nullptr;
+    WaitListNode* next = nullptr;
+};
+
 /// Class that represents a Kernel object that a thread can be waiting on
 class WaitObject : public Object {
 public:
@@ -31,15 +42,15 @@ public:
 
     /**
      * Add a thread to wait on this object
-     * @param thread Pointer to thread to add
+     * @param node Unlinked node of the thread to add, with its thread set
      */
-    void AddWaitingThread(SharedPtr<Thread> thread);
+    void AddWaitingThread(WaitListNode& node);
 
     /**
      * Removes a thread from waiting on this object (e.g. if it was resumed already)
-     * @param thread Pointer to thread to remove
+     * @param node Node the thread was added with
      */
-    void RemoveWaitingThread(Thread* thread);
+    void RemoveWaitingThread(WaitListNode& node);
 
     /**
      * Wake up all threads waiting on this object that can be awoken, in priority order,
@@ -56,12 +67,14 @@ public:
     /// Obtains the highest priority thread that is ready to run from this object's waiting list.
     SharedPtr<Thread> GetHighestPriorityReadyThread() const;
 
-    /// Get a const reference to the waiting threads list for debug use
-    const std::vector<SharedPtr<Thread>>& GetWaitingThreads() const;
+    /// Get a copy of the waiting threads list for debug use
+    std::vector<SharedPtr<Thread>> GetWaitingThreads() const;
 
 private:
-    /// Threads waiting for this object to become available
-    std::vector<SharedPtr<Thread>> waiting_threads;
+    /// Threads waiting for this object to become available, in the order they started waiting. A
+    /// thread that passed several handles to this object is in the list once for each of them.
+    WaitListNode* waiting_threads_head = nullptr;
+    WaitListNode* waiting_threads_tail = nullptr;
 };
 
 // Specialization of DynamicObjectCast for WaitObjects
@@ -33,6 +33,7 @@
 #include "core/hle/service/pm/pm.h"
 #include "core/hle/service/set/set.h"
 #include "core/hle/service/vi/vi.h"
+#include "core/memory.h"
 #include "core/settings.h"
 
 namespace Service::AM {
@@ -603,8 +604,92 @@ void ICommonStateGetter::GetDefaultDisplayResolution(Kernel::HLERequestContext&
     }
 }
 
+namespace {
+/// Storage created by the emulator or with CreateStorage, backed by host memory
+class VectorStorage final : public IStorageImpl {
+public:
+    explicit VectorStorage(std::vector<u8> buffer) : buffer{std::move(buffer)} {}
+
+    std::size_t GetSize() const override {
+        return buffer.size();
+    }
+
+    void Read(std::size_t offset, void* dest, std::size_t size) const override {
+        std::memcpy(dest, buffer.data() + offset, size);
+    }
+
+    void Write(std::size_t offset, const void* src, std::size_t size) override {
+        std::memcpy(buffer.data() + offset, src, size);
+    }
+
+    void ReadToGuest(std::size_t offset, VAddr dest_addr, std::size_t size) const override {
+        Memory::WriteBlock(dest_addr, buffer.data() + offset, size);
+    }
+
+    void WriteFromGuest(std::size_t offset, VAddr src_addr, std::size_t size) override {
+        Memory::ReadBlock(src_addr, buffer.data() + offset, size);
+    }
+
+private:
+    std::vector<u8> buffer;
+};
+
+/// Storage created with CreateTransferMemoryStorage, aliasing the memory of the process that
+/// created the transfer memory. Accesses go through the page table of that process every time,
+/// as the host memory backing the range moves when the heap is resized.
+class TransferMemoryStorage final : public IStorageImpl {
+public:
+    explicit TransferMemoryStorage(Kernel::SharedPtr<Kernel::TransferMemory> transfer_memory)
+        : transfer_memory{std::move(transfer_memory)} {}
+
+    std::size_t GetSize() const override {
+        return static_cast<std::size_t>(transfer_memory->GetSize());
+    }
+
+    void Read(std::size_t offset, void* dest, std::size_t size) const override {
+        Memory::ReadBlock(*transfer_memory->GetOwnerProcess(),
+                          transfer_memory->GetBaseAddress() + offset, dest, size);
+    }
+
+    void Write(std::size_t offset, const void* src, std::size_t size) override {
+        Memory::WriteBlock(*transfer_memory->GetOwnerProcess(),
+                           transfer_memory->GetBaseAddress() + offset, src, size);
+    }
+
+    // IPC buffers belong to the current process, memory can only be copied directly between them
+    // and the storage when the process owns the transfer memory, which is the usual case.
+    void ReadToGuest(std::size_t offset, VAddr dest_addr, std::size_t size) const override {
+        if (transfer_memory->GetOwnerProcess() == Core::CurrentProcess()) {
+            Memory::CopyBlock(dest_addr, transfer_memory->GetBaseAddress() + offset, size);
+            return;
+        }
+        std::vector<u8> data(size);
+        Read(offset, data.data(), size);
+        Memory::WriteBlock(dest_addr, data.data(), size);
+    }
+
+    void WriteFromGuest(std::size_t offset, VAddr src_addr, std::size_t size) override {
+        if (transfer_memory->GetOwnerProcess() == Core::CurrentProcess()) {
+            Memory::CopyBlock(transfer_memory->GetBaseAddress() + offset, src_addr, size);
+            return;
+        }
+        std::vector<u8> data(size);
+        Memory::ReadBlock(src_addr, data.data(), size);
+        Write(offset, data.data(), size);
+    }
+
+private:
+    Kernel::SharedPtr<Kernel::TransferMemory> transfer_memory;
+};
+} // Anonymous namespace
+
+IStorageImpl::~IStorageImpl() = default;
+
 IStorage::IStorage(std::vector<u8> buffer)
-    : ServiceFramework("IStorage"), buffer(std::move(buffer)) {
+    : IStorage{std::make_shared<VectorStorage>(std::move(buffer))} {}
+
+IStorage::IStorage(std::shared_ptr<IStorageImpl> impl)
+    : ServiceFramework("IStorage"), impl{std::move(impl)} {
     // clang-format off
         static const FunctionInfo functions[] = {
             {0, &IStorage::Open, "Open"},
@@ -617,8 +702,21 @@ IStorage::IStorage(std::vector<u8> buffer)
 
 IStorage::~IStorage() = default;
 
-const std::vector<u8>& IStorage::GetData() const {
-    return buffer;
+std::size_t IStorage::GetSize() const {
+    return impl->GetSize();
+}
+
+void IStorage::Read(std::size_t offset, void* buffer, std::size_t size) const {
+    ASSERT_MSG(offset <= impl->GetSize() && size <= impl->GetSize() - offset,
+               "read out of bounds, offset={}, size={}, storage size={}", offset, size,
+               impl->GetSize());
+    impl->Read(offset, buffer, size);
+}
+
+std::vector<u8> IStorage::CopyData() const {
+    std::vector<u8> data(impl->GetSize());
+    impl->Read(0, data.data(), data.size());
+    return data;
 }
 
 void ICommonStateGetter::GetOperationMode(Kernel::HLERequestContext& ctx) {
@@ -712,7 +810,7 @@ private:
         LOG_DEBUG(Service_AM, "called");
 
         IPC::RequestParser rp{ctx};
-        applet->GetBroker().PushNormalDataFromGame(*rp.PopIpcInterface<IStorage>());
+        applet->GetBroker().PushNormalDataFromGame(rp.PopIpcInterface<IStorage>());
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(RESULT_SUCCESS);
@@ -733,14 +831,14 @@ private:
         }
 
         rb.Push(RESULT_SUCCESS);
-        rb.PushIpcInterface<IStorage>(std::move(*storage));
+        rb.PushIpcInterface(storage);
     }
 
     void PushInteractiveInData(Kernel::HLERequestContext& ctx) {
         LOG_DEBUG(Service_AM, "called");
 
         IPC::RequestParser rp{ctx};
-        applet->GetBroker().PushInteractiveDataFromGame(*rp.PopIpcInterface<IStorage>());
+        applet->GetBroker().PushInteractiveDataFromGame(rp.PopIpcInterface<IStorage>());
 
         ASSERT(applet->IsInitialized());
         applet->ExecuteInteractive();
@@ -765,7 +863,7 @@ private:
         }
 
         rb.Push(RESULT_SUCCESS);
-        rb.PushIpcInterface<IStorage>(std::move(*storage));
+        rb.PushIpcInterface(storage);
     }
 
     void GetPopOutDataEvent(Kernel::HLERequestContext& ctx) {
@@ -793,11 +891,11 @@ void IStorage::Open(Kernel::HLERequestContext& ctx) {
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
 
     rb.Push(RESULT_SUCCESS);
-    rb.PushIpcInterface<IStorageAccessor>(*this);
+    rb.PushIpcInterface<IStorageAccessor>(impl);
 }
 
-IStorageAccessor::IStorageAccessor(IStorage& storage)
-    : ServiceFramework("IStorageAccessor"), backing(storage) {
+IStorageAccessor::IStorageAccessor(std::shared_ptr<IStorageImpl> impl)
+    : ServiceFramework("IStorageAccessor"), impl(std::move(impl)) {
     // clang-format off
         static const FunctionInfo functions[] = {
             {0, &IStorageAccessor::GetSize, "GetSize"},
@@ -817,27 +915,28 @@ void IStorageAccessor::GetSize(Kernel::HLERequestContext& ctx) {
     IPC::ResponseBuilder rb{ctx, 4};
 
     rb.Push(RESULT_SUCCESS);
-    rb.Push(static_cast<u64>(backing.buffer.size()));
+    rb.Push(static_cast<u64>(impl->GetSize()));
 }
 
 void IStorageAccessor::Write(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp{ctx};
 
     const u64 offset{rp.Pop<u64>()};
-    const std::vector<u8> data{ctx.ReadBuffer()};
+    const std::size_t size{ctx.GetReadBufferSize()};
 
-    LOG_DEBUG(Service_AM, "called, offset={}, size={}", offset, data.size());
+    LOG_DEBUG(Service_AM, "called, offset={}, size={}", offset, size);
 
-    if (data.size() > backing.buffer.size() - offset) {
+    if (offset > impl->GetSize() || size > impl->GetSize() - offset) {
         LOG_ERROR(Service_AM,
                   "offset is out of bounds, backing_buffer_sz={}, data_size={}, offset={}",
-                  backing.buffer.size(), data.size(), offset);
+                  impl->GetSize(), size, offset);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ERR_SIZE_OUT_OF_BOUNDS);
+        return;
     }
 
-    std::memcpy(backing.buffer.data() + offset, data.data(), data.size());
+    impl->WriteFromGuest(offset, ctx.GetReadBufferAddress(), size);
 
     IPC::ResponseBuilder rb{ctx, 2};
     rb.Push(RESULT_SUCCESS);
@@ -851,15 +950,16 @@ void IStorageAccessor::Read(Kernel::HLERequestContext& ctx) {
 
     LOG_DEBUG(Service_AM, "called, offset={}, size={}", offset, size);
 
-    if (size > backing.buffer.size() - offset) {
+    if (offset > impl->GetSize() || size > impl->GetSize() - offset) {
         LOG_ERROR(Service_AM, "offset is out of bounds, backing_buffer_sz={}, size={}, offset={}",
-                  backing.buffer.size(), size, offset);
+                  impl->GetSize(), size, offset);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ERR_SIZE_OUT_OF_BOUNDS);
+        return;
     }
 
-    ctx.WriteBuffer(backing.buffer.data() + offset, size);
+    impl->ReadToGuest(offset, ctx.GetWriteBufferAddress(), size);
 
     IPC::ResponseBuilder rb{ctx, 2};
     rb.Push(RESULT_SUCCESS);
@@ -935,13 +1035,11 @@ void ILibraryAppletCreator::CreateTransferMemoryStorage(Kernel::HLERequestContex
         return;
     }
 
-    const u8* const mem_begin = transfer_mem->GetPointer();
-    const u8* const mem_end = mem_begin + transfer_mem->GetSize();
-    std::vector<u8> memory{mem_begin, mem_end};
-
+    // Applets read and write the memory the game gave them directly instead of a copy of it.
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(RESULT_SUCCESS);
-    rb.PushIpcInterface(std::make_shared<IStorage>(std::move(memory)));
+    rb.PushIpcInterface(std::make_shared<IStorage>(
+        std::make_shared<TransferMemoryStorage>(transfer_mem)));
 }
 
 IApplicationFunctions::IApplicationFunctions() : ServiceFramework("IApplicationFunctions") {
@@ -7,6 +7,7 @@
 #include <chrono>
 #include <memory>
 #include <queue>
+#include <vector>
 #include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/service.h"
 
@@ -168,24 +169,46 @@ private:
     std::shared_ptr<AppletMessageQueue> msg_queue;
 };
 
+/// Memory backing an IStorage. It's shared by every IStorage referring to the same storage and by
+/// their accessors, so handing a storage between the game and an applet never copies it.
+class IStorageImpl {
+public:
+    virtual ~IStorageImpl();
+
+    virtual std::size_t GetSize() const = 0;
+    virtual void Read(std::size_t offset, void* buffer, std::size_t size) const = 0;
+    virtual void Write(std::size_t offset, const void* buffer, std::size_t size) = 0;
+
+    /// Copies part of the storage to memory of the current process, without a host buffer.
+    virtual void ReadToGuest(std::size_t offset, VAddr dest_addr, std::size_t size) const = 0;
+    /// Copies memory of the current process to part of the storage, without a host buffer.
+    virtual void WriteFromGuest(std::size_t offset, VAddr src_addr, std::size_t size) = 0;
+};
+
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(std::vector<u8> buffer);
+    explicit IStorage(std::shared_ptr<IStorageImpl> impl);
     ~IStorage() override;
 
-    const std::vector<u8>& GetData() const;
+    std::size_t GetSize() const;
+
+    /// Reads part of the storage. The storage may alias guest memory, so its contents must be
+    /// read again rather than kept around by pointer.
+    void Read(std::size_t offset, void* buffer, std::size_t size) const;
+
+    /// Returns a copy of the contents of the storage.
+    std::vector<u8> CopyData() const;
 
 private:
     void Open(Kernel::HLERequestContext& ctx);
 
-    std::vector<u8> buffer;
-
-    friend class IStorageAccessor;
+    std::shared_ptr<IStorageImpl> impl;
 };
 
 class IStorageAccessor final : public ServiceFramework<IStorageAccessor> {
 public:
-    explicit IStorageAccessor(IStorage& backing);
+    explicit IStorageAccessor(std::shared_ptr<IStorageImpl> impl);
     ~IStorageAccessor() override;
 
 private:
@@ -193,7 +216,7 @@ private:
     void Write(Kernel::HLERequestContext& ctx);
     void Read(Kernel::HLERequestContext& ctx);
 
-    IStorage& backing;
+    std::shared_ptr<IStorageImpl> impl;
 };
 
 class ILibraryAppletCreator final : public ServiceFramework<ILibraryAppletCreator> {
@@ -94,7 +94,7 @@ void Error::Initialize() {
 
     const auto storage = broker.PopNormalDataToApplet();
     ASSERT(storage != nullptr);
-    const auto data = storage->GetData();
+    const auto data = storage->CopyData();
 
     ASSERT(!data.empty());
     std::memcpy(&mode, data.data(), sizeof(ErrorAppletMode));
@@ -175,7 +175,7 @@ void Error::Execute() {
 
 void Error::DisplayCompleted() {
     complete = true;
-    broker.PushNormalDataFromApplet(IStorage{{}});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(std::vector<u8>{}));
     broker.SignalStateChanged();
 }
 
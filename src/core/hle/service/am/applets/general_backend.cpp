@@ -17,9 +17,9 @@
 namespace Service::AM::Applets {
 
 static void LogCurrentStorage(AppletDataBroker& broker, std::string prefix) {
-    std::unique_ptr<IStorage> storage = broker.PopNormalDataToApplet();
+    std::shared_ptr<IStorage> storage = broker.PopNormalDataToApplet();
     for (; storage != nullptr; storage = broker.PopNormalDataToApplet()) {
-        const auto data = storage->GetData();
+        const auto data = storage->CopyData();
         LOG_INFO(Service_AM,
                  "called (STUBBED), during {} recieved normal data with size={:08X}, data={}",
                  prefix, data.size(), Common::HexVectorToString(data));
@@ -27,7 +27,7 @@ static void LogCurrentStorage(AppletDataBroker& broker, std::string prefix) {
 
     storage = broker.PopInteractiveDataToApplet();
     for (; storage != nullptr; storage = broker.PopInteractiveDataToApplet()) {
-        const auto data = storage->GetData();
+        const auto data = storage->CopyData();
         LOG_INFO(Service_AM,
                  "called (STUBBED), during {} recieved interactive data with size={:08X}, data={}",
                  prefix, data.size(), Common::HexVectorToString(data));
@@ -44,9 +44,7 @@ void PhotoViewer::Initialize() {
 
     const auto storage = broker.PopNormalDataToApplet();
     ASSERT(storage != nullptr);
-    const auto data = storage->GetData();
-    ASSERT(!data.empty());
-    mode = static_cast<PhotoViewerAppletMode>(data[0]);
+    storage->Read(0, &mode, sizeof(mode));
 }
 
 bool PhotoViewer::TransactionComplete() const {
@@ -79,7 +77,7 @@ void PhotoViewer::Execute() {
 }
 
 void PhotoViewer::ViewFinished() {
-    broker.PushNormalDataFromApplet(IStorage{{}});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(std::vector<u8>{}));
     broker.SignalStateChanged();
 }
 
@@ -107,8 +105,8 @@ void StubApplet::ExecuteInteractive() {
     LOG_WARNING(Service_AM, "called (STUBBED)");
     LogCurrentStorage(broker, "ExecuteInteractive");
 
-    broker.PushNormalDataFromApplet(IStorage{std::vector<u8>(0x1000)});
-    broker.PushInteractiveDataFromApplet(IStorage{std::vector<u8>(0x1000)});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(std::vector<u8>(0x1000)));
+    broker.PushInteractiveDataFromApplet(std::make_shared<IStorage>(std::vector<u8>(0x1000)));
     broker.SignalStateChanged();
 }
 
@@ -116,8 +114,8 @@ void StubApplet::Execute() {
     LOG_WARNING(Service_AM, "called (STUBBED)");
     LogCurrentStorage(broker, "Execute");
 
-    broker.PushNormalDataFromApplet(IStorage{std::vector<u8>(0x1000)});
-    broker.PushInteractiveDataFromApplet(IStorage{std::vector<u8>(0x1000)});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(std::vector<u8>(0x1000)));
+    broker.PushInteractiveDataFromApplet(std::make_shared<IStorage>(std::vector<u8>(0x1000)));
     broker.SignalStateChanged();
 }
 
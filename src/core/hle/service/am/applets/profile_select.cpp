@@ -29,10 +29,8 @@ void ProfileSelect::Initialize() {
 
     const auto user_config_storage = broker.PopNormalDataToApplet();
     ASSERT(user_config_storage != nullptr);
-    const auto& user_config = user_config_storage->GetData();
-
-    ASSERT(user_config.size() >= sizeof(UserSelectionConfig));
-    std::memcpy(&config, user_config.data(), sizeof(UserSelectionConfig));
+    ASSERT(user_config_storage->GetSize() >= sizeof(UserSelectionConfig));
+    user_config_storage->Read(0, &config, sizeof(UserSelectionConfig));
 }
 
 bool ProfileSelect::TransactionComplete() const {
@@ -49,7 +47,7 @@ void ProfileSelect::ExecuteInteractive() {
 
 void ProfileSelect::Execute() {
     if (complete) {
-        broker.PushNormalDataFromApplet(IStorage{final_data});
+        broker.PushNormalDataFromApplet(std::make_shared<IStorage>(final_data));
         return;
     }
 
@@ -70,7 +68,7 @@ void ProfileSelect::SelectionComplete(std::optional<Account::UUID> uuid) {
 
     final_data = std::vector<u8>(sizeof(UserSelectionOutput));
     std::memcpy(final_data.data(), &output, final_data.size());
-    broker.PushNormalDataFromApplet(IStorage{final_data});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(final_data));
     broker.SignalStateChanged();
 }
 
@@ -53,21 +53,17 @@ void SoftwareKeyboard::Initialize() {
 
     const auto keyboard_config_storage = broker.PopNormalDataToApplet();
     ASSERT(keyboard_config_storage != nullptr);
-    const auto& keyboard_config = keyboard_config_storage->GetData();
-
-    ASSERT(keyboard_config.size() >= sizeof(KeyboardConfig));
-    std::memcpy(&config, keyboard_config.data(), sizeof(KeyboardConfig));
+    ASSERT(keyboard_config_storage->GetSize() >= sizeof(KeyboardConfig));
+    keyboard_config_storage->Read(0, &config, sizeof(KeyboardConfig));
 
     const auto work_buffer_storage = broker.PopNormalDataToApplet();
     ASSERT(work_buffer_storage != nullptr);
-    const auto& work_buffer = work_buffer_storage->GetData();
 
     if (config.initial_string_size == 0)
         return;
 
     std::vector<char16_t> string(config.initial_string_size);
-    std::memcpy(string.data(), work_buffer.data() + config.initial_string_offset,
-                string.size() * 2);
+    work_buffer_storage->Read(config.initial_string_offset, string.data(), string.size() * 2);
     initial_text = Common::UTF16StringFromFixedZeroTerminatedBuffer(string.data(), string.size());
 }
 
@@ -85,7 +81,7 @@ void SoftwareKeyboard::ExecuteInteractive() {
 
     const auto storage = broker.PopInteractiveDataToApplet();
     ASSERT(storage != nullptr);
-    const auto data = storage->GetData();
+    const auto data = storage->CopyData();
     const auto status = static_cast<bool>(data[0]);
 
     if (status == INTERACTIVE_STATUS_OK) {
@@ -101,7 +97,7 @@ void SoftwareKeyboard::ExecuteInteractive() {
 
 void SoftwareKeyboard::Execute() {
     if (complete) {
-        broker.PushNormalDataFromApplet(IStorage{final_data});
+        broker.PushNormalDataFromApplet(std::make_shared<IStorage>(final_data));
         return;
     }
 
@@ -143,15 +139,15 @@ void SoftwareKeyboard::WriteText(std::optional<std::u16string> text) {
         final_data = output_main;
 
         if (complete) {
-            broker.PushNormalDataFromApplet(IStorage{output_main});
+            broker.PushNormalDataFromApplet(std::make_shared<IStorage>(output_main));
             broker.SignalStateChanged();
         } else {
-            broker.PushInteractiveDataFromApplet(IStorage{output_sub});
+            broker.PushInteractiveDataFromApplet(std::make_shared<IStorage>(output_sub));
         }
     } else {
         output_main[0] = 1;
         complete = true;
-        broker.PushNormalDataFromApplet(IStorage{output_main});
+        broker.PushNormalDataFromApplet(std::make_shared<IStorage>(output_main));
         broker.SignalStateChanged();
     }
 }
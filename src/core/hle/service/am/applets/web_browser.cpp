@@ -109,7 +109,7 @@ void WebBrowser::Initialize() {
 
     const auto web_arg_storage = broker.PopNormalDataToApplet();
     ASSERT(web_arg_storage != nullptr);
-    const auto& web_arg = web_arg_storage->GetData();
+    const auto web_arg = web_arg_storage->CopyData();
 
     const auto url_data = GetArgumentDataForTagType(web_arg, WEB_ARGUMENT_URL_TYPE);
     filename = Common::StringFromFixedZeroTerminatedBuffer(
@@ -179,7 +179,7 @@ void WebBrowser::Finalize() {
     std::vector<u8> data(sizeof(WebArgumentResult));
     std::memcpy(data.data(), &out, sizeof(WebArgumentResult));
 
-    broker.PushNormalDataFromApplet(IStorage{data});
+    broker.PushNormalDataFromApplet(std::make_shared<IStorage>(data));
     broker.SignalStateChanged();
 
     FileUtil::DeleteDirRecursively(temporary_dir);
@@ -19,6 +19,7 @@
 #include "core/file_sys/sdmc_factory.h"
 #include "core/file_sys/vfs.h"
 #include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_write_back.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp_ldr.h"
@@ -254,6 +255,19 @@ ResultVal<FileSys::EntryType> VfsDirectoryServiceWrapper::GetEntryType(
     return FileSys::ERROR_PATH_NOT_FOUND;
 }
 
+ResultCode VfsDirectoryServiceWrapper::Commit() const {
+    // Archives writing straight to their backing storage have nothing to commit
+    const auto write_back = std::dynamic_pointer_cast<FileSys::WriteBackVfsDirectory>(backing);
+    if (write_back == nullptr) {
+        return RESULT_SUCCESS;
+    }
+    if (!write_back->Commit()) {
+        // TODO(DarkLordZach): Find a better error code for this
+        return ResultCode(-1);
+    }
+    return RESULT_SUCCESS;
+}
+
 /**
  * Map of registered file systems, identified by type. Once an file system is registered here, it
  * is never removed until UnregisterFileSystems is called.
@@ -171,6 +171,13 @@ public:
      */
     ResultVal<FileSys::EntryType> GetEntryType(const std::string& path) const;
 
+    /**
+     * Publish the changes made to the files of the archive, for archives that hold them back
+     * until they are committed (e.g. save data)
+     * @return Result of the operation
+     */
+    ResultCode Commit() const;
+
 private:
     FileSys::VirtualDir backing;
 };
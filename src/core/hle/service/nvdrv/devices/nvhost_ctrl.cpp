@@ -2,16 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/core.h"
+#include "core/hle/kernel/readable_event.h"
+#include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/nvdrv/devices/nvhost_ctrl.h"
+#include "core/hle/service/nvdrv/nvdrv.h"
+#include "core/hle/service/nvdrv/syncpoint_manager.h"
+#include "video_core/gpu.h"
 
 namespace Service::Nvidia::Devices {
 
-nvhost_ctrl::nvhost_ctrl() = default;
+nvhost_ctrl::nvhost_ctrl(Core::System& system, EventInterface& events_interface,
+                         SyncpointManager& syncpoint_manager)
+    : system{system}, events_interface{events_interface}, syncpoint_manager{syncpoint_manager} {}
 nvhost_ctrl::~nvhost_ctrl() = default;
 
 u32 nvhost_ctrl::ioctl(Ioctl command, const std::vector<u8>& input, std::vector<u8>& output) {
@@ -21,12 +30,25 @@ u32 nvhost_ctrl::ioctl(Ioctl command, const std::vector<u8>& input, std::vector<
     switch (static_cast<IoctlCommand>(command.raw)) {
     case IoctlCommand::IocGetConfigCommand:
         return NvOsGetConfigU32(input, output);
+    case IoctlCommand::IocSyncptReadCommand:
+        return IocSyncptRead(input, output);
+    case IoctlCommand::IocSyncptReadMaxCommand:
+        return IocSyncptReadMax(input, output);
+    case IoctlCommand::IocSyncptIncrCommand:
+        return IocSyncptIncr(input, output);
+    case IoctlCommand::IocSyncptWaitCommand:
+    case IoctlCommand::IocSyncptWaitexCommand:
+        return IocSyncptWait(input, output);
     case IoctlCommand::IocCtrlEventWaitCommand:
         return IocCtrlEventWait(input, output, false);
     case IoctlCommand::IocCtrlEventWaitAsyncCommand:
         return IocCtrlEventWait(input, output, true);
     case IoctlCommand::IocCtrlEventRegisterCommand:
         return IocCtrlEventRegister(input, output);
+    case IoctlCommand::IocCtrlEventUnregisterCommand:
+        return IocCtrlEventUnregister(input, output);
+    case IoctlCommand::IocCtrlEventSignalCommand:
+        return IocCtrlEventSignal(input, output);
     }
     UNIMPLEMENTED_MSG("Unimplemented ioctl");
     return 0;
@@ -40,24 +62,200 @@ u32 nvhost_ctrl::NvOsGetConfigU32(const std::vector<u8>& input, std::vector<u8>&
     return 0x30006; // Returns error on production mode
 }
 
+u32 nvhost_ctrl::IocSyncptRead(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocSyncptReadParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    LOG_DEBUG(Service_NVDRV, "called, id={}", params.id);
+
+    if (params.id >= MaxSyncPoints) {
+        return NvResult::BadParameter;
+    }
+
+    params.value = syncpoint_manager.GetSyncpointMin(params.id);
+    std::memcpy(output.data(), &params, sizeof(params));
+    return NvResult::Success;
+}
+
+u32 nvhost_ctrl::IocSyncptReadMax(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocSyncptReadMaxParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    LOG_DEBUG(Service_NVDRV, "called, id={}", params.id);
+
+    if (params.id >= MaxSyncPoints) {
+        return NvResult::BadParameter;
+    }
+
+    params.value = syncpoint_manager.GetSyncpointMax(params.id);
+    std::memcpy(output.data(), &params, sizeof(params));
+    return NvResult::Success;
+}
+
+u32 nvhost_ctrl::IocSyncptIncr(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocSyncptIncrParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    LOG_DEBUG(Service_NVDRV, "called, id={}", params.id);
+
+    if (params.id >= MaxSyncPoints) {
+        return NvResult::BadParameter;
+    }
+
+    syncpoint_manager.IncreaseSyncpoint(params.id, 1);
+    system.GPU().IncrementSyncPoint(params.id);
+    return NvResult::Success;
+}
+
+u32 nvhost_ctrl::IocSyncptWait(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocSyncptWaitexParams params{};
+    std::memcpy(&params, input.data(), std::min(input.size(), sizeof(params)));
+    LOG_DEBUG(Service_NVDRV, "called, id={}, thresh={}, timeout={}", params.id, params.thresh,
+              params.timeout);
+
+    if (params.id >= MaxSyncPoints) {
+        return NvResult::BadParameter;
+    }
+
+    // Blocking waits are not supported, the guest is expected to retry or to use an event wait.
+    params.value = syncpoint_manager.GetSyncpointMin(params.id);
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
+    if (!syncpoint_manager.IsSyncpointExpired(params.id, params.thresh)) {
+        return NvResult::Timeout;
+    }
+    return NvResult::Success;
+}
+
 u32 nvhost_ctrl::IocCtrlEventWait(const std::vector<u8>& input, std::vector<u8>& output,
                                   bool is_async) {
     IocCtrlEventWaitParams params{};
     std::memcpy(&params, input.data(), sizeof(params));
-    LOG_WARNING(Service_NVDRV,
-                "(STUBBED) called, syncpt_id={}, threshold={}, timeout={}, is_async={}",
-                params.syncpt_id, params.threshold, params.timeout, is_async);
+    LOG_DEBUG(Service_NVDRV, "called, syncpt_id={}, threshold={}, timeout={}, is_async={}",
+              params.syncpt_id, params.threshold, params.timeout, is_async);
+
+    if (params.syncpt_id >= MaxSyncPoints) {
+        return NvResult::BadParameter;
+    }
+
+    auto& gpu = system.GPU();
+    if (!gpu.IsAsync()) {
+        // Submissions have already been executed by the time the ioctl that pushed them returns,
+        // any syncpoint that is still pending is never going to be reached.
+        params.value = syncpoint_manager.GetSyncpointMin(params.syncpt_id);
+        std::memcpy(output.data(), &params, sizeof(params));
+        return NvResult::Success;
+    }
+
+    // Hold the GPU syncpoint lock so the syncpoint can't be reached between the check and the
+    // registration of the interrupt.
+    const auto lock = gpu.LockSync();
+
+    if (syncpoint_manager.IsSyncpointExpired(params.syncpt_id, params.threshold)) {
+        params.value = syncpoint_manager.GetSyncpointMin(params.syncpt_id);
+        std::memcpy(output.data(), &params, sizeof(params));
+        return NvResult::Success;
+    }
+
+    if (params.timeout == 0) {
+        std::memcpy(output.data(), &params, sizeof(params));
+        return NvResult::Timeout;
+    }
+
+    u32 event_id;
+    if (is_async) {
+        event_id = params.value & 0xFF;
+        if (event_id >= MaxNvEvents) {
+            std::memcpy(output.data(), &params, sizeof(params));
+            return NvResult::BadParameter;
+        }
+        if (events_interface.status[event_id] == EventState::Waiting) {
+            // The event is reused for a new wait, drop the interrupt of the previous one
+            gpu.CancelSyncptInterrupt(events_interface.assigned_syncpt[event_id],
+                                      events_interface.assigned_value[event_id]);
+        }
+    } else {
+        const auto free_event = events_interface.GetFreeEvent();
+        if (!free_event) {
+            LOG_ERROR(Service_NVDRV, "No free event to wait on syncpt_id={}", params.syncpt_id);
+            std::memcpy(output.data(), &params, sizeof(params));
+            return NvResult::BadParameter;
+        }
+        event_id = *free_event;
+    }
+
+    events_interface.events[event_id].writable->Clear();
+    events_interface.status[event_id] = EventState::Waiting;
+    events_interface.assigned_syncpt[event_id] = params.syncpt_id;
+    events_interface.assigned_value[event_id] = params.threshold;
+
+    // Tell the guest which event it has to wait on
+    if (is_async) {
+        params.value = params.syncpt_id << 4;
+    } else {
+        params.value = ((params.syncpt_id & 0xFFF) << 16) | 0x10000000;
+    }
+    params.value |= event_id;
+
+    gpu.RegisterSyncptInterrupt(params.syncpt_id, params.threshold);
 
-    // TODO(Subv): Implement actual syncpt waiting.
-    params.value = 0;
     std::memcpy(output.data(), &params, sizeof(params));
-    return 0;
+    return NvResult::Timeout;
 }
 
 u32 nvhost_ctrl::IocCtrlEventRegister(const std::vector<u8>& input, std::vector<u8>& output) {
-    LOG_WARNING(Service_NVDRV, "(STUBBED) called");
-    // TODO(bunnei): Implement this.
-    return 0;
+    IocCtrlEventRegisterParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    const u32 event_id = params.user_event_id & 0xFF;
+    LOG_DEBUG(Service_NVDRV, "called, user_event_id={}", event_id);
+
+    if (event_id >= MaxNvEvents) {
+        return NvResult::BadParameter;
+    }
+
+    events_interface.registered_mask |= 1ULL << event_id;
+    if (events_interface.status[event_id] == EventState::Free) {
+        events_interface.status[event_id] = EventState::Registered;
+    }
+    return NvResult::Success;
+}
+
+u32 nvhost_ctrl::IocCtrlEventUnregister(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocCtrlEventUnregisterParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    const u32 event_id = params.user_event_id & 0xFF;
+    LOG_DEBUG(Service_NVDRV, "called, user_event_id={}", event_id);
+
+    if (event_id >= MaxNvEvents) {
+        return NvResult::BadParameter;
+    }
+
+    events_interface.registered_mask &= ~(1ULL << event_id);
+    if (events_interface.status[event_id] == EventState::Waiting) {
+        auto& gpu = system.GPU();
+        const auto lock = gpu.LockSync();
+        gpu.CancelSyncptInterrupt(events_interface.assigned_syncpt[event_id],
+                                  events_interface.assigned_value[event_id]);
+    }
+    events_interface.status[event_id] = EventState::Free;
+    return NvResult::Success;
+}
+
+u32 nvhost_ctrl::IocCtrlEventSignal(const std::vector<u8>& input, std::vector<u8>& output) {
+    IocCtrlEventSignalParams params{};
+    std::memcpy(&params, input.data(), sizeof(params));
+    const u32 event_id = params.user_event_id & 0xFF;
+    LOG_DEBUG(Service_NVDRV, "called, user_event_id={}", event_id);
+
+    if (event_id >= MaxNvEvents) {
+        return NvResult::BadParameter;
+    }
+
+    if (events_interface.status[event_id] == EventState::Waiting) {
+        auto& gpu = system.GPU();
+        const auto lock = gpu.LockSync();
+        gpu.CancelSyncptInterrupt(events_interface.assigned_syncpt[event_id],
+                                  events_interface.assigned_value[event_id]);
+    }
+    events_interface.LiberateEvent(event_id);
+    events_interface.events[event_id].writable->Signal();
+    return NvResult::Success;
 }
 
 } // namespace Service::Nvidia::Devices
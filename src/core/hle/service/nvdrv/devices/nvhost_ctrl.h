@@ -9,11 +9,21 @@
 #include "common/common_types.h"
 #include "core/hle/service/nvdrv/devices/nvdevice.h"
 
+namespace Core {
+class System;
+}
+
+namespace Service::Nvidia {
+struct EventInterface;
+class SyncpointManager;
+} // namespace Service::Nvidia
+
 namespace Service::Nvidia::Devices {
 
 class nvhost_ctrl final : public nvdevice {
 public:
-    nvhost_ctrl();
+    explicit nvhost_ctrl(Core::System& system, EventInterface& events_interface,
+                         SyncpointManager& syncpoint_manager);
     ~nvhost_ctrl() override;
 
     u32 ioctl(Ioctl command, const std::vector<u8>& input, std::vector<u8>& output) override;
@@ -132,9 +142,25 @@ private:
 
     u32 NvOsGetConfigU32(const std::vector<u8>& input, std::vector<u8>& output);
 
+    u32 IocSyncptRead(const std::vector<u8>& input, std::vector<u8>& output);
+
+    u32 IocSyncptReadMax(const std::vector<u8>& input, std::vector<u8>& output);
+
+    u32 IocSyncptIncr(const std::vector<u8>& input, std::vector<u8>& output);
+
+    u32 IocSyncptWait(const std::vector<u8>& input, std::vector<u8>& output);
+
     u32 IocCtrlEventWait(const std::vector<u8>& input, std::vector<u8>& output, bool is_async);
 
     u32 IocCtrlEventRegister(const std::vector<u8>& input, std::vector<u8>& output);
+
+    u32 IocCtrlEventUnregister(const std::vector<u8>& input, std::vector<u8>& output);
+
+    u32 IocCtrlEventSignal(const std::vector<u8>& input, std::vector<u8>& output);
+
+    Core::System& system;
+    EventInterface& events_interface;
+    SyncpointManager& syncpoint_manager;
 };
 
 } // namespace Service::Nvidia::Devices
@@ -10,6 +10,15 @@
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/hle/service/nvdrv/devices/nvdevice.h"
+#include "video_core/dma_pusher.h"
+
+namespace Core {
+class System;
+}
+
+namespace Service::Nvidia {
+class SyncpointManager;
+}
 
 namespace Service::Nvidia::Devices {
 
@@ -20,7 +29,8 @@ constexpr u32 NVGPU_IOCTL_CHANNEL_KICKOFF_PB(0x1b);
 
 class nvhost_gpu final : public nvdevice {
 public:
-    explicit nvhost_gpu(std::shared_ptr<nvmap> nvmap_dev);
+    explicit nvhost_gpu(Core::System& system, std::shared_ptr<nvmap> nvmap_dev,
+                        SyncpointManager& syncpoint_manager);
     ~nvhost_gpu() override;
 
     u32 ioctl(Ioctl command, const std::vector<u8>& input, std::vector<u8>& output) override;
@@ -153,7 +163,13 @@ private:
     struct IoctlSubmitGpfifo {
         u64_le address;     // pointer to gpfifo entry structs
         u32_le num_entries; // number of fence objects being submitted
-        u32_le flags;
+        union {
+            u32_le raw;
+            BitField<0, 1, u32_le> add_wait;      // wait for the fence before executing
+            BitField<1, 1, u32_le> add_increment; // increment the channel syncpoint once done
+            BitField<2, 1, u32_le> new_hw_format; // mostly ignored
+            BitField<8, 1, u32_le> increment;     // fence value holds the guest increments
+        } flags;
         IoctlFence fence_out; // returned new fence object for others to wait on
     };
     static_assert(sizeof(IoctlSubmitGpfifo) == 16 + sizeof(IoctlFence),
@@ -183,7 +199,15 @@ private:
     u32 GetWaitbase(const std::vector<u8>& input, std::vector<u8>& output);
     u32 ChannelSetTimeout(const std::vector<u8>& input, std::vector<u8>& output);
 
+    /// Pushes a submission to the GPU and updates its fence with the value to wait for.
+    void SubmitEntries(Tegra::CommandList&& entries, IoctlSubmitGpfifo& params);
+
+    Core::System& system;
     std::shared_ptr<nvmap> nvmap_dev;
+    SyncpointManager& syncpoint_manager;
+
+    /// Syncpoint incremented by the submissions to this channel
+    IoctlFence channel_fence{};
 };
 
 } // namespace Service::Nvidia::Devices
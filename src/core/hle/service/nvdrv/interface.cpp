@@ -65,14 +65,23 @@ void NVDRV::Initialize(Kernel::HLERequestContext& ctx) {
 
 void NVDRV::QueryEvent(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp{ctx};
-    u32 fd = rp.Pop<u32>();
-    u32 event_id = rp.Pop<u32>();
-    LOG_WARNING(Service_NVDRV, "(STUBBED) called, fd={:X}, event_id={:X}", fd, event_id);
+    const u32 fd = rp.Pop<u32>();
+    // The upper bits hold flags of unknown meaning, only the low byte selects the event
+    const u32 event_id = rp.Pop<u32>() & 0xFF;
+    LOG_DEBUG(Service_NVDRV, "called, fd={:X}, event_id={:X}", fd, event_id);
+
+    if (event_id >= MaxNvEvents) {
+        LOG_ERROR(Service_NVDRV, "Invalid event_id={:X}", event_id);
+        IPC::ResponseBuilder rb{ctx, 3};
+        rb.Push(RESULT_SUCCESS);
+        rb.Push<u32>(NvResult::BadParameter);
+        return;
+    }
 
     IPC::ResponseBuilder rb{ctx, 3, 1};
     rb.Push(RESULT_SUCCESS);
-    rb.PushCopyObjects(query_event.readable);
-    rb.Push<u32>(0);
+    rb.PushCopyObjects(nvdrv->GetEvent(event_id));
+    rb.Push<u32>(NvResult::Success);
 }
 
 void NVDRV::SetClientPID(Kernel::HLERequestContext& ctx) {
@@ -127,12 +136,12 @@ NVDRV::NVDRV(std::shared_ptr<Module> nvdrv, const char* name)
         {13, &NVDRV::FinishInitialize, "FinishInitialize"},
     };
     RegisterHandlers(functions);
-
-    auto& kernel = Core::System::GetInstance().Kernel();
-    query_event = Kernel::WritableEvent::CreateEventPair(kernel, Kernel::ResetType::OneShot,
-                                                         "NVDRV::query_event");
 }
 
 NVDRV::~NVDRV() = default;
 
+void NVDRV::SignalGPUInterruptSyncpt(const u32 syncpoint_id, const u32 value) {
+    nvdrv->SignalSyncpt(syncpoint_id, value);
+}
+
 } // namespace Service::Nvidia
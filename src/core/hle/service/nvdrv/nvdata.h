@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace Service::Nvidia {
+
+/// Number of syncpoints exposed by the Host1x
+constexpr u32 MaxSyncPoints = 192;
+/// Number of events that can be handed out to the guest by nvhost_ctrl
+constexpr u32 MaxNvEvents = 64;
+
+/// Result codes returned by the nvdrv ioctls
+namespace NvResult {
+constexpr u32 Success = 0x0;
+constexpr u32 BadParameter = 0x4;
+constexpr u32 Timeout = 0x5;
+} // namespace NvResult
+
+/// State of each of the events of the nvdrv event interface
+enum class EventState {
+    Free = 0,
+    Registered = 1,
+    Waiting = 2,
+    Busy = 3,
+};
+
+} // namespace Service::Nvidia
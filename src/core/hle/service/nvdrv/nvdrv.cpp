@@ -4,7 +4,11 @@
 
 #include <utility>
 
+#include <fmt/format.h>
+#include "core/core.h"
 #include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/readable_event.h"
+#include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/nvdrv/devices/nvdevice.h"
 #include "core/hle/service/nvdrv/devices/nvdisp_disp0.h"
 #include "core/hle/service/nvdrv/devices/nvhost_as_gpu.h"
@@ -22,8 +26,9 @@
 
 namespace Service::Nvidia {
 
-void InstallInterfaces(SM::ServiceManager& service_manager, NVFlinger::NVFlinger& nvflinger) {
-    auto module_ = std::make_shared<Module>();
+void InstallInterfaces(SM::ServiceManager& service_manager, NVFlinger::NVFlinger& nvflinger,
+                       Core::System& system) {
+    auto module_ = std::make_shared<Module>(system);
     std::make_shared<NVDRV>(module_, "nvdrv")->InstallAsService(service_manager);
     std::make_shared<NVDRV>(module_, "nvdrv:a")->InstallAsService(service_manager);
     std::make_shared<NVDRV>(module_, "nvdrv:s")->InstallAsService(service_manager);
@@ -32,14 +37,36 @@ void InstallInterfaces(SM::ServiceManager& service_manager, NVFlinger::NVFlinger
     nvflinger.SetNVDrvInstance(module_);
 }
 
-Module::Module() {
+std::optional<u32> EventInterface::GetFreeEvent() const {
+    for (u32 event_id = 0; event_id < MaxNvEvents; ++event_id) {
+        if (status[event_id] == EventState::Free) {
+            return event_id;
+        }
+    }
+    return std::nullopt;
+}
+
+void EventInterface::LiberateEvent(u32 event_id) {
+    const bool is_registered = (registered_mask & (1ULL << event_id)) != 0;
+    status[event_id] = is_registered ? EventState::Registered : EventState::Free;
+}
+
+Module::Module(Core::System& system) : syncpoint_manager{system} {
+    auto& kernel = system.Kernel();
+    for (u32 event_id = 0; event_id < MaxNvEvents; ++event_id) {
+        events_interface.events[event_id] = Kernel::WritableEvent::CreateEventPair(
+            kernel, Kernel::ResetType::OneShot, fmt::format("NVDRV::NvEvent_{}", event_id));
+    }
+
     auto nvmap_dev = std::make_shared<Devices::nvmap>();
     devices["/dev/nvhost-as-gpu"] = std::make_shared<Devices::nvhost_as_gpu>(nvmap_dev);
-    devices["/dev/nvhost-gpu"] = std::make_shared<Devices::nvhost_gpu>(nvmap_dev);
+    devices["/dev/nvhost-gpu"] =
+        std::make_shared<Devices::nvhost_gpu>(system, nvmap_dev, syncpoint_manager);
     devices["/dev/nvhost-ctrl-gpu"] = std::make_shared<Devices::nvhost_ctrl_gpu>();
     devices["/dev/nvmap"] = nvmap_dev;
     devices["/dev/nvdisp_disp0"] = std::make_shared<Devices::nvdisp_disp0>(nvmap_dev);
-    devices["/dev/nvhost-ctrl"] = std::make_shared<Devices::nvhost_ctrl>();
+    devices["/dev/nvhost-ctrl"] =
+        std::make_shared<Devices::nvhost_ctrl>(system, events_interface, syncpoint_manager);
     devices["/dev/nvhost-nvdec"] = std::make_shared<Devices::nvhost_nvdec>();
     devices["/dev/nvhost-nvjpg"] = std::make_shared<Devices::nvhost_nvjpg>();
     devices["/dev/nvhost-vic"] = std::make_shared<Devices::nvhost_vic>();
@@ -77,4 +104,21 @@ ResultCode Module::Close(u32 fd) {
     return RESULT_SUCCESS;
 }
 
+void Module::SignalSyncpt(const u32 syncpoint_id, const u32 value) {
+    for (u32 event_id = 0; event_id < MaxNvEvents; ++event_id) {
+        if (events_interface.status[event_id] != EventState::Waiting) {
+            continue;
+        }
+        if (events_interface.assigned_syncpt[event_id] == syncpoint_id &&
+            events_interface.assigned_value[event_id] == value) {
+            events_interface.LiberateEvent(event_id);
+            events_interface.events[event_id].writable->Signal();
+        }
+    }
+}
+
+Kernel::SharedPtr<Kernel::ReadableEvent> Module::GetEvent(const u32 event_id) const {
+    return events_interface.events[event_id].readable;
+}
+
 } // namespace Service::Nvidia
@@ -4,12 +4,21 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
+#include "core/hle/kernel/writable_event.h"
+#include "core/hle/service/nvdrv/nvdata.h"
+#include "core/hle/service/nvdrv/syncpoint_manager.h"
 #include "core/hle/service/service.h"
 
+namespace Core {
+class System;
+}
+
 namespace Service::NVFlinger {
 class NVFlinger;
 }
@@ -27,9 +36,26 @@ struct IoctlFence {
 
 static_assert(sizeof(IoctlFence) == 8, "IoctlFence has wrong size");
 
+/// Events used by nvhost_ctrl to notify the guest that a syncpoint reached a given value.
+struct EventInterface {
+    /// Mask of the events registered by the guest
+    u64 registered_mask{};
+    std::array<Kernel::EventPair, MaxNvEvents> events;
+    std::array<EventState, MaxNvEvents> status{};
+    /// Syncpoint and value each waiting event is waiting for
+    std::array<u32, MaxNvEvents> assigned_syncpt{};
+    std::array<u32, MaxNvEvents> assigned_value{};
+
+    /// Returns the id of an event that is neither in use nor registered by the guest.
+    std::optional<u32> GetFreeEvent() const;
+
+    /// Marks an event as no longer being waited on.
+    void LiberateEvent(u32 event_id);
+};
+
 class Module final {
 public:
-    Module();
+    explicit Module(Core::System& system);
     ~Module();
 
     /// Returns a pointer to one of the available devices, identified by its name.
@@ -48,7 +74,19 @@ public:
     /// Closes a device file descriptor and returns operation success.
     ResultCode Close(u32 fd);
 
+    /// Signals the events that are waiting for the syncpoint to reach the given value.
+    void SignalSyncpt(u32 syncpoint_id, u32 value);
+
+    /// Returns the readable half of one of the nvhost_ctrl events.
+    Kernel::SharedPtr<Kernel::ReadableEvent> GetEvent(u32 event_id) const;
+
 private:
+    /// Manages the maximum values of the syncpoints used by the GPU channels.
+    SyncpointManager syncpoint_manager;
+
+    /// Events handed out to the guest by nvhost_ctrl.
+    EventInterface events_interface;
+
     /// Id to use for the next open file descriptor.
     u32 next_fd = 1;
 
@@ -60,6 +98,7 @@ private:
 };
 
 /// Registers all NVDRV services with the specified service manager.
-void InstallInterfaces(SM::ServiceManager& service_manager, NVFlinger::NVFlinger& nvflinger);
+void InstallInterfaces(SM::ServiceManager& service_manager, NVFlinger::NVFlinger& nvflinger,
+                       Core::System& system);
 
 } // namespace Service::Nvidia
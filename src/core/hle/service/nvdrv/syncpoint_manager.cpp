@@ -0,0 +1,58 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "core/core.h"
+#include "core/hle/service/nvdrv/syncpoint_manager.h"
+#include "video_core/gpu.h"
+
+namespace Service::Nvidia {
+
+namespace {
+/// Returns true if value a is at or after value b, taking wrap around into account.
+constexpr bool IsAtOrAfter(u32 a, u32 b) {
+    return static_cast<s32>(a - b) >= 0;
+}
+} // Anonymous namespace
+
+SyncpointManager::SyncpointManager(Core::System& system) : system{system} {
+    // Syncpoint 0 is never handed out, the guest uses it as an invalid id
+    syncpoints[0].is_reserved = true;
+}
+
+SyncpointManager::~SyncpointManager() = default;
+
+u32 SyncpointManager::AllocateSyncpoint() {
+    for (u32 syncpoint_id = 1; syncpoint_id < MaxSyncPoints; ++syncpoint_id) {
+        if (!syncpoints[syncpoint_id].is_reserved) {
+            syncpoints[syncpoint_id].is_reserved = true;
+            return syncpoint_id;
+        }
+    }
+    UNREACHABLE_MSG("No more available syncpoints!");
+    return 0;
+}
+
+u32 SyncpointManager::GetSyncpointMin(u32 syncpoint_id) const {
+    return system.GPU().GetSyncpointValue(syncpoint_id);
+}
+
+u32 SyncpointManager::GetSyncpointMax(u32 syncpoint_id) const {
+    // The guest can also increment syncpoints from its own command lists, in that case the current
+    // value can overtake the tracked maximum.
+    const u32 min = GetSyncpointMin(syncpoint_id);
+    const u32 max = syncpoints[syncpoint_id].max;
+    return IsAtOrAfter(max, min) ? max : min;
+}
+
+u32 SyncpointManager::IncreaseSyncpoint(u32 syncpoint_id, u32 increments) {
+    syncpoints[syncpoint_id].max = GetSyncpointMax(syncpoint_id) + increments;
+    return syncpoints[syncpoint_id].max;
+}
+
+bool SyncpointManager::IsSyncpointExpired(u32 syncpoint_id, u32 value) const {
+    return IsAtOrAfter(GetSyncpointMin(syncpoint_id), value);
+}
+
+} // namespace Service::Nvidia
@@ -0,0 +1,52 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include "common/common_types.h"
+#include "core/hle/service/nvdrv/nvdata.h"
+
+namespace Core {
+class System;
+}
+
+namespace Service::Nvidia {
+
+/**
+ * Keeps track of the values the syncpoints are expected to reach once all the work submitted to
+ * the GPU has been executed. The current value of a syncpoint is owned by the GPU, which increments
+ * it as it processes the submitted command lists.
+ */
+class SyncpointManager final {
+public:
+    explicit SyncpointManager(Core::System& system);
+    ~SyncpointManager();
+
+    /// Reserves a syncpoint for exclusive use by a channel and returns its id.
+    u32 AllocateSyncpoint();
+
+    /// Returns the current value of the syncpoint, as seen by the GPU.
+    u32 GetSyncpointMin(u32 syncpoint_id) const;
+
+    /// Returns the value the syncpoint will reach once all the queued increments are executed.
+    u32 GetSyncpointMax(u32 syncpoint_id) const;
+
+    /// Queues increments of the syncpoint and returns the value it will reach after them.
+    u32 IncreaseSyncpoint(u32 syncpoint_id, u32 increments);
+
+    /// Returns true if the syncpoint has already reached the given value.
+    bool IsSyncpointExpired(u32 syncpoint_id, u32 value) const;
+
+private:
+    struct Syncpoint {
+        u32 max{};
+        bool is_reserved{};
+    };
+
+    Core::System& system;
+    std::array<Syncpoint, MaxSyncPoints> syncpoints{};
+};
+
+} // namespace Service::Nvidia
@@ -183,7 +183,7 @@ void NVFlinger::Compose() {
         // Search for a queued buffer and acquire it
         auto buffer = buffer_queue.AcquireBuffer();
 
-        MicroProfileFlip();
+        Common::ProfileCapture::Flip();
 
         if (!buffer) {
             auto& system_instance = Core::System::GetInstance();
@@ -32,12 +32,34 @@ void PerfStats::EndSystemFrame() {
 
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
+
+    frame_times.Record(FrameStage::System, frame_end, frame_end - frame_begin);
 }
 
 void PerfStats::EndGameFrame() {
     std::lock_guard lock{object_mutex};
 
+    const auto now = Clock::now();
     game_frames += 1;
+    total_game_frames += 1;
+
+    if (previous_game_frame != Clock::time_point{}) {
+        frame_times.Record(FrameStage::Game, now, now - previous_game_frame);
+    }
+    previous_game_frame = now;
+}
+
+void PerfStats::EndPresentFrame(Clock::time_point submit_time) {
+    std::lock_guard lock{object_mutex};
+
+    const auto now = Clock::now();
+    accumulated_present_latency += now - submit_time;
+    present_frames += 1;
+
+    if (previous_present != Clock::time_point{}) {
+        frame_times.Record(FrameStage::Present, now, now - previous_present);
+    }
+    previous_present = now;
 }
 
 PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us) {
@@ -55,6 +77,11 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     results.frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                         static_cast<double>(system_frames);
     results.emulation_speed = system_us_per_second.count() / 1'000'000.0;
+    results.present_fps = static_cast<double>(present_frames) / interval;
+    if (present_frames > 0) {
+        results.present_latency = duration_cast<DoubleSecs>(accumulated_present_latency).count() /
+                                  static_cast<double>(present_frames);
+    }
 
     // Reset counters
     reset_point = now;
@@ -62,6 +89,8 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames = 0;
+    present_frames = 0;
+    accumulated_present_latency = Clock::duration::zero();
 
     return results;
 }
@@ -73,6 +102,24 @@ double PerfStats::GetLastFrameTimeScale() {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
+u64 PerfStats::GetTotalGameFrames() {
+    std::lock_guard lock{object_mutex};
+
+    return total_game_frames;
+}
+
+u64 PerfStats::GetNumRecordedFrames(FrameStage stage) const {
+    return frame_times.GetNumRecorded(stage);
+}
+
+FrameTimeStats PerfStats::GetFrameTimeStats(FrameStage stage, std::size_t num_frames) const {
+    return frame_times.GetStats(stage, num_frames);
+}
+
+bool PerfStats::WriteFrameTimes(const std::string& path) const {
+    return frame_times.WriteCsv(path);
+}
+
 void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     if (!Settings::values.use_frame_limit) {
         return;
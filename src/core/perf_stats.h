@@ -6,7 +6,9 @@
 
 #include <chrono>
 #include <mutex>
+#include <string>
 #include "common/common_types.h"
+#include "core/frame_time_recorder.h"
 
 namespace Core {
 
@@ -19,6 +21,10 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Frames presented to the host window, in Hz
+    double present_fps;
+    /// Average walltime between the submission of a game frame and its presentation, in seconds
+    double present_latency;
 };
 
 /**
@@ -33,6 +39,12 @@ public:
     void EndSystemFrame();
     void EndGameFrame();
 
+    /**
+     * Records the presentation of a frame to the host window.
+     * @param submit_time Point when the frame was submitted by the emulated GPU.
+     */
+    void EndPresentFrame(Clock::time_point submit_time);
+
     PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
     /**
@@ -41,9 +53,25 @@ public:
      */
     double GetLastFrameTimeScale();
 
+    /// Returns the number of game frames since the emulation started, they are never reset
+    u64 GetTotalGameFrames();
+
+    /// Returns the number of frames of a stage that have had their time recorded
+    u64 GetNumRecordedFrames(FrameStage stage) const;
+
+    /// Returns the frame time statistics of the last num_frames frames of a stage
+    FrameTimeStats GetFrameTimeStats(
+        FrameStage stage, std::size_t num_frames = FrameTimeRecorder::MAX_READABLE_FRAMES) const;
+
+    /// Writes the recorded frame times to a CSV file, returns true on success
+    bool WriteFrameTimes(const std::string& path) const;
+
 private:
     std::mutex object_mutex;
 
+    /// Per-frame timings, they can be read without taking object_mutex
+    FrameTimeRecorder frame_times;
+
     /// Point when the cumulative counters were reset
     Clock::time_point reset_point = Clock::now();
     /// System time when the cumulative counters were reset
@@ -55,6 +83,12 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     u32 game_frames = 0;
+    /// Number of game frames since the emulation started
+    u64 total_game_frames = 0;
+    /// Cumulative number of frames presented to the host window since last reset
+    u32 present_frames = 0;
+    /// Cumulative latency between submission and presentation of the presented frames
+    Clock::duration accumulated_present_latency = Clock::duration::zero();
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
@@ -62,6 +96,10 @@ private:
     Clock::time_point frame_begin = reset_point;
     /// Total visible duration (including frame-limiting, etc.) of the previous system frame
     Clock::duration previous_frame_length = Clock::duration::zero();
+    /// Point when the previous game frame was submitted
+    Clock::time_point previous_game_frame{};
+    /// Point when the previous frame was presented to the host window
+    Clock::time_point previous_present{};
 };
 
 class FrameLimiter {
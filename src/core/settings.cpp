@@ -87,6 +87,7 @@ void LogSettings() {
     LogSetting("System_LanguageIndex", Settings::values.language_index);
     LogSetting("Core_UseCpuJit", Settings::values.use_cpu_jit);
     LogSetting("Core_UseMultiCore", Settings::values.use_multi_core);
+    LogSetting("Renderer_Backend", static_cast<u32>(Settings::values.renderer_backend));
     LogSetting("Renderer_UseResolutionFactor", Settings::values.resolution_factor);
     LogSetting("Renderer_UseFrameLimit", Settings::values.use_frame_limit);
     LogSetting("Renderer_FrameLimit", Settings::values.frame_limit);
@@ -95,6 +96,8 @@ void LogSettings() {
     LogSetting("Renderer_UseAccurateGpuEmulation", Settings::values.use_accurate_gpu_emulation);
     LogSetting("Renderer_UseAsynchronousGpuEmulation",
                Settings::values.use_asynchronous_gpu_emulation);
+    LogSetting("Renderer_UseGpuSwizzle", Settings::values.use_gpu_swizzle);
+    LogSetting("Renderer_PresentMode", static_cast<u32>(Settings::values.present_mode));
     LogSetting("Audio_OutputEngine", Settings::values.sink_id);
     LogSetting("Audio_EnableAudioStretching", Settings::values.enable_audio_stretching);
     LogSetting("Audio_OutputDevice", Settings::values.audio_device_id);
@@ -104,6 +107,7 @@ void LogSettings() {
     LogSetting("Debugging_UseGdbstub", Settings::values.use_gdbstub);
     LogSetting("Debugging_GdbstubPort", Settings::values.gdbstub_port);
     LogSetting("Debugging_ProgramArgs", Settings::values.program_args);
+    LogSetting("Debugging_GpuCapturePath", Settings::values.gpu_capture_path);
 }
 
 } // namespace Settings
@@ -324,6 +324,17 @@ enum class ControllerType {
     LeftJoycon,
 };
 
+enum class RendererBackend {
+    OpenGL = 0,
+    Null = 1,
+};
+
+enum class PresentMode {
+    VSync = 0,    ///< Every frame is presented, rendering waits when the host falls behind
+    Mailbox = 1,  ///< The latest frame is presented at the display rate, others are dropped
+    Uncapped = 2, ///< The latest frame is presented as soon as possible
+};
+
 struct PlayerInput {
     bool connected;
     ControllerType type;
@@ -387,6 +398,7 @@ struct Values {
     std::string sdmc_dir;
 
     // Renderer
+    RendererBackend renderer_backend;
     float resolution_factor;
     bool use_frame_limit;
     u16 frame_limit;
@@ -394,6 +406,8 @@ struct Values {
     bool use_disk_shader_cache;
     bool use_accurate_gpu_emulation;
     bool use_asynchronous_gpu_emulation;
+    bool use_gpu_swizzle;
+    PresentMode present_mode;
     bool force_30fps_mode;
 
     float bg_red;
@@ -416,6 +430,7 @@ struct Values {
     std::string program_args;
     bool dump_exefs;
     bool dump_nso;
+    std::string gpu_capture_path;
 
     // WebService
     bool enable_telemetry;
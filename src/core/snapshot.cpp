@@ -0,0 +1,306 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+#include "common/assert.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/core.h"
+#include "core/core_cpu.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/settings.h"
+#include "core/snapshot.h"
+#include "video_core/gpu.h"
+
+namespace Core {
+
+namespace {
+/// Granularity at which memory is hashed and compressed
+constexpr std::size_t CHUNK_SIZE = 0x10000;
+
+/// Snapshots favour speed over size, higher levels are several times slower
+constexpr s32 COMPRESSION_LEVEL = 1;
+
+/// A region of the address space backed by host memory
+struct HostRegion {
+    VAddr base;
+    u64 size;
+    u8* pointer;
+};
+
+std::vector<HostRegion> GetHostRegions(const Kernel::VMManager& vm_manager) {
+    std::vector<HostRegion> regions;
+    for (auto vma = vm_manager.FindVMA(0); vm_manager.IsValidHandle(vma); ++vma) {
+        const auto& area = vma->second;
+        if (area.type == Kernel::VMAType::AllocatedMemoryBlock) {
+            regions.push_back({area.base, area.size, area.backing_block->data() + area.offset});
+        } else if (area.type == Kernel::VMAType::BackingMemory) {
+            regions.push_back({area.base, area.size, area.backing_memory});
+        }
+    }
+    return regions;
+}
+
+std::size_t GetNumChunks(u64 region_size) {
+    return static_cast<std::size_t>((region_size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+/// Calls func(index) for every index below count, spreading the calls over all host threads.
+template <typename Func>
+void ParallelFor(std::size_t count, Func&& func) {
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (std::size_t index = next++; index < count; index = next++) {
+            func(index);
+        }
+    };
+
+    const std::size_t num_threads =
+        std::min<std::size_t>(std::max(1U, std::thread::hardware_concurrency()), count);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/// Stores the context of the threads running on the CPU cores into their thread objects.
+void SaveRunningContexts(System& system) {
+    for (std::size_t core = 0; core < NUM_CPU_CORES; ++core) {
+        Kernel::Thread* const thread = system.Scheduler(core).GetCurrentThread();
+        if (thread != nullptr) {
+            system.CpuCore(core).ArmInterface().SaveContext(thread->GetContext());
+        }
+    }
+}
+
+bool CanUseSnapshots(System& system) {
+    if (Settings::values.use_multi_core) {
+        LOG_ERROR(Core, "Snapshots are not supported with multicore CPU emulation");
+        return false;
+    }
+    if (system.CurrentProcess() == nullptr) {
+        LOG_ERROR(Core, "There is no process to snapshot");
+        return false;
+    }
+    return true;
+}
+} // Anonymous namespace
+
+Snapshot::Snapshot() = default;
+Snapshot::~Snapshot() = default;
+
+std::unique_ptr<Snapshot> Snapshot::Capture(System& system, const Snapshot* parent) {
+    if (!CanUseSnapshots(system)) {
+        return nullptr;
+    }
+    Kernel::Process* const process = system.CurrentProcess();
+    auto& gpu = system.GPU();
+
+    auto snapshot = std::unique_ptr<Snapshot>(new Snapshot);
+
+    // Get everything the GPU rendered back into guest memory first.
+    const auto regions = GetHostRegions(process->VMManager());
+    for (const auto& region : regions) {
+        gpu.FlushRegion(ToCacheAddr(region.pointer), region.size);
+    }
+    gpu.WaitIdle();
+
+    std::unordered_map<VAddr, const MemoryRegion*> parent_regions;
+    if (parent != nullptr) {
+        for (const auto& region : parent->memory_regions) {
+            parent_regions.emplace(region.base, &region);
+        }
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    snapshot->memory_regions.reserve(regions.size());
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        const std::size_t num_chunks = GetNumChunks(regions[i].size);
+        snapshot->memory_regions.push_back(
+            {regions[i].base, regions[i].size, std::vector<Chunk>(num_chunks)});
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            chunks.emplace_back(i, chunk);
+        }
+    }
+
+    std::atomic<std::size_t> compressed_chunks{0};
+    ParallelFor(chunks.size(), [&](std::size_t index) {
+        const auto [region_index, chunk_index] = chunks[index];
+        const auto& host_region = regions[region_index];
+        auto& region = snapshot->memory_regions[region_index];
+        const u64 offset = chunk_index * CHUNK_SIZE;
+        const std::size_t size = static_cast<std::size_t>(
+            std::min<u64>(CHUNK_SIZE, host_region.size - offset));
+        const u8* const data = host_region.pointer + offset;
+
+        Chunk& chunk = region.chunks[chunk_index];
+        chunk.hash = Common::ComputeHash64(data, size);
+
+        const auto parent_region = parent_regions.find(region.base);
+        if (parent_region != parent_regions.end() && parent_region->second->size == region.size &&
+            parent_region->second->chunks[chunk_index].hash == chunk.hash) {
+            chunk.data = parent_region->second->chunks[chunk_index].data;
+            return;
+        }
+
+        chunk.data = std::make_shared<const std::vector<u8>>(
+            Common::Compression::CompressDataZSTD(data, size, COMPRESSION_LEVEL));
+        ++compressed_chunks;
+    });
+
+    SaveRunningContexts(system);
+    for (const auto& thread : system.GlobalScheduler().GetThreadList()) {
+        if (thread->GetOwnerProcess() == process) {
+            snapshot->threads.push_back(
+                {thread->GetThreadID(), thread->GetStatus(), thread->GetContext()});
+        }
+    }
+
+    snapshot->timing = system.CoreTiming().SaveState();
+    snapshot->gpu_registers = gpu.SaveEngineRegisters();
+
+    LOG_INFO(Core, "Captured snapshot of {} threads, compressed {} of {} memory chunks",
+             snapshot->threads.size(), compressed_chunks.load(), chunks.size());
+    return snapshot;
+}
+
+bool Snapshot::Restore(System& system) const {
+    if (!CanUseSnapshots(system)) {
+        return false;
+    }
+    Kernel::Process* const process = system.CurrentProcess();
+    auto& gpu = system.GPU();
+
+    // Check that the snapshot still fits the process before touching anything.
+    const auto regions = GetHostRegions(process->VMManager());
+    const bool same_layout = std::equal(
+        regions.begin(), regions.end(), memory_regions.begin(), memory_regions.end(),
+        [](const HostRegion& current, const MemoryRegion& saved) {
+            return current.base == saved.base && current.size == saved.size;
+        });
+    if (!same_layout) {
+        LOG_ERROR(Core, "The memory layout of the process changed since the snapshot was taken");
+        return false;
+    }
+
+    std::unordered_map<u64, Kernel::Thread*> current_threads;
+    for (const auto& thread : system.GlobalScheduler().GetThreadList()) {
+        if (thread->GetOwnerProcess() == process) {
+            current_threads.emplace(thread->GetThreadID(), thread.get());
+        }
+    }
+    const bool same_threads =
+        current_threads.size() == threads.size() &&
+        std::all_of(threads.begin(), threads.end(), [&current_threads](const ThreadState& saved) {
+            return current_threads.count(saved.thread_id) != 0;
+        });
+    if (!same_threads) {
+        LOG_ERROR(Core, "The threads of the process changed since the snapshot was taken");
+        return false;
+    }
+    // Only the contexts are restored, a thread waiting on something else can't be resumed.
+    for (const ThreadState& saved : threads) {
+        const Kernel::Thread* const thread = current_threads.at(saved.thread_id);
+        if (thread->GetStatus() != saved.status) {
+            LOG_ERROR(Core, "Thread {} ({}) changed status from {} to {}", saved.thread_id,
+                      thread->GetName(), static_cast<u32>(saved.status),
+                      static_cast<u32>(thread->GetStatus()));
+            return false;
+        }
+    }
+
+    // Get everything the GPU rendered back into guest memory, so the hashes below see it and the
+    // chunks it modified are restored. The GPU must not be reading memory while it's replaced.
+    for (const auto& region : regions) {
+        gpu.FlushRegion(ToCacheAddr(region.pointer), region.size);
+    }
+    gpu.WaitIdle();
+
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    for (std::size_t i = 0; i < memory_regions.size(); ++i) {
+        for (std::size_t chunk = 0; chunk < memory_regions[i].chunks.size(); ++chunk) {
+            chunks.emplace_back(i, chunk);
+        }
+    }
+
+    std::vector<u8> restored_chunks(chunks.size());
+    ParallelFor(chunks.size(), [&](std::size_t index) {
+        const auto [region_index, chunk_index] = chunks[index];
+        const auto& host_region = regions[region_index];
+        const Chunk& chunk = memory_regions[region_index].chunks[chunk_index];
+        const u64 offset = chunk_index * CHUNK_SIZE;
+        const std::size_t size = static_cast<std::size_t>(
+            std::min<u64>(CHUNK_SIZE, host_region.size - offset));
+        u8* const data = host_region.pointer + offset;
+
+        if (Common::ComputeHash64(data, size) == chunk.hash) {
+            return;
+        }
+
+        const auto decompressed = Common::Compression::DecompressDataZSTD(*chunk.data);
+        ASSERT(decompressed.size() == size);
+        std::memcpy(data, decompressed.data(), size);
+        restored_chunks[index] = 1;
+    });
+
+    std::size_t num_restored = 0;
+    for (std::size_t index = 0; index < chunks.size(); ++index) {
+        if (!restored_chunks[index]) {
+            continue;
+        }
+        const auto [region_index, chunk_index] = chunks[index];
+        const auto& host_region = regions[region_index];
+        const u64 offset = chunk_index * CHUNK_SIZE;
+        gpu.InvalidateRegion(ToCacheAddr(host_region.pointer + offset),
+                             std::min<u64>(CHUNK_SIZE, host_region.size - offset));
+        ++num_restored;
+    }
+    if (num_restored != 0) {
+        system.InvalidateCpuInstructionCaches();
+    }
+
+    for (const ThreadState& saved : threads) {
+        current_threads.at(saved.thread_id)->GetContext() = saved.context;
+    }
+    for (std::size_t core = 0; core < NUM_CPU_CORES; ++core) {
+        Kernel::Thread* const thread = system.Scheduler(core).GetCurrentThread();
+        if (thread != nullptr) {
+            auto& arm_interface = system.CpuCore(core).ArmInterface();
+            arm_interface.LoadContext(thread->GetContext());
+            arm_interface.ClearExclusiveState();
+        }
+    }
+
+    system.CoreTiming().LoadState(timing);
+    gpu.LoadEngineRegisters(gpu_registers);
+
+    LOG_INFO(Core, "Restored snapshot, decompressed {} of {} memory chunks", num_restored,
+             chunks.size());
+    return true;
+}
+
+std::size_t Snapshot::GetCompressedSize() const {
+    std::size_t size = 0;
+    for (const auto& region : memory_regions) {
+        for (const auto& chunk : region.chunks) {
+            size += chunk.data->size();
+        }
+    }
+    return size;
+}
+
+} // namespace Core
@@ -0,0 +1,85 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "common/common_types.h"
+#include "core/arm/arm_interface.h"
+#include "core/core_timing.h"
+
+namespace Kernel {
+enum class ThreadStatus;
+}
+
+namespace Core {
+
+class System;
+
+/**
+ * A snapshot of the emulated machine: the memory of the current process, the CPU context of each
+ * of its threads, the CoreTiming event queue and the registers of the GPU engines.
+ *
+ * Snapshots are meant to quickly get back to a point of a session, for example to reproduce a
+ * performance issue over and over, they are not persisted. Kernel objects and the state of the
+ * HLE services are not part of them, so a snapshot can only be restored while the process still
+ * has the memory layout and the threads it had when it was captured.
+ *
+ * Memory is stored as zstd compressed chunks, which are hashed and compressed in parallel. A
+ * snapshot captured with a parent only compresses the chunks that changed since the parent was
+ * captured and shares the others with it, and restoring a snapshot only decompresses the chunks
+ * that differ from the current contents of memory.
+ */
+class Snapshot {
+public:
+    ~Snapshot();
+
+    /**
+     * Captures the state of the system. Must be called from the emulation thread between two
+     * RunLoop calls, with the CPU cores emulated on that thread.
+     * @param parent Snapshot to share the unchanged memory chunks with, or nullptr.
+     * @returns The snapshot, or nullptr if it couldn't be captured.
+     */
+    static std::unique_ptr<Snapshot> Capture(System& system, const Snapshot* parent);
+
+    /**
+     * Restores the state of the system, with the same requirements as Capture.
+     * @returns True on success, false if the process doesn't match the snapshot anymore, in
+     *          which case nothing was modified.
+     */
+    bool Restore(System& system) const;
+
+    /// Returns the size of the compressed memory, including the chunks shared with other
+    /// snapshots.
+    std::size_t GetCompressedSize() const;
+
+private:
+    struct Chunk {
+        u64 hash;
+        std::shared_ptr<const std::vector<u8>> data;
+    };
+
+    struct MemoryRegion {
+        VAddr base;
+        u64 size;
+        std::vector<Chunk> chunks;
+    };
+
+    struct ThreadState {
+        u64 thread_id;
+        Kernel::ThreadStatus status;
+        ARM_Interface::ThreadContext context;
+    };
+
+    Snapshot();
+
+    std::vector<MemoryRegion> memory_regions;
+    std::vector<ThreadState> threads;
+    Timing::CoreTiming::State timing;
+    std::vector<u8> gpu_registers;
+};
+
+} // namespace Core
@@ -0,0 +1,84 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <string>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+
+namespace Common {
+
+namespace {
+
+int evaluations = 0;
+
+int CountedArgument() {
+    return ++evaluations;
+}
+
+/// Mimics an expensive log argument, like a formatted address or a service name lookup
+std::string ExpensiveArgument(u32 value) {
+    return fmt::format("0x{:016X}", value);
+}
+
+/// Returns the nanoseconds per iteration of a function
+template <typename Func>
+double MeasureNanoseconds(int iterations, Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func(static_cast<u32>(i));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Logging: Filtered messages don't evaluate their arguments", "[common]") {
+    Log::SetGlobalFilter(Log::Filter{Log::Level::Critical});
+
+    evaluations = 0;
+    LOG_ERROR(Common, "{}", CountedArgument());
+    REQUIRE(evaluations == 0);
+
+    // Critical messages pass the filter, the argument has to be evaluated exactly once
+    LOG_CRITICAL(Common, "Expected message from the logging tests {}", CountedArgument());
+    REQUIRE(evaluations == 1);
+
+    Log::SetGlobalFilter(Log::Filter{});
+}
+
+TEST_CASE("Logging: Disabled message cost", "[.][benchmark]") {
+    constexpr int iterations = 1000000;
+    Log::SetGlobalFilter(Log::Filter{Log::Level::Critical});
+
+    // What every LOG_* macro used to expand to, arguments are evaluated before the filter check
+    const double eager = MeasureNanoseconds(iterations, [](u32 value) {
+        Log::FmtLogMessage(Log::Class::Common, Log::Level::Debug, __FILE__, __LINE__, __func__,
+                           "Unmapped read at {}", ExpensiveArgument(value));
+    });
+    const double lazy = MeasureNanoseconds(iterations, [](u32 value) {
+        LOG_DEBUG(Common, "Unmapped read at {}", ExpensiveArgument(value));
+    });
+    // Trace messages are compiled out of non-debug builds by default
+    const double trace = MeasureNanoseconds(iterations, [](u32 value) {
+        LOG_TRACE(Common, "Unmapped read at {}", ExpensiveArgument(value));
+    });
+
+    Log::SetGlobalFilter(Log::Filter{});
+
+    WARN(fmt::format("Filtered at runtime, eager arguments: {:.2f} ns", eager));
+    WARN(fmt::format("Filtered at runtime, lazy arguments: {:.2f} ns", lazy));
+    WARN(fmt::format("{}: {:.2f} ns",
+                     Log::IsCompiledIn(Log::Class::Common, Log::Level::Trace)
+                         ? "Filtered at runtime, LOG_TRACE"
+                         : "Compiled out, LOG_TRACE",
+                     trace));
+    REQUIRE(lazy < eager);
+}
+
+} // namespace Common
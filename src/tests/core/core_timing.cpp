@@ -245,3 +245,36 @@ TEST_CASE("CoreTiming[ChainScheduling]", "[core]") {
     REQUIRE(0 == reschedules);
     REQUIRE(MAX_SLICE_LENGTH == core_timing.GetDowncount());
 }
+
+TEST_CASE("CoreTiming[SaveLoadState]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    Core::Timing::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+    Core::Timing::EventType* cb_b = core_timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+    Core::Timing::EventType* cb_c = core_timing.RegisterEvent("callbackC", CallbackTemplate<2>);
+    Core::Timing::EventType* cb_d = core_timing.RegisterEvent("callbackD", CallbackTemplate<3>);
+
+    // Enter slice 0
+    core_timing.Advance();
+
+    core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+    core_timing.ScheduleEvent(500, cb_b, CB_IDS[1]);
+    core_timing.ScheduleEvent(800, cb_c, CB_IDS[2]);
+    AdvanceAndCheck(core_timing, 0, 400);
+
+    const u64 ticks = core_timing.GetTicks();
+    const auto state = core_timing.SaveState();
+
+    // Diverge from the saved timeline, these changes must be discarded
+    AdvanceAndCheck(core_timing, 1, 300);
+    core_timing.ScheduleEvent(50, cb_d, CB_IDS[3]);
+    core_timing.ScheduleEventThreadsafe(60, cb_d, CB_IDS[3]);
+
+    core_timing.LoadState(state);
+    REQUIRE(ticks == core_timing.GetTicks());
+    REQUIRE(400 == core_timing.GetDowncount());
+
+    AdvanceAndCheck(core_timing, 1, 300);
+    AdvanceAndCheck(core_timing, 2, MAX_SLICE_LENGTH);
+}
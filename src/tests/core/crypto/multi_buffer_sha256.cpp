@@ -0,0 +1,70 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <string>
+#include <catch2/catch.hpp>
+#include "common/hex_util.h"
+#include "core/crypto/multi_buffer_sha256.h"
+
+namespace Core::Crypto {
+
+namespace {
+
+SHA256Hash HashInAllLanes(const std::string& message) {
+    std::array<const u8*, SHA256_LANES> messages;
+    messages.fill(reinterpret_cast<const u8*>(message.data()));
+    std::array<SHA256Hash, SHA256_LANES> hashes{};
+    MultiBufferSHA256(messages, message.size(), hashes);
+    for (const SHA256Hash& hash : hashes) {
+        REQUIRE(hash == hashes[0]);
+    }
+    return hashes[0];
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MultiBufferSHA256[KnownHashes]", "[core][crypto]") {
+    REQUIRE(HashInAllLanes("") ==
+            Common::HexStringToArray<0x20>(
+                "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    REQUIRE(HashInAllLanes("abc") ==
+            Common::HexStringToArray<0x20>(
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    REQUIRE(HashInAllLanes("The quick brown fox jumps over the lazy dog") ==
+            Common::HexStringToArray<0x20>(
+                "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592"));
+    REQUIRE(HashInAllLanes(std::string(SHA256_MAX_SHORT_MESSAGE_SIZE, 'a')) ==
+            Common::HexStringToArray<0x20>(
+                "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318"));
+}
+
+TEST_CASE("MultiBufferSHA256[IndependentLanes]", "[core][crypto]") {
+    const std::array<const char*, SHA256_LANES> expected{
+        "374708fff7719dd5979ec875d56cd2286f6d3cf7ec317a3b25632aab28ec37bb",
+        "cc8cd41cef907c4d216069122c4b89936211361f9050a717a1e37ad1862e952f",
+        "292afde3b64e6636d68f1120d9242f1f85e38ef7bf306e4407c2303eb63791ef",
+        "6399f6d863b08f4652b342c2e1350b4c01e291332d9d84d84b575bf7272897d2",
+        "99558a881f0b229e74335d164eeef7152b7116ecc8bbe8e29c9b673b8ee9d669",
+        "f98a594c16784dbe52b14cf75c8ba4c41c51eb5f6212d866f683499c2d0bc593",
+        "344676f277e8e49a34ac18103730d1627b621a68c87f0f0556a7640f03e4a44a",
+        "d761d406af2a4a5a15f67c924378ed88d1f85c13f1a37fc7366f59789b3bcd65",
+    };
+
+    // Lane i hashes 16 bytes of value i
+    std::array<Key128, SHA256_LANES> keys{};
+    std::array<const u8*, SHA256_LANES> messages{};
+    for (std::size_t i = 0; i < SHA256_LANES; ++i) {
+        keys[i].fill(static_cast<u8>(i));
+        messages[i] = keys[i].data();
+    }
+    std::array<SHA256Hash, SHA256_LANES> hashes{};
+    MultiBufferSHA256(messages, sizeof(Key128), hashes);
+
+    for (std::size_t i = 0; i < SHA256_LANES; ++i) {
+        REQUIRE(hashes[i] == Common::HexStringToArray<0x20>(expected[i]));
+    }
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,110 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/core.h"
+#include "core/file_sys/cheat_engine.h"
+
+namespace FileSys {
+
+namespace {
+constexpr VAddr MAIN_BEGIN = 0x1000;
+constexpr VAddr MAIN_END = 0x2000;
+constexpr VAddr HEAP_BEGIN = 0x3000;
+constexpr VAddr HEAP_END = 0x4000;
+
+std::array<u8, HEAP_END> memory;
+std::size_t num_writes;
+
+u64 Read(u32 width, VAddr address) {
+    u64 value = 0;
+    std::memcpy(&value, memory.data() + address, width);
+    return value;
+}
+
+void Write(u32 width, VAddr address, u64 value) {
+    std::memcpy(memory.data() + address, &value, width);
+    ++num_writes;
+}
+
+void WriteBlock(VAddr address, const void* data, std::size_t size) {
+    std::memcpy(memory.data() + address, data, size);
+    ++num_writes;
+}
+
+u32 Read32(VAddr address) {
+    return static_cast<u32>(Read(sizeof(u32), address));
+}
+
+CheatList ParseCheats(const std::string& text) {
+    const std::vector<u8> data(text.begin(), text.end());
+    auto list = TextCheatParser{}.Parse(Core::System::GetInstance(), data);
+    list.SetMemoryParameters(MAIN_BEGIN, HEAP_BEGIN, MAIN_END, HEAP_END, &Write, &WriteBlock,
+                             &Read);
+    return list;
+}
+} // Anonymous namespace
+
+TEST_CASE("CheatList: Contiguous writes are merged", "[core][file_sys]") {
+    memory.fill(0);
+    num_writes = 0;
+
+    auto list = ParseCheats("[Patch]\n"
+                            "04000000 00000010 11111111\n"
+                            "04000000 00000014 22222222\n"
+                            "02000000 00000018 00003333\n"
+                            "04000000 00000020 44444444\n");
+    list.Execute();
+
+    REQUIRE(Read32(MAIN_BEGIN + 0x10) == 0x11111111);
+    REQUIRE(Read32(MAIN_BEGIN + 0x14) == 0x22222222);
+    REQUIRE(Read32(MAIN_BEGIN + 0x18) == 0x3333);
+    REQUIRE(Read32(MAIN_BEGIN + 0x20) == 0x44444444);
+    REQUIRE(num_writes == 2);
+}
+
+TEST_CASE("CheatList: Conditionals and loops", "[core][file_sys]") {
+    memory.fill(0);
+    num_writes = 0;
+
+    auto list = ParseCheats("[Loop]\n"
+                            "40000000 00000000 00002FFC\n"
+                            "30010000 00000002\n"
+                            "74000000 00000004\n"
+                            "64000000 0000AAAA\n"
+                            "31010000\n"
+                            "40000000 00000000 00000000\n"
+                            "[Conditional]\n"
+                            "14050000 00000010 12345678\n"
+                            "04000000 00000020 00000001\n"
+                            "20000000\n"
+                            "14060000 00000010 12345678\n"
+                            "04000000 00000024 00000002\n"
+                            "20000000\n"
+                            "[Unterminated]\n"
+                            "14050000 00000010 12345678\n"
+                            "04000000 00000028 00000003\n"
+                            "[Unclosed loop]\n"
+                            "30010000 00000002\n"
+                            "04000000 0000002C 00000004\n");
+
+    for (int i = 0; i < 2; ++i) {
+        list.Execute();
+        REQUIRE(Read32(HEAP_BEGIN) == 0xAAAA);
+        REQUIRE(Read32(HEAP_BEGIN + 4) == 0xAAAA);
+        REQUIRE(Read32(HEAP_BEGIN + 8) == 0xAAAA);
+        REQUIRE(Read32(HEAP_BEGIN + 12) == 0);
+        REQUIRE(Read32(MAIN_BEGIN + 0x20) == 0);
+        REQUIRE(Read32(MAIN_BEGIN + 0x24) == 2);
+        REQUIRE(Read32(MAIN_BEGIN + 0x28) == 0);
+        REQUIRE(Read32(MAIN_BEGIN + 0x2C) == 0);
+    }
+    REQUIRE(num_writes == 8);
+}
+
+} // namespace FileSys
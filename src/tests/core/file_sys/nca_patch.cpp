@@ -0,0 +1,77 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/file_sys/nca_patch.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+constexpr u64 IVFC_OFFSET = 0x100;
+constexpr u64 PATCHED_SIZE = 0x2800;
+
+std::vector<u8> MakeData(std::size_t size, u8 seed) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>((i >> 8) * 31 + i * 7 + seed);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("BKTR: Unencrypted reads follow the relocation table", "[core][file_sys]") {
+    const std::vector<u8> base = MakeData(0x2000, 1);
+    const std::vector<u8> patch = MakeData(0x2000, 2);
+
+    // Contiguous entries from the same source are merged, regions as small as a few bytes and
+    // regions reading the same source twice or backwards are allowed.
+    const std::vector<RelocationEntry> entries{
+        {0x0000, 0x0100, 0}, {0x0400, 0x0000, 1}, {0x0700, 0x0300, 1}, {0x0A00, 0x1100, 0},
+        {0x0A05, 0x0800, 1}, {0x1000, 0x0200, 0}, {0x1400, 0x0180, 0}, {0x1800, 0x1000, 1},
+    };
+    std::vector<u8> reference(PATCHED_SIZE);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        const u64 end = i + 1 < entries.size() ? entries[i + 1].address_patch : PATCHED_SIZE;
+        const auto source = entry.from_patch ? patch.begin() + entry.address_source
+                                             : base.begin() + entry.address_source - IVFC_OFFSET;
+        std::copy(source, source + (end - entry.address_patch),
+                  reference.begin() + entry.address_patch);
+    }
+
+    RelocationBlock relocation{};
+    relocation.number_buckets = 2;
+    relocation.size = PATCHED_SIZE;
+    relocation.base_offsets[1] = entries[4].address_patch;
+    std::vector<RelocationBucket> relocation_buckets{
+        {4, entries[4].address_patch, {entries.begin(), entries.begin() + 4}},
+        {4, PATCHED_SIZE, {entries.begin() + 4, entries.end()}},
+    };
+    SubsectionBlock subsection{};
+    subsection.number_buckets = 1;
+    std::vector<SubsectionBucket> subsection_buckets{{1, patch.size(), {{0, {}, 0}}}};
+
+    const BKTR bktr(std::make_shared<VectorVfsFile>(base), std::make_shared<VectorVfsFile>(patch),
+                    relocation, std::move(relocation_buckets), subsection,
+                    std::move(subsection_buckets), false, {}, 0, IVFC_OFFSET, {});
+    REQUIRE(bktr.GetSize() == PATCHED_SIZE);
+
+    for (std::size_t offset = 0; offset <= PATCHED_SIZE + 0x10; offset += 0x7F) {
+        for (const std::size_t length : {0x0, 0x1, 0x10, 0x3FF, 0x1000, 0x2800}) {
+            std::vector<u8> data(length);
+            const std::size_t expected =
+                offset >= PATCHED_SIZE ? 0 : std::min<std::size_t>(length, PATCHED_SIZE - offset);
+            REQUIRE(bktr.Read(data.data(), length, offset) == expected);
+            REQUIRE(std::equal(data.begin(), data.begin() + expected, reference.begin() + offset));
+        }
+    }
+    REQUIRE(bktr.ReadAllBytes() == reference);
+}
+
+} // namespace FileSys
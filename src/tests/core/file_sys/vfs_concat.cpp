@@ -0,0 +1,60 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+/// Checks every read of the file, including the ones past its end, against a flat reference
+void CheckAllReads(const VirtualFile& file, const std::vector<u8>& reference) {
+    REQUIRE(file->GetSize() == reference.size());
+    for (std::size_t offset = 0; offset <= reference.size() + 2; ++offset) {
+        for (std::size_t length = 0; length <= reference.size() + 2; ++length) {
+            std::vector<u8> data(length, 0xCD);
+            const std::size_t expected =
+                offset >= reference.size() ? 0 : std::min(length, reference.size() - offset);
+            REQUIRE(file->Read(data.data(), length, offset) == expected);
+            REQUIRE(std::equal(data.begin(), data.begin() + expected, reference.begin() + offset));
+            REQUIRE(std::all_of(data.begin() + expected, data.end(),
+                                [](u8 value) { return value == 0xCD; }));
+        }
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("ConcatenatedVfsFile: Reads span part boundaries", "[core][file_sys]") {
+    std::vector<u8> reference;
+    std::vector<VirtualFile> parts;
+    for (const std::size_t size : {5, 0, 3, 0, 0, 7, 1, 0}) {
+        std::vector<u8> part(size);
+        for (u8& value : part) {
+            value = static_cast<u8>(reference.size() * 7 + 1);
+            reference.push_back(value);
+        }
+        parts.push_back(std::make_shared<VectorVfsFile>(std::move(part)));
+    }
+
+    const auto file = ConcatenatedVfsFile::MakeConcatenatedFile(parts, "concat");
+    REQUIRE(file->GetName() == "concat");
+    CheckAllReads(file, reference);
+}
+
+TEST_CASE("ConcatenatedVfsFile: Gaps are filled", "[core][file_sys]") {
+    std::map<u64, VirtualFile> parts;
+    parts.emplace(2, std::make_shared<VectorVfsFile>(std::vector<u8>{1, 2, 3}));
+    parts.emplace(9, std::make_shared<VectorVfsFile>(std::vector<u8>{4, 5}));
+    parts.emplace(12, std::make_shared<VectorVfsFile>(std::vector<u8>{6}));
+
+    const auto file = ConcatenatedVfsFile::MakeConcatenatedFile(0xFF, parts, "concat");
+    CheckAllReads(file, {0xFF, 0xFF, 1, 2, 3, 0xFF, 0xFF, 0xFF, 0xFF, 4, 5, 0xFF, 6});
+}
+
+} // namespace FileSys
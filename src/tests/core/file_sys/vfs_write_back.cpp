@@ -0,0 +1,165 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/file_sys/vfs_vector.h"
+#include "core/file_sys/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+constexpr char JOURNAL[] = ".yuzu_save_journal";
+constexpr char STAGING[] = ".yuzu_staged";
+
+/// Name of the directory CreateSubdirectory fails to create, to simulate host errors
+std::string failing_directory_name;
+
+/// A writable in-memory directory
+class MemoryDirectory : public VectorVfsDirectory {
+public:
+    explicit MemoryDirectory(std::string name = "") : VectorVfsDirectory({}, {}, std::move(name)) {}
+
+    bool IsWritable() const override {
+        return true;
+    }
+
+    VirtualDir CreateSubdirectory(std::string_view name) override {
+        if (auto dir = GetSubdirectory(name); dir != nullptr) {
+            return dir;
+        }
+        if (name == failing_directory_name) {
+            return nullptr;
+        }
+        auto dir = std::make_shared<MemoryDirectory>(std::string(name));
+        AddDirectory(dir);
+        return dir;
+    }
+
+    VirtualFile CreateFile(std::string_view name) override {
+        if (auto file = GetFile(name); file != nullptr) {
+            return file;
+        }
+        auto file = std::make_shared<VectorVfsFile>(std::vector<u8>{}, std::string(name));
+        AddFile(file);
+        return file;
+    }
+};
+
+void WriteString(const VirtualDir& dir, std::string_view name, std::string_view text) {
+    const auto file = dir->CreateFile(name);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->Resize(text.size()));
+    REQUIRE(file->WriteBytes(std::vector<u8>(text.begin(), text.end())) == text.size());
+}
+
+std::string ReadString(const VirtualDir& dir, std::string_view path) {
+    const auto file = dir->GetFileRelative(path);
+    REQUIRE(file != nullptr);
+    const auto data = file->ReadAllBytes();
+    return std::string(data.begin(), data.end());
+}
+
+bool HasCommitInProgress(const VirtualDir& backing) {
+    return backing->GetFile(JOURNAL) != nullptr || backing->GetSubdirectory(STAGING) != nullptr;
+}
+} // Anonymous namespace
+
+TEST_CASE("WriteBackCache: Changes are held until committed", "[core][file_sys]") {
+    failing_directory_name.clear();
+    const auto backing = std::make_shared<MemoryDirectory>();
+    WriteString(backing, "old", "old");
+    WriteString(backing->CreateSubdirectory("dir"), "doomed", "doomed");
+
+    {
+        const auto cache = std::make_shared<WriteBackCache>(backing);
+        const auto root = cache->OpenRoot();
+        WriteString(root, "old", "new!");
+        WriteString(root->CreateSubdirectory("saves"), "slot0", "slot");
+        REQUIRE(root->DeleteSubdirectoryRecursive("dir"));
+        REQUIRE(root->GetFile("old")->Rename("renamed"));
+
+        // The tree shows the changes while the backing directory is untouched
+        REQUIRE(root->GetFile("old") == nullptr);
+        REQUIRE(ReadString(root, "renamed") == "new!");
+        REQUIRE(ReadString(root, "saves/slot0") == "slot");
+        REQUIRE(root->GetSubdirectory("dir") == nullptr);
+        REQUIRE(ReadString(backing, "old") == "old");
+        REQUIRE(backing->GetFile("renamed") == nullptr);
+        REQUIRE(backing->GetSubdirectory("saves") == nullptr);
+        REQUIRE(backing->GetSubdirectory("dir") != nullptr);
+
+        REQUIRE(cache->Commit());
+        REQUIRE(!cache->HasPendingChanges());
+        REQUIRE(!HasCommitInProgress(backing));
+    }
+
+    const auto cache = std::make_shared<WriteBackCache>(backing);
+    const auto root = cache->OpenRoot();
+    REQUIRE(root->GetFile("old") == nullptr);
+    REQUIRE(ReadString(root, "renamed") == "new!");
+    REQUIRE(ReadString(root, "saves/slot0") == "slot");
+    REQUIRE(root->GetSubdirectory("dir") == nullptr);
+    REQUIRE(root->GetFiles().size() == 1);
+    REQUIRE(root->GetSubdirectories().size() == 1);
+}
+
+TEST_CASE("WriteBackCache: Unpublished commits are rolled back", "[core][file_sys]") {
+    failing_directory_name.clear();
+    const auto backing = std::make_shared<MemoryDirectory>();
+    WriteString(backing, "save", "old");
+    WriteString(backing, JOURNAL, "prepared\nF 0 /save\nX /other\n");
+    WriteString(backing, "other", "other");
+    WriteString(backing->CreateSubdirectory(STAGING), "0", "new");
+
+    const auto cache = std::make_shared<WriteBackCache>(backing);
+    REQUIRE(!HasCommitInProgress(backing));
+    REQUIRE(ReadString(backing, "save") == "old");
+    REQUIRE(ReadString(backing, "other") == "other");
+}
+
+TEST_CASE("WriteBackCache: Published commits are completed", "[core][file_sys]") {
+    failing_directory_name.clear();
+    const auto backing = std::make_shared<MemoryDirectory>();
+    WriteString(backing, "save", "old");
+    WriteString(backing, "gone", "gone");
+    WriteString(backing->CreateSubdirectory("dir"), "stale", "stale");
+    WriteString(backing, JOURNAL, "publish!\nD /dir\nF 0 /dir/new\nX /gone\nF 1 /save\n");
+    const auto staging = backing->CreateSubdirectory(STAGING);
+    WriteString(staging, "0", "fresh");
+    WriteString(staging, "1", "new");
+
+    const auto cache = std::make_shared<WriteBackCache>(backing);
+    REQUIRE(!HasCommitInProgress(backing));
+    REQUIRE(ReadString(backing, "save") == "new");
+    REQUIRE(backing->GetFile("gone") == nullptr);
+    REQUIRE(ReadString(backing, "dir/new") == "fresh");
+    REQUIRE(backing->GetFileRelative("dir/stale") == nullptr);
+}
+
+TEST_CASE("WriteBackCache: Failed commits keep their changes", "[core][file_sys]") {
+    const auto backing = std::make_shared<MemoryDirectory>();
+    const auto cache = std::make_shared<WriteBackCache>(backing);
+    const auto root = cache->OpenRoot();
+    WriteString(root->CreateSubdirectory("saves"), "slot0", "slot");
+
+    // The commit is published but can't be replayed, it must stay pending
+    failing_directory_name = "saves";
+    REQUIRE(!cache->Commit());
+    REQUIRE(cache->HasPendingChanges());
+    REQUIRE(backing->GetFile(JOURNAL) != nullptr);
+    REQUIRE(ReadString(root, "saves/slot0") == "slot");
+    REQUIRE(root->GetFile(JOURNAL) == nullptr);
+
+    failing_directory_name.clear();
+    REQUIRE(cache->Commit());
+    REQUIRE(!cache->HasPendingChanges());
+    REQUIRE(!HasCommitInProgress(backing));
+    REQUIRE(ReadString(backing, "saves/slot0") == "slot");
+}
+
+} // namespace FileSys
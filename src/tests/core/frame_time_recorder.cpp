@@ -0,0 +1,54 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/frame_time_recorder.h"
+
+namespace Core {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("FrameTimeRecorder: Percentiles and stutters", "[core]") {
+    // 96 frames of 16 ms, three of 40 ms and one of 100 ms
+    std::vector<s64> durations_ns(96, 16'000'000);
+    durations_ns.insert(durations_ns.end(), 3, 40'000'000);
+    durations_ns.push_back(100'000'000);
+
+    const FrameTimeStats stats = ComputeFrameTimeStats(durations_ns);
+    REQUIRE(stats.frames == 100);
+    REQUIRE(stats.average == Approx(17.56));
+    REQUIRE(stats.p50 == Approx(16.0));
+    REQUIRE(stats.p95 == Approx(16.0));
+    REQUIRE(stats.p99 == Approx(40.0));
+    REQUIRE(stats.max == Approx(100.0));
+    REQUIRE(stats.stutters == 4);
+
+    REQUIRE(ComputeFrameTimeStats({}).frames == 0);
+}
+
+TEST_CASE("FrameTimeRecorder: Rolling windows", "[core]") {
+    FrameTimeRecorder recorder;
+    const auto start = FrameTimeRecorder::Clock::now();
+    // Fill the ring past its capacity, the oldest frames are the slowest ones
+    for (std::size_t i = 0; i < FrameTimeRecorder::CAPACITY + 10; ++i) {
+        const auto duration = i < 10 ? 50ms : 16ms;
+        recorder.Record(FrameStage::Game, start + i * 16ms, duration);
+    }
+
+    const FrameTimeStats all = recorder.GetStats(FrameStage::Game);
+    REQUIRE(all.frames == FrameTimeRecorder::MAX_READABLE_FRAMES);
+    REQUIRE(all.max == Approx(16.0));
+
+    recorder.Record(FrameStage::Game, start, 32ms);
+    const FrameTimeStats last = recorder.GetStats(FrameStage::Game, 4);
+    REQUIRE(last.frames == 4);
+    REQUIRE(last.max == Approx(32.0));
+    REQUIRE(last.stutters == 0);
+
+    REQUIRE(recorder.GetStats(FrameStage::Present).frames == 0);
+}
+
+} // namespace Core
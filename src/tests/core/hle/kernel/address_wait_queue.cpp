@@ -0,0 +1,157 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/hle/kernel/address_wait_queue.h"
+
+namespace Kernel {
+
+namespace {
+struct Waiter {
+    u32 GetPriority() const {
+        return priority;
+    }
+
+    u32 priority = 0;
+    /// Used by the reference implementation to keep waiters of the same priority in order
+    u64 wait_order = 0;
+    VAddr address = 0;
+    AddressWaitQueue<Waiter>::Node address_wait_node;
+};
+
+/// The waiter scan AddressArbiter used to do, looking at every waiter on every signal.
+Waiter* FindFrontByScan(std::vector<Waiter>& waiters, VAddr address) {
+    std::vector<Waiter*> matches;
+    for (auto& waiter : waiters) {
+        if (waiter.address == address) {
+            matches.push_back(&waiter);
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const Waiter* lhs, const Waiter* rhs) {
+        return std::tie(lhs->priority, lhs->wait_order) < std::tie(rhs->priority, rhs->wait_order);
+    });
+    return matches.empty() ? nullptr : matches.front();
+}
+} // Anonymous namespace
+
+TEST_CASE("AddressWaitQueue: Priority order", "[core][kernel]") {
+    std::vector<Waiter> waiters(7);
+    const std::array<u32, 7> priorities{44, 28, 44, 59, 28, 44, 12};
+    for (std::size_t i = 0; i < waiters.size(); ++i) {
+        waiters[i].priority = priorities[i];
+    }
+
+    AddressWaitQueue<Waiter> queue;
+    for (std::size_t i = 0; i < 6; ++i) {
+        queue.Push(0x1000, waiters[i]);
+    }
+    queue.Push(0x2000, waiters[6]);
+    REQUIRE(queue.Count(0x1000) == 6);
+    REQUIRE(queue.Count(0x2000) == 1);
+    REQUIRE(queue.Count(0x3000) == 0);
+    REQUIRE(queue.Front(0x3000) == nullptr);
+
+    // Highest priority first, then in waiting order.
+    queue.Remove(waiters[2]);
+    const std::array<std::size_t, 5> expected{1, 4, 0, 5, 3};
+    for (const std::size_t index : expected) {
+        Waiter* const front = queue.Front(0x1000);
+        REQUIRE(front == &waiters[index]);
+        queue.Remove(*front);
+        REQUIRE(!queue.IsWaiting(*front));
+    }
+    REQUIRE(queue.Count(0x1000) == 0);
+    REQUIRE(queue.Front(0x1000) == nullptr);
+
+    // A priority change moves the waiter behind the waiters of its new priority.
+    queue.Push(0x2000, waiters[1]);
+    queue.Push(0x2000, waiters[3]);
+    waiters[3].priority = 12;
+    queue.UpdatePriority(waiters[3]);
+    REQUIRE(queue.Count(0x2000) == 3);
+    REQUIRE(queue.Front(0x2000) == &waiters[6]);
+    queue.Remove(waiters[6]);
+    REQUIRE(queue.Front(0x2000) == &waiters[3]);
+}
+
+TEST_CASE("AddressWaitQueue: Many waiters benchmark", "[.][benchmark]") {
+    // Condition variable and semaphore heavy games have dozens of threads waiting on a few
+    // hundred addresses, and signal them thousands of times per frame.
+    constexpr std::size_t NUM_WAITERS = 64;
+    constexpr std::size_t NUM_ADDRESSES = 256;
+    constexpr std::size_t NUM_OPERATIONS = 1000000;
+
+    std::mt19937 rng(42);
+    std::vector<Waiter> waiters(NUM_WAITERS);
+    for (auto& waiter : waiters) {
+        waiter.priority = 28 + rng() % 32;
+    }
+    std::vector<std::pair<std::size_t, VAddr>> operations(NUM_OPERATIONS);
+    for (auto& [waiter, address] : operations) {
+        waiter = rng() % NUM_WAITERS;
+        address = 0x10000000 + (rng() % NUM_ADDRESSES) * 4;
+    }
+
+    // Each operation makes a waiter wait on an address if it isn't waiting yet, then wakes up
+    // the highest priority waiter of the address.
+    const auto run = [&](auto&& wait, auto&& find_front, auto&& wake) {
+        std::vector<Waiter*> woken;
+        woken.reserve(NUM_OPERATIONS);
+        u64 wait_order = 0;
+        for (const auto& [index, address] : operations) {
+            Waiter& waiter = waiters[index];
+            if (waiter.address == 0) {
+                waiter.address = address;
+                waiter.wait_order = wait_order++;
+                wait(waiter);
+            }
+            Waiter* const front = find_front(address);
+            if (front != nullptr) {
+                wake(*front);
+                front->address = 0;
+            }
+            woken.push_back(front);
+        }
+        for (auto& waiter : waiters) {
+            if (waiter.address != 0) {
+                wake(waiter);
+                waiter.address = 0;
+            }
+        }
+        return woken;
+    };
+
+    AddressWaitQueue<Waiter> queue;
+    auto start = std::chrono::steady_clock::now();
+    const auto queue_woken =
+        run([&](Waiter& waiter) { queue.Push(waiter.address, waiter); },
+            [&](VAddr address) { return queue.Front(address); },
+            [&](Waiter& waiter) { queue.Remove(waiter); });
+    const auto queue_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    const auto scan_woken = run([](Waiter&) {},
+                                [&](VAddr address) { return FindFrontByScan(waiters, address); },
+                                [](Waiter&) {});
+    const auto scan_time = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(queue_woken == scan_woken);
+
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    std::printf("AddressWaitQueue: %.1f ns per operation, thread list scan: %.1f ns\n",
+                static_cast<double>(duration_cast<nanoseconds>(queue_time).count()) /
+                    NUM_OPERATIONS,
+                static_cast<double>(duration_cast<nanoseconds>(scan_time).count()) /
+                    NUM_OPERATIONS);
+}
+
+} // namespace Kernel
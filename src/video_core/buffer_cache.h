@@ -0,0 +1,286 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/icl/interval_map.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "video_core/gpu.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace VideoCommon {
+
+/**
+ * Caches guest memory ranges in host buffers, shared by the hardware renderers. CPU writes are
+ * tracked with page granularity, so a write to a cached range only causes the written pages to be
+ * uploaded again the next time the range is used. Blocks that have to grow are copied on the GPU.
+ *
+ * The host buffers are kept within a memory budget by evicting the least recently used blocks in
+ * EvictOverBudget, which backends call before they start uploading the buffers of a draw.
+ *
+ * Backends provide the storage type TBuffer and the handle type TBufferType given to the host API.
+ */
+template <typename TBuffer, typename TBufferType>
+class BufferCache : NonCopyable {
+public:
+    /// Host buffer handle and the offset of the requested range inside of it
+    using BufferInfo = std::pair<TBufferType, u64>;
+
+    static constexpr std::size_t PAGE_BITS = 12;
+    static constexpr std::size_t PAGE_SIZE = std::size_t{1} << PAGE_BITS;
+
+    virtual ~BufferCache() = default;
+
+    /**
+     * Returns a host buffer holding an up to date copy of the given guest memory range. Only the
+     * pages written by the CPU since the range was last used are uploaded.
+     * @param host_ptr Pointer to the guest memory, it must be valid for the whole range.
+     * @param cpu_addr CPU address of the range, used to track CPU writes to it.
+     * @param size Size in bytes of the range.
+     */
+    BufferInfo UploadMemory(const u8* host_ptr, VAddr cpu_addr, std::size_t size) {
+        std::lock_guard lock{mutex};
+
+        Block* block;
+        const auto iter = blocks.find(ToCacheAddr(host_ptr));
+        if (iter == blocks.end()) {
+            block = Register(AllocateBlock(host_ptr, cpu_addr, size));
+        } else if (iter->second->size < size) {
+            block = GrowBlock(*iter->second, size);
+        } else {
+            block = iter->second.get();
+        }
+
+        UploadDirtyPages(*block, size);
+        MarkUsed(*block);
+        return {ToHandle(block->buffer), 0};
+    }
+
+    /// Marks the pages of the cached blocks overlapping the region as written by the CPU
+    void InvalidateRegion(CacheAddr addr, u64 size) {
+        std::lock_guard lock{mutex};
+        if (size == 0) {
+            return;
+        }
+
+        const CacheAddr end = addr + size;
+        const auto interval = BlockInterval::right_open(addr, end);
+        for (auto& pair : boost::make_iterator_range(block_intervals.equal_range(interval))) {
+            for (Block* const block : pair.second) {
+                const CacheAddr block_addr = block->GetCacheAddr();
+                const CacheAddr begin_offset = std::max(addr, block_addr) - block_addr;
+                const CacheAddr end_offset = std::min(end, block_addr + block->size) - block_addr;
+                const std::size_t first_page = begin_offset >> PAGE_BITS;
+                const std::size_t last_page = (end_offset - 1) >> PAGE_BITS;
+                for (std::size_t page = first_page; page <= last_page; ++page) {
+                    MarkPageDirty(*block, page);
+                }
+            }
+        }
+    }
+
+    /// Removes all blocks from the cache
+    void InvalidateAll() {
+        std::lock_guard lock{mutex};
+
+        while (!blocks.empty()) {
+            Unregister(*blocks.begin()->second);
+        }
+    }
+
+    /**
+     * Evicts the least recently used blocks while the cache is over its budget. Blocks returned
+     * by UploadMemory stay in the cache until the next call, so their handles can be bound until
+     * then.
+     * @returns True if any block was evicted, buffers bound from it have to be bound again.
+     */
+    bool EvictOverBudget() {
+        std::lock_guard lock{mutex};
+
+        ++current_tick;
+        bool evicted = false;
+        while (total_size > budget && !lru_blocks.empty()) {
+            Unregister(*lru_blocks.front());
+            evicted = true;
+        }
+        return evicted;
+    }
+
+protected:
+    /**
+     * @param budget Size in bytes of the host buffers the cache tries to stay within. It can be
+     *               exceeded by the blocks used since the last EvictOverBudget call.
+     */
+    explicit BufferCache(VideoCore::RasterizerInterface& rasterizer, std::size_t budget)
+        : rasterizer{rasterizer}, budget{budget} {}
+
+    /// Creates a host buffer of the given size, its contents are undefined
+    virtual TBuffer CreateBuffer(std::size_t size) = 0;
+
+    /// Returns the handle passed to the host API for a buffer
+    virtual TBufferType ToHandle(const TBuffer& buffer) const = 0;
+
+    /// Writes host memory to a buffer
+    virtual void UploadBufferData(const TBuffer& buffer, std::size_t offset, std::size_t size,
+                                  const u8* data) = 0;
+
+    /// Copies data between two buffers without going through the CPU
+    virtual void CopyBufferData(const TBuffer& src, const TBuffer& dst, std::size_t src_offset,
+                                std::size_t dst_offset, std::size_t size) = 0;
+
+    /// Called when a buffer is removed from the cache, backends may delay its destruction
+    virtual void ReleaseBuffer(TBuffer buffer) {}
+
+private:
+    struct Block {
+        CacheAddr GetCacheAddr() const {
+            return ToCacheAddr(host_ptr);
+        }
+
+        const u8* host_ptr{};
+        VAddr cpu_addr{};
+        std::size_t size{};
+        TBuffer buffer{};
+
+        std::vector<bool> dirty_pages; ///< Pages that have to be uploaded before the next use
+        std::size_t num_dirty_pages{};
+
+        u64 last_use{}; ///< Value of current_tick when the block was last returned
+        typename std::list<Block*>::iterator lru_iter; ///< Position in lru_blocks
+    };
+
+    using BlockSet = std::set<Block*>;
+    using BlockIntervalMap = boost::icl::interval_map<CacheAddr, BlockSet>;
+    using BlockInterval = typename BlockIntervalMap::interval_type;
+
+    static std::size_t GetNumPages(std::size_t size) {
+        return (size + PAGE_SIZE - 1) >> PAGE_BITS;
+    }
+
+    static void MarkPageDirty(Block& block, std::size_t page) {
+        if (!block.dirty_pages[page]) {
+            block.dirty_pages[page] = true;
+            ++block.num_dirty_pages;
+        }
+    }
+
+    /// Creates a block for a range, all of its pages start dirty
+    std::unique_ptr<Block> AllocateBlock(const u8* host_ptr, VAddr cpu_addr, std::size_t size) {
+        auto block = std::make_unique<Block>();
+        block->host_ptr = host_ptr;
+        block->cpu_addr = cpu_addr;
+        block->size = size;
+        block->buffer = CreateBuffer(size);
+        block->dirty_pages.assign(GetNumPages(size), true);
+        block->num_dirty_pages = block->dirty_pages.size();
+        return block;
+    }
+
+    /// Replaces a block with a bigger one, the contents of the old block are copied on the GPU
+    Block* GrowBlock(Block& old_block, std::size_t size) {
+        auto block = AllocateBlock(old_block.host_ptr, old_block.cpu_addr, size);
+        CopyBufferData(old_block.buffer, block->buffer, 0, 0, old_block.size);
+
+        // Pages fully covered by the old block keep their state, a trailing partial page was only
+        // partially copied and stays dirty.
+        const std::size_t num_full_pages = old_block.size >> PAGE_BITS;
+        for (std::size_t page = 0; page < num_full_pages; ++page) {
+            if (!old_block.dirty_pages[page]) {
+                block->dirty_pages[page] = false;
+                --block->num_dirty_pages;
+            }
+        }
+
+        Unregister(old_block);
+        return Register(std::move(block));
+    }
+
+    /// Uploads the dirty pages in the first size bytes of a block
+    void UploadDirtyPages(Block& block, std::size_t size) {
+        if (block.num_dirty_pages == 0) {
+            return;
+        }
+
+        // Upload contiguous dirty pages with a single transfer
+        const std::size_t num_pages = GetNumPages(size);
+        std::size_t page = 0;
+        while (page < num_pages) {
+            if (!block.dirty_pages[page]) {
+                ++page;
+                continue;
+            }
+            const std::size_t first_page = page;
+            for (; page < num_pages && block.dirty_pages[page]; ++page) {
+                block.dirty_pages[page] = false;
+                --block.num_dirty_pages;
+            }
+            const std::size_t offset = first_page << PAGE_BITS;
+            const std::size_t end = std::min(page << PAGE_BITS, block.size);
+            UploadBufferData(block.buffer, offset, end - offset, block.host_ptr + offset);
+        }
+    }
+
+    /// Moves a block to the back of the eviction order
+    void MarkUsed(Block& block) {
+        block.last_use = current_tick;
+        lru_blocks.splice(lru_blocks.end(), lru_blocks, block.lru_iter);
+    }
+
+    Block* Register(std::unique_ptr<Block> block) {
+        Block* const raw_block = block.get();
+        const CacheAddr cache_addr = raw_block->GetCacheAddr();
+        ASSERT(blocks.find(cache_addr) == blocks.end());
+
+        raw_block->last_use = current_tick;
+        raw_block->lru_iter = lru_blocks.insert(lru_blocks.end(), raw_block);
+        total_size += raw_block->size;
+        block_intervals.add({GetInterval(*raw_block), BlockSet{raw_block}});
+        rasterizer.UpdatePagesCachedCount(raw_block->cpu_addr, raw_block->size, 1);
+        blocks.emplace(cache_addr, std::move(block));
+        return raw_block;
+    }
+
+    void Unregister(Block& block) {
+        rasterizer.UpdatePagesCachedCount(block.cpu_addr, block.size, -1);
+        block_intervals.subtract({GetInterval(block), BlockSet{&block}});
+        lru_blocks.erase(block.lru_iter);
+        total_size -= block.size;
+
+        // Keep the block alive until the backend has taken its buffer
+        const auto iter = blocks.find(block.GetCacheAddr());
+        ASSERT(iter != blocks.end() && iter->second.get() == &block);
+        const std::unique_ptr<Block> owned_block = std::move(iter->second);
+        blocks.erase(iter);
+        ReleaseBuffer(std::move(owned_block->buffer));
+    }
+
+    static BlockInterval GetInterval(const Block& block) {
+        return BlockInterval::right_open(block.GetCacheAddr(), block.GetCacheAddr() + block.size);
+    }
+
+    VideoCore::RasterizerInterface& rasterizer;
+
+    std::unordered_map<CacheAddr, std::unique_ptr<Block>> blocks;
+    BlockIntervalMap block_intervals;
+
+    std::list<Block*> lru_blocks; ///< Registered blocks, least recently used first
+    std::size_t total_size = 0;   ///< Size of the registered blocks
+    std::size_t budget;
+    u64 current_tick = 0;
+    std::recursive_mutex mutex;
+};
+
+} // namespace VideoCommon
@@ -2,9 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/assert.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/hardware_interrupt_manager.h"
 #include "core/memory.h"
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/engines/kepler_compute.h"
@@ -12,6 +16,7 @@
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 
@@ -29,7 +34,8 @@ u32 FramebufferConfig::BytesPerPixel(PixelFormat format) {
     UNREACHABLE();
 }
 
-GPU::GPU(Core::System& system, VideoCore::RendererBase& renderer) : renderer{renderer} {
+GPU::GPU(Core::System& system, VideoCore::RendererBase& renderer, bool is_async)
+    : renderer{renderer}, system{system}, is_async{is_async} {
     auto& rasterizer{renderer.Rasterizer()};
     memory_manager = std::make_unique<Tegra::MemoryManager>(rasterizer);
     dma_pusher = std::make_unique<Tegra::DmaPusher>(*this);
@@ -66,6 +72,131 @@ const DmaPusher& GPU::DmaPusher() const {
     return *dma_pusher;
 }
 
+bool GPU::StartCapture(const std::string& path) {
+    auto recorder = std::make_unique<VideoCommon::GPUCapture::Recorder>(path);
+    if (!recorder->IsOpen()) {
+        return false;
+    }
+    capture_recorder = std::move(recorder);
+    return true;
+}
+
+void GPU::StopCapture() {
+    capture_recorder.reset();
+}
+
+bool GPU::IsCapturing() const {
+    return capture_recorder != nullptr;
+}
+
+template <typename GPUType, typename Func>
+void GPU::ForEachRegisterBlock(GPUType& gpu, Func&& func) {
+    func(&gpu.regs, sizeof(gpu.regs));
+    func(&gpu.maxwell_3d->regs, sizeof(gpu.maxwell_3d->regs));
+    func(&gpu.maxwell_3d->state, sizeof(gpu.maxwell_3d->state));
+    func(&gpu.fermi_2d->regs, sizeof(gpu.fermi_2d->regs));
+    func(&gpu.kepler_compute->regs, sizeof(gpu.kepler_compute->regs));
+    func(&gpu.maxwell_dma->regs, sizeof(gpu.maxwell_dma->regs));
+    func(&gpu.kepler_memory->regs, sizeof(gpu.kepler_memory->regs));
+}
+
+std::vector<u8> GPU::SaveEngineRegisters() const {
+    std::vector<u8> data;
+    ForEachRegisterBlock(*this, [&data](const void* block, std::size_t size) {
+        const auto block_data = static_cast<const u8*>(block);
+        data.insert(data.end(), block_data, block_data + size);
+    });
+    return data;
+}
+
+bool GPU::LoadEngineRegisters(const std::vector<u8>& data) {
+    std::size_t total_size = 0;
+    ForEachRegisterBlock(*this, [&total_size](void*, std::size_t size) { total_size += size; });
+    if (data.size() != total_size) {
+        LOG_ERROR(HW_GPU, "Engine register data has size {}, expected {}", data.size(),
+                  total_size);
+        return false;
+    }
+
+    std::size_t offset = 0;
+    ForEachRegisterBlock(*this, [&data, &offset](void* block, std::size_t size) {
+        std::memcpy(block, data.data() + offset, size);
+        offset += size;
+    });
+    maxwell_3d->dirty_flags = {};
+    return true;
+}
+
+void GPU::CaptureCommandList(const Tegra::CommandList& entries) {
+    if (capture_recorder) {
+        capture_recorder->RecordCommandList(*memory_manager, entries);
+    }
+}
+
+void GPU::CaptureSwapBuffers(
+    std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
+    if (capture_recorder) {
+        capture_recorder->RecordSwapBuffers(*memory_manager, framebuffer);
+    }
+}
+
+void GPU::IncrementSyncPoint(const u32 syncpoint_id) {
+    if (syncpoint_id >= Service::Nvidia::MaxSyncPoints) {
+        LOG_ERROR(HW_GPU, "Invalid syncpoint_id={}", syncpoint_id);
+        return;
+    }
+    const u32 value = ++syncpoints[syncpoint_id];
+
+    std::lock_guard lock{sync_mutex};
+    auto& interrupts = syncpt_interrupts[syncpoint_id];
+    auto it = interrupts.begin();
+    while (it != interrupts.end()) {
+        // Compare the difference to take wrap around into account
+        if (static_cast<s32>(value - it->value) >= 0) {
+            TriggerCpuInterrupt(syncpoint_id, it->value);
+            it = interrupts.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+u32 GPU::GetSyncpointValue(const u32 syncpoint_id) const {
+    return syncpoints[syncpoint_id].load();
+}
+
+void GPU::RegisterSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
+    auto& interrupts = syncpt_interrupts[syncpoint_id];
+    const auto it = std::find_if(interrupts.begin(), interrupts.end(),
+                                 [value](const SyncptInterrupt& interrupt) {
+                                     return interrupt.value == value;
+                                 });
+    if (it != interrupts.end()) {
+        ++it->num_waiters;
+        return;
+    }
+    interrupts.push_back({value, 1});
+}
+
+bool GPU::CancelSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
+    auto& interrupts = syncpt_interrupts[syncpoint_id];
+    const auto it = std::find_if(interrupts.begin(), interrupts.end(),
+                                 [value](const SyncptInterrupt& interrupt) {
+                                     return interrupt.value == value;
+                                 });
+    if (it == interrupts.end()) {
+        return false;
+    }
+    if (--it->num_waiters == 0) {
+        interrupts.erase(it);
+    }
+    return true;
+}
+
+void GPU::TriggerCpuInterrupt(const u32 syncpoint_id, const u32 value) const {
+    system.InterruptManager().GPUInterruptSyncpt(syncpoint_id, value);
+}
+
 u32 RenderTargetBytesPerPixel(RenderTargetFormat format) {
     ASSERT(format != RenderTargetFormat::NONE);
 
@@ -147,8 +278,8 @@ enum class BufferMethods {
     RefCnt = 0x14,
     SemaphoreAcquire = 0x1A,
     SemaphoreRelease = 0x1B,
-    Unk70 = 0x1C,
-    Unk74 = 0x1D,
+    FenceValue = 0x1C,
+    FenceAction = 0x1D,
     Unk78 = 0x1E,
     Unk7c = 0x1F,
     Yield = 0x20,
@@ -194,6 +325,10 @@ void GPU::CallPullerMethod(const MethodCall& method_call) {
     case BufferMethods::SemaphoreAddressLow:
     case BufferMethods::SemaphoreSequence:
     case BufferMethods::RefCnt:
+    case BufferMethods::FenceValue:
+        break;
+    case BufferMethods::FenceAction:
+        ProcessFenceActionMethod();
         break;
     case BufferMethods::SemaphoreTrigger: {
         ProcessSemaphoreTriggerMethod();
@@ -270,6 +405,23 @@ void GPU::ProcessBindMethod(const MethodCall& method_call) {
     bound_engines[method_call.subchannel] = static_cast<EngineID>(method_call.argument);
 }
 
+void GPU::ProcessFenceActionMethod() {
+    switch (regs.fence_action.op) {
+    case FenceOperation::Acquire:
+        // Syncpoints are only incremented by this GPU, which executes the command lists in order,
+        // so waiting on one would never make progress.
+        LOG_DEBUG(HW_GPU, "Ignoring fence acquire, syncpoint_id={}, value={}",
+                  regs.fence_action.syncpoint_id.Value(), regs.fence_value);
+        break;
+    case FenceOperation::Increment:
+        IncrementSyncPoint(regs.fence_action.syncpoint_id);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented operation {}",
+                          static_cast<u32>(regs.fence_action.op.Value()));
+    }
+}
+
 void GPU::ProcessSemaphoreTriggerMethod() {
     const auto semaphoreOperationMask = 0xF;
     const auto op =
@@ -5,8 +5,14 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include "common/bit_field.h"
 #include "common/common_types.h"
+#include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/nvflinger/buffer_queue.h"
 #include "video_core/dma_pusher.h"
 
@@ -23,6 +29,10 @@ namespace VideoCore {
 class RendererBase;
 } // namespace VideoCore
 
+namespace VideoCommon::GPUCapture {
+class Recorder;
+} // namespace VideoCommon::GPUCapture
+
 namespace Tegra {
 
 enum class RenderTargetFormat : u32 {
@@ -127,7 +137,7 @@ class MemoryManager;
 
 class GPU {
 public:
-    explicit GPU(Core::System& system, VideoCore::RendererBase& renderer);
+    explicit GPU(Core::System& system, VideoCore::RendererBase& renderer, bool is_async);
 
     virtual ~GPU();
 
@@ -167,6 +177,60 @@ public:
     /// Returns a const reference to the GPU DMA pusher.
     const Tegra::DmaPusher& DmaPusher() const;
 
+    /**
+     * Starts recording every submitted command list, along with the guest memory reachable from
+     * the GPU, to a capture file that can be replayed with yuzu-gpu-replay.
+     * @param path Path of the capture file to create.
+     * @returns True if the capture was started.
+     */
+    bool StartCapture(const std::string& path);
+
+    /// Stops the current command stream capture, if any, and finishes writing its file.
+    void StopCapture();
+
+    /// Returns true if the submitted command stream is being captured.
+    bool IsCapturing() const;
+
+    /// Returns the raw registers of the puller and of all of the engines, used by snapshots.
+    std::vector<u8> SaveEngineRegisters() const;
+
+    /**
+     * Restores registers returned by SaveEngineRegisters, marking all of the 3D state as dirty.
+     * The GPU has to be idle.
+     * @returns True if the registers were restored, false if the data has the wrong size.
+     */
+    bool LoadEngineRegisters(const std::vector<u8>& data);
+
+    /// Increments a syncpoint, notifying the CPU about any interrupt registered for its new value.
+    void IncrementSyncPoint(u32 syncpoint_id);
+
+    /// Returns the current value of a syncpoint.
+    u32 GetSyncpointValue(u32 syncpoint_id) const;
+
+    /// Requests a CPU interrupt once the syncpoint reaches the given value. Requests for the same
+    /// value are counted, a single interrupt is raised for all of them.
+    void RegisterSyncptInterrupt(u32 syncpoint_id, u32 value);
+
+    /// Cancels one request previously made with RegisterSyncptInterrupt, the interrupt is only
+    /// dropped once all the requests for its value are cancelled.
+    bool CancelSyncptInterrupt(u32 syncpoint_id, u32 value);
+
+    /// Locks the syncpoint interrupt list, callers checking a syncpoint value before registering
+    /// an interrupt must hold it to not miss the increment.
+    std::unique_lock<std::mutex> LockSync() {
+        return std::unique_lock{sync_mutex};
+    }
+
+    /// Returns true if the GPU runs on its own thread.
+    bool IsAsync() const {
+        return is_async;
+    }
+
+    enum class FenceOperation : u32 {
+        Acquire = 0,
+        Increment = 1,
+    };
+
     struct Regs {
         static constexpr size_t NUM_REGS = 0x100;
 
@@ -194,7 +258,13 @@ public:
 
                 u32 semaphore_acquire;
                 u32 semaphore_release;
-                INSERT_PADDING_WORDS(0xE4);
+                u32 fence_value;
+                union {
+                    u32 raw;
+                    BitField<0, 1, FenceOperation> op;
+                    BitField<8, 24, u32> syncpoint_id;
+                } fence_action;
+                INSERT_PADDING_WORDS(0xE2);
 
                 // Puller state
                 u32 acquire_mode;
@@ -215,6 +285,10 @@ public:
     /// Push GPU command entries to be processed
     virtual void PushGPUEntries(Tegra::CommandList&& entries) = 0;
 
+    /// Push GPU command entries to be processed, incrementing the syncpoint once all of them have
+    /// been executed
+    virtual void PushGPUEntriesAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id) = 0;
+
     /// Swap buffers (render frame)
     virtual void SwapBuffers(
         std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) = 0;
@@ -228,8 +302,16 @@ public:
     /// Notify rasterizer that any caches of the specified region should be flushed and invalidated
     virtual void FlushAndInvalidateRegion(CacheAddr addr, u64 size) = 0;
 
+    /// Blocks until all of the commands submitted to the GPU have been executed
+    virtual void WaitIdle() = 0;
+
 private:
+    /// Calls func with the address and size of each block of registers stored in snapshots.
+    template <typename GPUType, typename Func>
+    static void ForEachRegisterBlock(GPUType& gpu, Func&& func);
+
     void ProcessBindMethod(const MethodCall& method_call);
+    void ProcessFenceActionMethod();
     void ProcessSemaphoreTriggerMethod();
     void ProcessSemaphoreRelease();
     void ProcessSemaphoreAcquire();
@@ -244,8 +326,19 @@ private:
     bool ExecuteMethodOnEngine(const MethodCall& method_call);
 
 protected:
+    /// Records a submitted command list when a capture is in progress.
+    void CaptureCommandList(const Tegra::CommandList& entries);
+
+    /// Records a frame presentation when a capture is in progress.
+    void CaptureSwapBuffers(
+        std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer);
+
+    /// Notifies the CPU that a syncpoint reached the value of a registered interrupt.
+    void TriggerCpuInterrupt(u32 syncpoint_id, u32 value) const;
+
     std::unique_ptr<Tegra::DmaPusher> dma_pusher;
     VideoCore::RendererBase& renderer;
+    Core::System& system;
 
 private:
     std::unique_ptr<Tegra::MemoryManager> memory_manager;
@@ -262,6 +355,24 @@ private:
     std::unique_ptr<Engines::MaxwellDMA> maxwell_dma;
     /// Inline memory engine
     std::unique_ptr<Engines::KeplerMemory> kepler_memory;
+
+    /// Command stream recorder, only present while a capture is in progress
+    std::unique_ptr<VideoCommon::GPUCapture::Recorder> capture_recorder;
+
+    std::array<std::atomic<u32>, Service::Nvidia::MaxSyncPoints> syncpoints{};
+
+    /// An interrupt requested for a syncpoint value, shared by every event waiting on it
+    struct SyncptInterrupt {
+        u32 value;
+        u32 num_waiters;
+    };
+
+    /// Values of each syncpoint the CPU has to be notified about
+    std::array<std::list<SyncptInterrupt>, Service::Nvidia::MaxSyncPoints> syncpt_interrupts;
+
+    std::mutex sync_mutex;
+
+    const bool is_async;
 };
 
 #define ASSERT_REG_POSITION(field_name, position)                                                  \
@@ -274,6 +385,8 @@ ASSERT_REG_POSITION(semaphore_trigger, 0x7);
 ASSERT_REG_POSITION(reference_count, 0x14);
 ASSERT_REG_POSITION(semaphore_acquire, 0x1A);
 ASSERT_REG_POSITION(semaphore_release, 0x1B);
+ASSERT_REG_POSITION(fence_value, 0x1C);
+ASSERT_REG_POSITION(fence_action, 0x1D);
 
 ASSERT_REG_POSITION(acquire_mode, 0x100);
 ASSERT_REG_POSITION(acquire_source, 0x101);
@@ -9,20 +9,27 @@
 namespace VideoCommon {
 
 GPUAsynch::GPUAsynch(Core::System& system, VideoCore::RendererBase& renderer)
-    : GPU(system, renderer), gpu_thread{system} {}
+    : GPU(system, renderer, true), gpu_thread{system} {}
 
 GPUAsynch::~GPUAsynch() = default;
 
 void GPUAsynch::Start() {
-    gpu_thread.StartThread(renderer, *dma_pusher);
+    gpu_thread.StartThread(renderer, *this, *dma_pusher);
 }
 
 void GPUAsynch::PushGPUEntries(Tegra::CommandList&& entries) {
+    CaptureCommandList(entries);
     gpu_thread.SubmitList(std::move(entries));
 }
 
+void GPUAsynch::PushGPUEntriesAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id) {
+    CaptureCommandList(entries);
+    gpu_thread.SubmitListAndIncrement(std::move(entries), syncpoint_id);
+}
+
 void GPUAsynch::SwapBuffers(
     std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
+    CaptureSwapBuffers(framebuffer);
     gpu_thread.SwapBuffers(std::move(framebuffer));
 }
 
@@ -38,4 +45,8 @@ void GPUAsynch::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
     gpu_thread.FlushAndInvalidateRegion(addr, size);
 }
 
+void GPUAsynch::WaitIdle() {
+    gpu_thread.WaitIdle();
+}
+
 } // namespace VideoCommon
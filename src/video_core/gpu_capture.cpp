@@ -0,0 +1,233 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/memory.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+
+namespace VideoCommon::GPUCapture {
+
+/// Size of the uncompressed blocks, big enough to give zstd a good amount of context
+constexpr std::size_t BLOCK_SIZE = 4 * 1024 * 1024;
+
+Recorder::Recorder(const std::string& path) : file{path, "wb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture file {}", path);
+        return;
+    }
+
+    const Header header{Header::ExpectedMagic, Header::ExpectedVersion, 0};
+    file.WriteObject(header);
+    block.reserve(BLOCK_SIZE);
+
+    LOG_INFO(HW_GPU, "Started GPU capture to {}", path);
+}
+
+Recorder::~Recorder() {
+    std::lock_guard lock{mutex};
+    FlushBlock();
+}
+
+void Recorder::RecordCommandList(const Tegra::MemoryManager& memory_manager,
+                                 const Tegra::CommandList& entries) {
+    std::lock_guard lock{mutex};
+    SyncMappings(memory_manager);
+    SyncMemory();
+    Write(RecordType::CommandList, entries.data(), entries.size() * sizeof(entries[0]));
+}
+
+void Recorder::RecordSwapBuffers(
+    const Tegra::MemoryManager& memory_manager,
+    std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
+    std::lock_guard lock{mutex};
+    SyncMappings(memory_manager);
+    SyncMemory();
+
+    SwapBuffersRecord record{};
+    if (framebuffer) {
+        record.has_framebuffer = 1;
+        record.framebuffer = framebuffer->get();
+    }
+    Write(RecordType::SwapBuffers, &record, sizeof(record));
+
+    // Frame boundaries are a good place to bound the amount of data lost if emulation crashes.
+    FlushBlock();
+}
+
+void Recorder::SyncMappings(const Tegra::MemoryManager& memory_manager) {
+    std::map<GPUVAddr, MapRegionRecord> current;
+    for (const auto& region : memory_manager.GetMappedRegions()) {
+        current.emplace(region.gpu_addr,
+                        MapRegionRecord{region.gpu_addr, region.cpu_addr, region.size});
+    }
+
+    for (const auto& [gpu_addr, mapping] : mappings) {
+        const auto it = current.find(gpu_addr);
+        if (it != current.end() && it->second.cpu_addr == mapping.cpu_addr &&
+            it->second.size == mapping.size) {
+            continue;
+        }
+        const UnmapRegionRecord record{mapping.gpu_addr, mapping.size};
+        Write(RecordType::UnmapRegion, &record, sizeof(record));
+    }
+
+    for (const auto& [gpu_addr, mapping] : current) {
+        const auto it = mappings.find(gpu_addr);
+        if (it != mappings.end() && it->second.cpu_addr == mapping.cpu_addr &&
+            it->second.size == mapping.size) {
+            continue;
+        }
+        Write(RecordType::MapRegion, &mapping, sizeof(mapping));
+    }
+
+    mappings = std::move(current);
+}
+
+void Recorder::SyncMemory() {
+    for (const auto& [gpu_addr, mapping] : mappings) {
+        const VAddr end{mapping.cpu_addr + mapping.size};
+        for (VAddr cpu_addr = mapping.cpu_addr; cpu_addr < end; cpu_addr += Memory::PAGE_SIZE) {
+            if (!Memory::IsValidVirtualAddress(cpu_addr)) {
+                continue;
+            }
+            const u8* const data{Memory::GetPointer(cpu_addr)};
+
+            const u64 hash{Common::ComputeHash64(data, Memory::PAGE_SIZE)};
+            const auto [it, is_new] = page_hashes.try_emplace(cpu_addr, hash);
+            if (!is_new && it->second == hash) {
+                continue;
+            }
+            it->second = hash;
+
+            const MemoryPageRecord record{cpu_addr};
+            Write(RecordType::MemoryPage, &record, sizeof(record), data, Memory::PAGE_SIZE);
+        }
+    }
+}
+
+void Recorder::Write(RecordType type, const void* data, std::size_t size) {
+    Write(type, data, size, nullptr, 0);
+}
+
+void Recorder::Write(RecordType type, const void* data, std::size_t size, const void* extra_data,
+                     std::size_t extra_size) {
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    const RecordHeader header{type, static_cast<u32>(size + extra_size)};
+    const std::size_t offset{block.size()};
+    block.resize(offset + sizeof(header) + size + extra_size);
+    std::memcpy(block.data() + offset, &header, sizeof(header));
+    std::memcpy(block.data() + offset + sizeof(header), data, size);
+    if (extra_size != 0) {
+        std::memcpy(block.data() + offset + sizeof(header) + size, extra_data, extra_size);
+    }
+
+    if (block.size() >= BLOCK_SIZE) {
+        FlushBlock();
+    }
+}
+
+void Recorder::FlushBlock() {
+    if (block.empty() || !file.IsOpen()) {
+        return;
+    }
+
+    const std::vector<u8> compressed{
+        Common::Compression::CompressDataZSTDDefault(block.data(), block.size())};
+    const BlockHeader header{static_cast<u32>(compressed.size()), static_cast<u32>(block.size())};
+    if (file.WriteObject(header) != 1 ||
+        file.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU capture block, stopping capture");
+        file.Close();
+    }
+    block.clear();
+}
+
+Reader::Reader(const std::string& path) : file{path, "rb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture file {}", path);
+        return;
+    }
+
+    Header header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != Header::ExpectedMagic) {
+        LOG_ERROR(HW_GPU, "{} is not a GPU capture file", path);
+        return;
+    }
+    if (header.version != Header::ExpectedVersion) {
+        LOG_ERROR(HW_GPU, "Unsupported GPU capture version {} (expected {})", header.version,
+                  Header::ExpectedVersion);
+        return;
+    }
+
+    is_valid = true;
+}
+
+Reader::~Reader() = default;
+
+std::optional<Record> Reader::Next() {
+    if (!is_valid) {
+        return {};
+    }
+
+    if (block_offset >= block.size() && !ReadBlock()) {
+        return {};
+    }
+
+    if (block_offset + sizeof(RecordHeader) > block.size()) {
+        LOG_ERROR(HW_GPU, "Truncated GPU capture record header");
+        is_valid = false;
+        return {};
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, block.data() + block_offset, sizeof(header));
+    block_offset += sizeof(header);
+
+    if (block_offset + header.size > block.size()) {
+        LOG_ERROR(HW_GPU, "Truncated GPU capture record payload");
+        is_valid = false;
+        return {};
+    }
+
+    Record record{header.type, {}};
+    record.payload.resize(header.size);
+    std::memcpy(record.payload.data(), block.data() + block_offset, header.size);
+    block_offset += header.size;
+    return record;
+}
+
+bool Reader::ReadBlock() {
+    BlockHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header)) {
+        // End of the capture
+        return false;
+    }
+
+    std::vector<u8> compressed(header.compressed_size);
+    if (file.ReadBytes(compressed.data(), compressed.size()) != compressed.size()) {
+        LOG_ERROR(HW_GPU, "Truncated GPU capture block");
+        return false;
+    }
+
+    block = Common::Compression::DecompressDataZSTD(compressed);
+    block_offset = 0;
+    if (block.size() != header.uncompressed_size) {
+        LOG_ERROR(HW_GPU, "Corrupted GPU capture block");
+        block.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace VideoCommon::GPUCapture
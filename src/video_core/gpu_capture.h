@@ -0,0 +1,169 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/gpu.h"
+
+namespace Tegra {
+class MemoryManager;
+}
+
+/**
+ * GPU command stream captures.
+ *
+ * A capture records every command list submitted to the GPU together with the guest memory that
+ * is reachable through the GPU address space at the time of submission, so the exact same command
+ * stream can later be replayed offline through the DMA pusher and the engines.
+ *
+ * The file starts with a Header followed by zstd compressed blocks. Each block holds a sequence of
+ * records, each one made of a RecordHeader and `size` bytes of payload.
+ */
+namespace VideoCommon::GPUCapture {
+
+struct Header {
+    static constexpr u32 ExpectedMagic = 0x54434759; // "YGCT"
+    static constexpr u32 ExpectedVersion = 1;
+
+    u32 magic;
+    u32 version;
+    u64 reserved;
+};
+static_assert(sizeof(Header) == 16, "Header has incorrect size");
+
+struct BlockHeader {
+    u32 compressed_size;
+    u32 uncompressed_size;
+};
+static_assert(sizeof(BlockHeader) == 8, "BlockHeader has incorrect size");
+
+enum class RecordType : u32 {
+    MapRegion = 1,   ///< A range of GPU virtual memory got backed by guest memory
+    UnmapRegion = 2, ///< A range of GPU virtual memory is no longer backed by guest memory
+    MemoryPage = 3,  ///< Contents of a guest memory page, followed by Memory::PAGE_SIZE bytes
+    CommandList = 4, ///< A submitted command list, an array of CommandListHeader
+    SwapBuffers = 5, ///< A frame was presented
+};
+
+struct RecordHeader {
+    RecordType type;
+    u32 size;
+};
+static_assert(sizeof(RecordHeader) == 8, "RecordHeader has incorrect size");
+
+struct MapRegionRecord {
+    GPUVAddr gpu_addr;
+    VAddr cpu_addr;
+    u64 size;
+};
+
+struct UnmapRegionRecord {
+    GPUVAddr gpu_addr;
+    u64 size;
+};
+
+struct MemoryPageRecord {
+    VAddr cpu_addr;
+};
+
+struct SwapBuffersRecord {
+    u32 has_framebuffer;
+    INSERT_PADDING_WORDS(1);
+    Tegra::FramebufferConfig framebuffer;
+};
+
+/// A decoded record, as returned by the reader.
+struct Record {
+    RecordType type;
+    std::vector<u8> payload;
+};
+
+/**
+ * Records the command stream submitted to the GPU. Recording is expensive: every guest page
+ * reachable from the GPU is hashed on each submission to find the pages that have to be stored,
+ * so this is only meant to be used to produce captures for offline analysis.
+ */
+class Recorder final {
+public:
+    explicit Recorder(const std::string& path);
+    ~Recorder();
+
+    /// Returns true if the capture file was opened successfully.
+    bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Records a command list along with the guest memory that changed since the last record.
+    void RecordCommandList(const Tegra::MemoryManager& memory_manager,
+                           const Tegra::CommandList& entries);
+
+    /// Records a frame presentation along with the guest memory that changed since the last
+    /// record.
+    void RecordSwapBuffers(
+        const Tegra::MemoryManager& memory_manager,
+        std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer);
+
+private:
+    /// Records the differences between the current GPU mappings and the last recorded ones.
+    void SyncMappings(const Tegra::MemoryManager& memory_manager);
+
+    /// Records the guest pages reachable from the GPU whose contents changed.
+    void SyncMemory();
+
+    /// Appends a record to the current block.
+    void Write(RecordType type, const void* data, std::size_t size);
+
+    /// Appends a record with a two-part payload to the current block.
+    void Write(RecordType type, const void* data, std::size_t size, const void* extra_data,
+               std::size_t extra_size);
+
+    /// Compresses the current block and writes it to disk.
+    void FlushBlock();
+
+    std::mutex mutex;
+    FileUtil::IOFile file;
+    std::vector<u8> block;
+
+    /// Mappings in the GPU address space that have been recorded, keyed by GPU address.
+    std::map<GPUVAddr, MapRegionRecord> mappings;
+    /// Hashes of the guest pages that have been recorded, keyed by CPU address.
+    std::unordered_map<VAddr, u64> page_hashes;
+};
+
+/// Reads back the records stored in a capture file.
+class Reader final {
+public:
+    explicit Reader(const std::string& path);
+    ~Reader();
+
+    /// Returns true if the capture file was opened and has a valid header.
+    bool IsValid() const {
+        return is_valid;
+    }
+
+    /// Returns the next record in the capture, or std::nullopt if there are no more records.
+    std::optional<Record> Next();
+
+private:
+    /// Reads and decompresses the next block of the file.
+    bool ReadBlock();
+
+    FileUtil::IOFile file;
+    std::vector<u8> block;
+    std::size_t block_offset{};
+    bool is_valid{};
+};
+
+} // namespace VideoCommon::GPUCapture
@@ -8,19 +8,26 @@
 namespace VideoCommon {
 
 GPUSynch::GPUSynch(Core::System& system, VideoCore::RendererBase& renderer)
-    : GPU(system, renderer) {}
+    : GPU(system, renderer, false) {}
 
 GPUSynch::~GPUSynch() = default;
 
 void GPUSynch::Start() {}
 
 void GPUSynch::PushGPUEntries(Tegra::CommandList&& entries) {
+    CaptureCommandList(entries);
     dma_pusher->Push(std::move(entries));
     dma_pusher->DispatchCalls();
 }
 
+void GPUSynch::PushGPUEntriesAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id) {
+    PushGPUEntries(std::move(entries));
+    IncrementSyncPoint(syncpoint_id);
+}
+
 void GPUSynch::SwapBuffers(
     std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
+    CaptureSwapBuffers(framebuffer);
     renderer.SwapBuffers(std::move(framebuffer));
 }
 
@@ -36,4 +43,6 @@ void GPUSynch::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
     renderer.Rasterizer().FlushAndInvalidateRegion(addr, size);
 }
 
+void GPUSynch::WaitIdle() {}
+
 } // namespace VideoCommon
@@ -20,11 +20,13 @@ public:
 
     void Start() override;
     void PushGPUEntries(Tegra::CommandList&& entries) override;
+    void PushGPUEntriesAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id) override;
     void SwapBuffers(
         std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) override;
     void FlushRegion(CacheAddr addr, u64 size) override;
     void InvalidateRegion(CacheAddr addr, u64 size) override;
     void FlushAndInvalidateRegion(CacheAddr addr, u64 size) override;
+    void WaitIdle() override;
 };
 
 } // namespace VideoCommon
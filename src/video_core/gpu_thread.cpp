@@ -16,8 +16,8 @@
 namespace VideoCommon::GPUThread {
 
 /// Runs the GPU thread
-static void RunThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_pusher,
-                      SynchState& state) {
+static void RunThread(VideoCore::RendererBase& renderer, Tegra::GPU& gpu,
+                      Tegra::DmaPusher& dma_pusher, SynchState& state) {
     MicroProfileOnThreadCreate("GpuThread");
 
     // Wait for first GPU command before acquiring the window context
@@ -38,6 +38,9 @@ static void RunThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_p
             if (const auto submit_list = std::get_if<SubmitListCommand>(&next.data)) {
                 dma_pusher.Push(std::move(submit_list->entries));
                 dma_pusher.DispatchCalls();
+                if (submit_list->syncpoint_id) {
+                    gpu.IncrementSyncPoint(*submit_list->syncpoint_id);
+                }
             } else if (const auto data = std::get_if<SwapBuffersCommand>(&next.data)) {
                 renderer.SwapBuffers(std::move(data->framebuffer));
             } else if (const auto data = std::get_if<FlushRegionCommand>(&next.data)) {
@@ -67,8 +70,10 @@ ThreadManager::~ThreadManager() {
     thread.join();
 }
 
-void ThreadManager::StartThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_pusher) {
-    thread = std::thread{RunThread, std::ref(renderer), std::ref(dma_pusher), std::ref(state)};
+void ThreadManager::StartThread(VideoCore::RendererBase& renderer, Tegra::GPU& gpu,
+                                Tegra::DmaPusher& dma_pusher) {
+    thread = std::thread{RunThread, std::ref(renderer), std::ref(gpu), std::ref(dma_pusher),
+                         std::ref(state)};
     synchronization_event = system.CoreTiming().RegisterEvent(
         "GPUThreadSynch", [this](u64 fence, s64) { state.WaitForSynchronization(fence); });
 }
@@ -79,6 +84,10 @@ void ThreadManager::SubmitList(Tegra::CommandList&& entries) {
     system.CoreTiming().ScheduleEvent(synchronization_ticks, synchronization_event, fence);
 }
 
+void ThreadManager::SubmitListAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id) {
+    PushCommand(SubmitListCommand(std::move(entries), syncpoint_id));
+}
+
 void ThreadManager::SwapBuffers(
     std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
     PushCommand(SwapBuffersCommand(std::move(framebuffer)));
@@ -102,6 +111,10 @@ void ThreadManager::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
     InvalidateRegion(addr, size);
 }
 
+void ThreadManager::WaitIdle() {
+    state.WaitForSynchronization(state.last_fence);
+}
+
 u64 ThreadManager::PushCommand(CommandData&& command_data) {
     const u64 fence{++state.last_fence};
     state.queue.Push(CommandDataContainer(std::move(command_data), fence));
@@ -17,6 +17,7 @@
 namespace Tegra {
 struct FramebufferConfig;
 class DmaPusher;
+class GPU;
 } // namespace Tegra
 
 namespace Core {
@@ -33,9 +34,13 @@ struct EndProcessingCommand final {};
 
 /// Command to signal to the GPU thread that a command list is ready for processing
 struct SubmitListCommand final {
-    explicit SubmitListCommand(Tegra::CommandList&& entries) : entries{std::move(entries)} {}
+    explicit SubmitListCommand(Tegra::CommandList&& entries,
+                               std::optional<u32> syncpoint_id = std::nullopt)
+        : entries{std::move(entries)}, syncpoint_id{syncpoint_id} {}
 
     Tegra::CommandList entries;
+    /// Syncpoint to increment once the command list has been executed
+    std::optional<u32> syncpoint_id;
 };
 
 /// Command to signal to the GPU thread that a swap buffers is pending
@@ -142,11 +147,16 @@ public:
     ~ThreadManager();
 
     /// Creates and starts the GPU thread.
-    void StartThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_pusher);
+    void StartThread(VideoCore::RendererBase& renderer, Tegra::GPU& gpu,
+                     Tegra::DmaPusher& dma_pusher);
 
     /// Push GPU command entries to be processed
     void SubmitList(Tegra::CommandList&& entries);
 
+    /// Push GPU command entries to be processed, incrementing the syncpoint once they have been
+    /// executed. The guest waits on the syncpoint, so no periodic synchronization is scheduled.
+    void SubmitListAndIncrement(Tegra::CommandList&& entries, u32 syncpoint_id);
+
     /// Swap buffers (render frame)
     void SwapBuffers(
         std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer);
@@ -160,6 +170,9 @@ public:
     /// Notify rasterizer that any caches of the specified region should be flushed and invalidated
     void FlushAndInvalidateRegion(CacheAddr addr, u64 size);
 
+    /// Blocks until all of the pushed commands have been executed
+    void WaitIdle();
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data);
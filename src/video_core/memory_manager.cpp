@@ -109,6 +109,31 @@ std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr) const {
     return {};
 }
 
+std::vector<MemoryManager::MappedRegion> MemoryManager::GetMappedRegions() const {
+    std::vector<MappedRegion> regions;
+    for (const auto& [base, vma] : vma_map) {
+        if (vma.type != VirtualMemoryArea::Type::Mapped) {
+            continue;
+        }
+
+        // Merged VMAs are only guaranteed to be contiguous in host memory, split them wherever the
+        // guest addresses stop being contiguous.
+        for (GPUVAddr gpu_addr = base; gpu_addr < base + vma.size; gpu_addr += page_size) {
+            const VAddr cpu_addr{page_table.backing_addr[gpu_addr >> page_bits]};
+            if (!regions.empty()) {
+                MappedRegion& last{regions.back()};
+                if (last.gpu_addr + last.size == gpu_addr &&
+                    last.cpu_addr + last.size == cpu_addr) {
+                    last.size += page_size;
+                    continue;
+                }
+            }
+            regions.push_back({gpu_addr, cpu_addr, page_size});
+        }
+    }
+    return regions;
+}
+
 template <typename T>
 T MemoryManager::Read(GPUVAddr addr) const {
     if (!IsAddressValid(addr)) {
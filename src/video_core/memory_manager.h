@@ -6,6 +6,7 @@
 
 #include <map>
 #include <optional>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/page_table.h"
@@ -47,6 +48,13 @@ struct VirtualMemoryArea {
 
 class MemoryManager final {
 public:
+    /// Describes a range of GPU virtual memory that is backed by contiguous guest memory.
+    struct MappedRegion {
+        GPUVAddr gpu_addr;
+        VAddr cpu_addr;
+        u64 size;
+    };
+
     MemoryManager(VideoCore::RasterizerInterface& rasterizer);
 
     GPUVAddr AllocateSpace(u64 size, u64 align);
@@ -56,6 +64,9 @@ public:
     GPUVAddr UnmapBuffer(GPUVAddr addr, u64 size);
     std::optional<VAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
+    /// Returns every range of the GPU address space that is currently backed by guest memory.
+    std::vector<MappedRegion> GetMappedRegions() const;
+
     template <typename T>
     T Read(GPUVAddr addr) const;
 
@@ -115,6 +115,13 @@ public:
         }
     }
 
+    /// Returns a counter that changes every time an object is registered or unregistered
+    u64 GetRegistryGeneration() {
+        std::lock_guard lock{mutex};
+
+        return registry_generation;
+    }
+
 protected:
     /// Tries to get an object from the cache with the specified cache address
     T TryGet(CacheAddr addr) const {
@@ -139,6 +146,7 @@ protected:
         interval_cache.add({GetInterval(object), ObjectSet{object}});
         map_cache.insert({object->GetCacheAddr(), object});
         rasterizer.UpdatePagesCachedCount(object->GetCpuAddr(), object->GetSizeInBytes(), 1);
+        ++registry_generation;
     }
 
     /// Unregisters an object from the cache
@@ -149,6 +157,7 @@ protected:
         rasterizer.UpdatePagesCachedCount(object->GetCpuAddr(), object->GetSizeInBytes(), -1);
         interval_cache.subtract({GetInterval(object), ObjectSet{object}});
         map_cache.erase(object->GetCacheAddr());
+        ++registry_generation;
     }
 
     /// Returns a ticks counter used for tracking when cached objects were last modified
@@ -207,6 +216,7 @@ private:
     ObjectCache map_cache;
     IntervalCache interval_cache; ///< Cache of objects
     u64 modified_ticks{};         ///< Counter of cache state ticks, used for in-order flushing
+    u64 registry_generation{};    ///< Counter of changes to the set of registered objects
     VideoCore::RasterizerInterface& rasterizer;
     std::recursive_mutex mutex;
 };
@@ -0,0 +1,210 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <boost/range/iterator_range.hpp>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+MICROPROFILE_DEFINE(Null_Drawing, "Null", "Drawing", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_Texture, "Null", "Texture Setup", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(Null_CacheManagement, "Null", "Cache Management", MP_RGB(100, 255, 100));
+MICROPROFILE_DEFINE(Null_Blits, "Null", "Blits", MP_RGB(100, 100, 255));
+
+RasterizerNull::RasterizerNull(Core::System& system)
+    : system{system}, texture_cache{system, *this}, shader_cache{system, *this} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::DrawArrays() {
+    if (!accelerate_draw) {
+        return;
+    }
+
+    MICROPROFILE_SCOPE(Null_Drawing);
+    ConfigureFramebuffers(true, true);
+    SetupShaders();
+
+    accelerate_draw = false;
+}
+
+void RasterizerNull::Clear() {
+    const auto& regs{system.GPU().Maxwell3D().regs};
+    const bool use_color{regs.clear_buffers.R || regs.clear_buffers.G || regs.clear_buffers.B ||
+                         regs.clear_buffers.A};
+    const bool use_depth_stencil{regs.clear_buffers.Z || regs.clear_buffers.S};
+    if (!use_color && !use_depth_stencil) {
+        // No color surface nor depth/stencil surface are enabled
+        return;
+    }
+
+    ConfigureFramebuffers(use_color, use_depth_stencil && regs.zeta_enable != 0,
+                          regs.clear_buffers.RT.Value());
+}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(CacheAddr addr, u64 size) {
+    MICROPROFILE_SCOPE(Null_CacheManagement);
+    if (!addr || !size) {
+        return;
+    }
+    texture_cache.FlushRegion({}, addr, size);
+}
+
+void RasterizerNull::InvalidateRegion(CacheAddr addr, u64 size) {
+    MICROPROFILE_SCOPE(Null_CacheManagement);
+    if (!addr || !size) {
+        return;
+    }
+    texture_cache.InvalidateRegion(addr, size);
+    shader_cache.InvalidateRegion(addr, size);
+}
+
+void RasterizerNull::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
+    FlushRegion(addr, size);
+    InvalidateRegion(addr, size);
+}
+
+bool RasterizerNull::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
+                                           const Tegra::Engines::Fermi2D::Regs::Surface& dst,
+                                           const Common::Rectangle<u32>& src_rect,
+                                           const Common::Rectangle<u32>& dst_rect) {
+    MICROPROFILE_SCOPE(Null_Blits);
+    const auto [src_view, src_exctx] = texture_cache.GetFermiSurface({}, src);
+    const auto [dst_view, dst_exctx] = texture_cache.GetFermiSurface({}, dst);
+    if (!src_view || !dst_view ||
+        !dst_view->GetSurface().BlitFrom(src_view->GetSurface(), src_rect, dst_rect)) {
+        return false;
+    }
+    dst_view->MarkAsModified(true);
+    return true;
+}
+
+bool RasterizerNull::AccelerateDrawBatch(bool is_indexed) {
+    accelerate_draw = true;
+    DrawArrays();
+    return true;
+}
+
+template <typename Map, typename Interval>
+static constexpr auto RangeFromInterval(Map& map, const Interval& interval) {
+    return boost::make_iterator_range(map.equal_range(interval));
+}
+
+void RasterizerNull::UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {
+    const u64 page_start{addr >> Memory::PAGE_BITS};
+    const u64 page_end{(addr + size + Memory::PAGE_SIZE - 1) >> Memory::PAGE_BITS};
+
+    // Interval maps will erase segments if count reaches 0, so if delta is negative we have to
+    // subtract after iterating
+    const auto pages_interval = CachedPageMap::interval_type::right_open(page_start, page_end);
+    if (delta > 0)
+        cached_pages.add({pages_interval, delta});
+
+    for (const auto& pair : RangeFromInterval(cached_pages, pages_interval)) {
+        const auto interval = pair.first & pages_interval;
+        const int count = pair.second;
+
+        const VAddr interval_start_addr = boost::icl::first(interval) << Memory::PAGE_BITS;
+        const VAddr interval_end_addr = boost::icl::last_next(interval) << Memory::PAGE_BITS;
+        const u64 interval_size = interval_end_addr - interval_start_addr;
+
+        if (delta > 0 && count == delta)
+            Memory::RasterizerMarkRegionCached(interval_start_addr, interval_size, true);
+        else if (delta < 0 && count == -delta)
+            Memory::RasterizerMarkRegionCached(interval_start_addr, interval_size, false);
+        else
+            ASSERT(count >= 0);
+    }
+
+    if (delta < 0)
+        cached_pages.add({pages_interval, delta});
+}
+
+void RasterizerNull::ConfigureFramebuffers(bool using_color_fb, bool using_depth_fb,
+                                           std::optional<std::size_t> single_color_target) {
+    // Contents are always preserved, a surface that is only partially written must not flush
+    // stale data over guest memory.
+    constexpr bool preserve_contents = true;
+
+    if (using_depth_fb) {
+        const auto [depth_view, exctx] =
+            texture_cache.GetDepthBufferSurface({}, preserve_contents);
+        if (depth_view) {
+            // Assume that a surface will be written to if it is used as a framebuffer, even if
+            // the shader doesn't actually write to it.
+            depth_view->MarkAsModified(true);
+        }
+    }
+
+    if (!using_color_fb) {
+        return;
+    }
+
+    const auto mark_color_buffer = [this](std::size_t index) {
+        const auto [color_view, exctx] =
+            texture_cache.GetColorBufferSurface({}, index, preserve_contents);
+        if (color_view) {
+            color_view->MarkAsModified(true);
+        }
+    };
+
+    if (single_color_target) {
+        mark_color_buffer(*single_color_target);
+        return;
+    }
+    for (std::size_t index = 0; index < Maxwell::NumRenderTargets; ++index) {
+        mark_color_buffer(index);
+    }
+}
+
+void RasterizerNull::SetupShaders() {
+    auto& maxwell3d{system.GPU().Maxwell3D()};
+
+    for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        const auto program{static_cast<Maxwell::ShaderProgram>(index)};
+
+        // Skip stages that are not enabled
+        if (!maxwell3d.regs.IsShaderConfigEnabled(index)) {
+            continue;
+        }
+
+        const std::size_t stage{index == 0 ? 0 : index - 1}; // Stage indices are 0 - 5
+        const Shader shader{shader_cache.GetStageProgram(program)};
+        if (shader) {
+            SetupTextures(static_cast<Maxwell::ShaderStage>(stage), shader);
+        }
+    }
+
+    maxwell3d.dirty_flags.shaders = false;
+}
+
+void RasterizerNull::SetupTextures(Maxwell::ShaderStage stage, const Shader& shader) {
+    MICROPROFILE_SCOPE(Null_Texture);
+    const auto& maxwell3d{system.GPU().Maxwell3D()};
+
+    for (const auto& entry : shader->GetSamplers()) {
+        Tegra::Texture::FullTextureInfo texture;
+        if (entry.IsBindless()) {
+            const auto cbuf_index{static_cast<u32>(entry.GetOffset() >> 32)};
+            const auto cbuf_offset{static_cast<u32>(entry.GetOffset())};
+            Tegra::Texture::TextureHandle tex_handle;
+            tex_handle.raw = maxwell3d.AccessConstBuffer32(stage, cbuf_index, cbuf_offset);
+            texture = maxwell3d.GetTextureInfo(tex_handle, entry.GetOffset());
+        } else {
+            texture = maxwell3d.GetStageTexture(stage, entry.GetOffset());
+        }
+        texture_cache.GetTextureSurface({}, texture);
+    }
+}
+
+} // namespace Null
@@ -0,0 +1,68 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <boost/icl/interval_map.hpp>
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_null/null_shader_cache.h"
+#include "video_core/renderer_null/null_texture_cache.h"
+
+namespace Core {
+class System;
+}
+
+namespace Null {
+
+/**
+ * Rasterizer that performs all the guest-visible work of a draw (shader decoding, texture and
+ * render target cache bookkeeping, swizzling on loads and flushes) without issuing any host GPU
+ * work. It is meant for profiling the CPU side of GPU emulation and for headless runs.
+ */
+class RasterizerNull final : public VideoCore::RasterizerInterface {
+public:
+    explicit RasterizerNull(Core::System& system);
+    ~RasterizerNull() override;
+
+    void DrawArrays() override;
+    void Clear() override;
+    void FlushAll() override;
+    void FlushRegion(CacheAddr addr, u64 size) override;
+    void InvalidateRegion(CacheAddr addr, u64 size) override;
+    void FlushAndInvalidateRegion(CacheAddr addr, u64 size) override;
+    bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
+                               const Tegra::Engines::Fermi2D::Regs::Surface& dst,
+                               const Common::Rectangle<u32>& src_rect,
+                               const Common::Rectangle<u32>& dst_rect) override;
+    bool AccelerateDrawBatch(bool is_indexed) override;
+    void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override;
+
+private:
+    /// Looks up the bound render targets, marking them as modified.
+    void ConfigureFramebuffers(bool using_color_fb, bool using_depth_fb,
+                               std::optional<std::size_t> single_color_target = {});
+
+    /// Looks up the textures used by the bound shader stages.
+    void SetupShaders();
+
+    /// Looks up the textures used by a shader stage.
+    void SetupTextures(Maxwell::ShaderStage stage, const Shader& shader);
+
+    Core::System& system;
+
+    TextureCacheNull texture_cache;
+    ShaderCacheNull shader_cache;
+
+    bool accelerate_draw = false;
+
+    using CachedPageMap = boost::icl::interval_map<u64, int>;
+    CachedPageMap cached_pages;
+};
+
+} // namespace Null
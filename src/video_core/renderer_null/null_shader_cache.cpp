@@ -0,0 +1,102 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "core/core.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_shader_cache.h"
+
+namespace Null {
+
+using VideoCommon::Shader::ProgramCode;
+using VideoCommon::Shader::ShaderIR;
+
+MICROPROFILE_DEFINE(Null_ShaderDecode, "Null", "Shader Decode", MP_RGB(128, 128, 192));
+
+namespace {
+
+/// Offset of the first instruction of a program, after the shader program header
+constexpr u32 PROGRAM_OFFSET = 10;
+
+/// Gets if the current instruction offset is a scheduler instruction
+constexpr bool IsSchedInstruction(std::size_t offset, std::size_t main_offset) {
+    // Sched instructions appear once every 4 instructions.
+    constexpr std::size_t SchedPeriod = 4;
+    const std::size_t absolute_offset = offset - main_offset;
+    return (absolute_offset % SchedPeriod) == 0;
+}
+
+/// Calculates the size of a program stream
+std::size_t CalculateProgramSize(const ProgramCode& program) {
+    std::size_t offset = PROGRAM_OFFSET;
+    std::size_t size = PROGRAM_OFFSET * sizeof(u64);
+    while (offset < program.size()) {
+        const u64 instruction = program[offset];
+        if (!IsSchedInstruction(offset, PROGRAM_OFFSET)) {
+            if (instruction == 0 || (instruction >> 52) == 0x50b) {
+                // End on Maxwell's "nop" instruction
+                break;
+            }
+        }
+        size += sizeof(u64);
+        offset++;
+    }
+    // The last instruction is included in the program size
+    return std::min(size + sizeof(u64), program.size() * sizeof(u64));
+}
+
+/// Gets the address for the specified shader stage program
+GPUVAddr GetShaderAddress(const Tegra::Engines::Maxwell3D& maxwell3d,
+                          Maxwell::ShaderProgram program) {
+    const auto& shader_config{maxwell3d.regs.shader_config[static_cast<std::size_t>(program)]};
+    return maxwell3d.regs.code_address.CodeAddress() + shader_config.offset;
+}
+
+} // Anonymous namespace
+
+CachedShader::CachedShader(VAddr cpu_addr, u8* host_ptr, const ProgramCode& program_code)
+    : RasterizerCacheObject{host_ptr}, cpu_addr{cpu_addr},
+      shader_length{CalculateProgramSize(program_code)} {
+    MICROPROFILE_SCOPE(Null_ShaderDecode);
+    const ShaderIR program_ir(program_code, PROGRAM_OFFSET);
+    const auto& used_samplers{program_ir.GetSamplers()};
+    samplers.assign(used_samplers.begin(), used_samplers.end());
+}
+
+ShaderCacheNull::ShaderCacheNull(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
+    : RasterizerCache{rasterizer}, system{system} {}
+
+Shader ShaderCacheNull::GetStageProgram(Maxwell::ShaderProgram program) {
+    auto& maxwell3d{system.GPU().Maxwell3D()};
+    if (!maxwell3d.dirty_flags.shaders) {
+        return last_shaders[static_cast<std::size_t>(program)];
+    }
+
+    auto& memory_manager{system.GPU().MemoryManager()};
+    const GPUVAddr program_addr{GetShaderAddress(maxwell3d, program)};
+
+    // Look up shader in the cache based on address
+    const auto host_ptr{memory_manager.GetPointer(program_addr)};
+    Shader shader{TryGet(host_ptr)};
+
+    if (!shader) {
+        ProgramCode program_code(VideoCommon::Shader::MAX_PROGRAM_LENGTH);
+        ASSERT_OR_EXECUTE(host_ptr != nullptr, {
+            return last_shaders[static_cast<std::size_t>(program)] = nullptr;
+        });
+        memory_manager.ReadBlockUnsafe(program_addr, program_code.data(),
+                                       program_code.size() * sizeof(u64));
+
+        const VAddr cpu_addr{*memory_manager.GpuToCpuAddress(program_addr)};
+        shader = std::make_shared<CachedShader>(cpu_addr, host_ptr, program_code);
+        Register(shader);
+    }
+
+    return last_shaders[static_cast<std::size_t>(program)] = shader;
+}
+
+} // namespace Null
@@ -0,0 +1,67 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_cache.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace Core {
+class System;
+}
+
+namespace Null {
+
+class CachedShader;
+
+using Shader = std::shared_ptr<CachedShader>;
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+
+/// A guest shader program decoded to the IR, only its resource usage is kept.
+class CachedShader final : public RasterizerCacheObject {
+public:
+    explicit CachedShader(VAddr cpu_addr, u8* host_ptr,
+                          const VideoCommon::Shader::ProgramCode& program_code);
+
+    VAddr GetCpuAddr() const override {
+        return cpu_addr;
+    }
+
+    std::size_t GetSizeInBytes() const override {
+        return shader_length;
+    }
+
+    // We do not have to flush this cache as things in it are never modified by us.
+    void Flush() override {}
+
+    /// Gets the samplers used by the shader
+    const std::vector<VideoCommon::Shader::Sampler>& GetSamplers() const {
+        return samplers;
+    }
+
+private:
+    VAddr cpu_addr{};
+    std::size_t shader_length{};
+    std::vector<VideoCommon::Shader::Sampler> samplers;
+};
+
+class ShaderCacheNull final : public RasterizerCache<Shader> {
+public:
+    explicit ShaderCacheNull(Core::System& system, VideoCore::RasterizerInterface& rasterizer);
+
+    /// Gets the current specified shader stage program
+    Shader GetStageProgram(Maxwell::ShaderProgram program);
+
+private:
+    Core::System& system;
+    std::array<Shader, Maxwell::MaxShaderProgram> last_shaders;
+};
+
+} // namespace Null
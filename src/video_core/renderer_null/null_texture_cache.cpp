@@ -0,0 +1,230 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "video_core/morton.h"
+#include "video_core/renderer_null/null_texture_cache.h"
+#include "video_core/surface.h"
+
+namespace Null {
+
+using VideoCore::MortonSwizzle;
+using VideoCore::MortonSwizzleMode;
+using VideoCore::Surface::GetBytesPerPixel;
+using VideoCore::Surface::GetDefaultBlockHeight;
+using VideoCore::Surface::GetDefaultBlockWidth;
+
+MICROPROFILE_DEFINE(Null_TextureLoad, "Null", "Texture Load", MP_RGB(128, 192, 128));
+MICROPROFILE_DEFINE(Null_TextureFlush, "Null", "Texture Flush", MP_RGB(128, 192, 64));
+
+CachedSurface::CachedSurface(const SurfaceParams& params)
+    : VideoCommon::SurfaceBase<CachedSurfaceView, ExecutionContext>{params} {
+    staging_buffer.resize(params.GetHostMipmapLevelOffset(params.GetNumLevels()));
+}
+
+CachedSurface::~CachedSurface() = default;
+
+void CachedSurface::LoadBuffer() {
+    MICROPROFILE_SCOPE(Null_TextureLoad);
+    if (params.IsTiled()) {
+        ASSERT_MSG(params.GetBlockWidth() == 1, "Block width is defined as {} on texture target {}",
+                   params.GetBlockWidth(), static_cast<u32>(params.GetTarget()));
+        for (u32 level = 0; level < params.GetNumLevels(); ++level) {
+            SwizzleLevel(MortonSwizzleMode::MortonToLinear, level);
+        }
+        return;
+    }
+
+    // Pitch linear surfaces only have one level
+    const u32 block_width{GetDefaultBlockWidth(params.GetPixelFormat())};
+    const u32 block_height{GetDefaultBlockHeight(params.GetPixelFormat())};
+    const u32 copy_size{(params.GetWidth() + block_width - 1) / block_width *
+                        GetBytesPerPixel(params.GetPixelFormat())};
+    const u32 height{(params.GetHeight() + block_height - 1) / block_height};
+    const u8* read_from{GetHostPtr()};
+    u8* write_to{staging_buffer.data()};
+    for (u32 row = 0; row < height; ++row) {
+        std::memcpy(write_to, read_from, copy_size);
+        read_from += params.GetPitch();
+        write_to += copy_size;
+    }
+}
+
+ExecutionContext CachedSurface::FlushBuffer(ExecutionContext exctx) {
+    MICROPROFILE_SCOPE(Null_TextureFlush);
+    if (!IsModified()) {
+        return exctx;
+    }
+
+    if (params.IsTiled()) {
+        ASSERT_MSG(params.GetBlockWidth() == 1, "Block width is defined as {} on texture target {}",
+                   params.GetBlockWidth(), static_cast<u32>(params.GetTarget()));
+        for (u32 level = 0; level < params.GetNumLevels(); ++level) {
+            SwizzleLevel(MortonSwizzleMode::LinearToMorton, level);
+        }
+        return exctx;
+    }
+
+    const u32 block_width{GetDefaultBlockWidth(params.GetPixelFormat())};
+    const u32 block_height{GetDefaultBlockHeight(params.GetPixelFormat())};
+    const u32 copy_size{(params.GetWidth() + block_width - 1) / block_width *
+                        GetBytesPerPixel(params.GetPixelFormat())};
+    const u32 height{(params.GetHeight() + block_height - 1) / block_height};
+    const u8* read_from{staging_buffer.data()};
+    u8* write_to{GetHostPtr()};
+    for (u32 row = 0; row < height; ++row) {
+        std::memcpy(write_to, read_from, copy_size);
+        read_from += copy_size;
+        write_to += params.GetPitch();
+    }
+    return exctx;
+}
+
+void CachedSurface::CopyFrom(const CachedSurface& src_surface,
+                             const VideoCommon::CopyParams& copy_params) {
+    // Both surfaces have blocks of the same size, so their staging buffers share the same layout
+    // for the copied region and the texels can be copied as raw bytes
+    const u32 level{copy_params.dest_level};
+    const std::size_t src_layer_size{src_surface.params.GetHostLayerSize(0)};
+    const std::size_t dst_layer_size{params.GetHostLayerSize(level)};
+    const std::size_t copy_size{std::min(src_layer_size, dst_layer_size)};
+    const u32 num_layers{params.IsLayered() ? copy_params.depth : 1};
+
+    const u8* const read_from{src_surface.staging_buffer.data()};
+    u8* const write_to{staging_buffer.data() + params.GetHostMipmapLevelOffset(level) +
+                       copy_params.dest_layer * dst_layer_size};
+    for (u32 layer = 0; layer < num_layers; ++layer) {
+        std::memcpy(write_to + layer * dst_layer_size, read_from + layer * src_layer_size,
+                    copy_size);
+    }
+}
+
+bool CachedSurface::BlitFrom(const CachedSurface& src_surface,
+                             const Common::Rectangle<u32>& src_rect,
+                             const Common::Rectangle<u32>& dst_rect) {
+    const auto& src_params{src_surface.params};
+    const u32 bytes_per_pixel{GetBytesPerPixel(params.GetPixelFormat())};
+    if (GetBytesPerPixel(src_params.GetPixelFormat()) != bytes_per_pixel ||
+        GetDefaultBlockWidth(params.GetPixelFormat()) != 1 ||
+        GetDefaultBlockHeight(params.GetPixelFormat()) != 1 ||
+        GetDefaultBlockWidth(src_params.GetPixelFormat()) != 1 ||
+        GetDefaultBlockHeight(src_params.GetPixelFormat()) != 1) {
+        return false;
+    }
+    if (src_rect.GetWidth() == 0 || src_rect.GetHeight() == 0 || dst_rect.GetWidth() == 0 ||
+        dst_rect.GetHeight() == 0 || src_rect.left >= src_params.GetWidth() ||
+        dst_rect.left >= params.GetWidth()) {
+        // Nothing is copied
+        return true;
+    }
+
+    // Fermi2D surfaces have a single level, their staging buffers are plain rows of texels
+    std::vector<u8> src_copy;
+    const u8* src_data{src_surface.staging_buffer.data()};
+    if (&src_surface == this) {
+        src_copy = staging_buffer;
+        src_data = src_copy.data();
+    }
+    const std::size_t src_pitch{src_params.GetWidth() * bytes_per_pixel};
+    const std::size_t dst_pitch{params.GetWidth() * bytes_per_pixel};
+    const u32 dst_width{dst_rect.GetWidth()};
+    const u32 dst_height{dst_rect.GetHeight()};
+    const u32 right{std::min(dst_rect.left + dst_width, params.GetWidth())};
+    const u32 bottom{std::min(dst_rect.top + dst_height, params.GetHeight())};
+    const bool is_scaled{src_rect.GetWidth() != dst_width};
+
+    for (u32 y = dst_rect.top; y < bottom; ++y) {
+        const u32 src_y{src_rect.top +
+                        static_cast<u32>(static_cast<u64>(y - dst_rect.top) *
+                                         src_rect.GetHeight() / dst_height)};
+        if (src_y >= src_params.GetHeight()) {
+            break;
+        }
+        const u8* const read_from{src_data + src_y * src_pitch};
+        u8* const write_to{staging_buffer.data() + y * dst_pitch};
+        if (!is_scaled) {
+            const u32 width{std::min(right, dst_rect.left + src_params.GetWidth() - src_rect.left) -
+                            dst_rect.left};
+            std::memcpy(write_to + dst_rect.left * bytes_per_pixel,
+                        read_from + src_rect.left * bytes_per_pixel, width * bytes_per_pixel);
+            continue;
+        }
+        for (u32 x = dst_rect.left; x < right; ++x) {
+            const u32 src_x{src_rect.left +
+                            static_cast<u32>(static_cast<u64>(x - dst_rect.left) *
+                                             src_rect.GetWidth() / dst_width)};
+            if (src_x >= src_params.GetWidth()) {
+                break;
+            }
+            std::memcpy(write_to + x * bytes_per_pixel, read_from + src_x * bytes_per_pixel,
+                        bytes_per_pixel);
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<CachedSurfaceView> CachedSurface::CreateView(const ViewKey& view_key) {
+    return std::make_unique<CachedSurfaceView>(*this, view_key);
+}
+
+void CachedSurface::SwizzleLevel(MortonSwizzleMode mode, u32 level) {
+    const std::size_t guest_offset{params.GetGuestMipmapLevelOffset(level)};
+    const std::size_t host_offset{params.GetHostMipmapLevelOffset(level)};
+    u8* const guest_ptr{GetHostPtr() + guest_offset};
+    u8* const host_ptr{staging_buffer.data() + host_offset};
+
+    if (!params.IsLayered()) {
+        MortonSwizzle(mode, params.GetPixelFormat(), params.GetMipWidth(level),
+                      params.GetMipBlockHeight(level), params.GetMipHeight(level),
+                      params.GetMipBlockDepth(level), params.GetMipDepth(level),
+                      params.GetTileWidthSpacing(), host_ptr, guest_ptr);
+        return;
+    }
+
+    // Layers are stored contiguously in guest memory, each one with its whole mipmap chain
+    const std::size_t guest_layer_size{params.GetGuestLayerSize()};
+    const std::size_t host_layer_size{params.GetHostLayerSize(level)};
+    for (u32 layer = 0; layer < params.GetNumLayers(); ++layer) {
+        MortonSwizzle(mode, params.GetPixelFormat(), params.GetMipWidth(level),
+                      params.GetMipBlockHeight(level), params.GetMipHeight(level),
+                      params.GetMipBlockDepth(level), 1, params.GetTileWidthSpacing(),
+                      host_ptr + layer * host_layer_size, guest_ptr + layer * guest_layer_size);
+    }
+}
+
+CachedSurfaceView::CachedSurfaceView(CachedSurface& surface, ViewKey key)
+    : surface{surface}, key{key} {}
+
+CachedSurfaceView::~CachedSurfaceView() = default;
+
+TextureCacheNull::TextureCacheNull(Core::System& system,
+                                   VideoCore::RasterizerInterface& rasterizer)
+    : TextureCacheBase{system, rasterizer} {}
+
+TextureCacheNull::~TextureCacheNull() = default;
+
+std::tuple<CachedSurfaceView*, ExecutionContext> TextureCacheNull::TryFastGetSurfaceView(
+    ExecutionContext exctx, VAddr cpu_addr, u8* host_ptr, const SurfaceParams& params,
+    bool preserve_contents, const std::vector<CachedSurface*>& overlaps) {
+    // Overlaps that can't be copied are flushed and reloaded, this mirrors the slow path of the
+    // hardware backends.
+    return {nullptr, exctx};
+}
+
+std::unique_ptr<CachedSurface> TextureCacheNull::CreateSurface(const SurfaceParams& params) {
+    return std::make_unique<CachedSurface>(params);
+}
+
+ExecutionContext TextureCacheNull::CopyImage(ExecutionContext exctx, CachedSurface& src_surface,
+                                             CachedSurface& dst_surface,
+                                             const VideoCommon::CopyParams& copy_params) {
+    dst_surface.CopyFrom(src_surface, copy_params);
+    return exctx;
+}
+
+} // namespace Null
@@ -0,0 +1,117 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/math_util.h"
+#include "video_core/morton.h"
+#include "video_core/texture_cache.h"
+
+namespace Core {
+class System;
+}
+
+namespace VideoCore {
+class RasterizerInterface;
+}
+
+namespace Null {
+
+using VideoCommon::SurfaceParams;
+using VideoCommon::ViewKey;
+
+class CachedSurface;
+class CachedSurfaceView;
+
+/// The null backend doesn't record any host work, its execution context is empty.
+struct ExecutionContext {};
+
+using TextureCacheBase =
+    VideoCommon::TextureCache<CachedSurface, CachedSurfaceView, ExecutionContext>;
+
+/**
+ * Surface that lives only in host memory. Guest data is unswizzled into a linear staging buffer
+ * when the surface is loaded and swizzled back when it is flushed, so all the guest-visible
+ * memory traffic of the hardware backends is reproduced without a graphics API.
+ */
+class CachedSurface final : public VideoCommon::SurfaceBase<CachedSurfaceView, ExecutionContext> {
+    friend CachedSurfaceView;
+
+public:
+    explicit CachedSurface(const SurfaceParams& params);
+    ~CachedSurface();
+
+    void LoadBuffer() override;
+
+    ExecutionContext FlushBuffer(ExecutionContext exctx) override;
+
+    ExecutionContext UploadTexture(ExecutionContext exctx) override {
+        // There is no host texture to upload to
+        return exctx;
+    }
+
+    /// Copies a region of another surface into this one, reinterpreting its texels.
+    void CopyFrom(const CachedSurface& src_surface, const VideoCommon::CopyParams& copy_params);
+
+    /// Copies a rectangle of another surface into a rectangle of this one, scaling it with nearest
+    /// filtering. Returns false when the texels of the surfaces can't be copied as raw bytes.
+    bool BlitFrom(const CachedSurface& src_surface, const Common::Rectangle<u32>& src_rect,
+                  const Common::Rectangle<u32>& dst_rect);
+
+protected:
+    std::unique_ptr<CachedSurfaceView> CreateView(const ViewKey& view_key) override;
+
+private:
+    /// Copies a mipmap level between guest memory and the staging buffer.
+    void SwizzleLevel(VideoCore::MortonSwizzleMode mode, u32 level);
+
+    std::vector<u8> staging_buffer;
+};
+
+class CachedSurfaceView final {
+public:
+    explicit CachedSurfaceView(CachedSurface& surface, ViewKey key);
+    ~CachedSurfaceView();
+
+    CachedSurface& GetSurface() const {
+        return surface;
+    }
+
+    const ViewKey& GetKey() const {
+        return key;
+    }
+
+    /// Marks the surface owning this view as modified by the GPU.
+    void MarkAsModified(bool is_modified) {
+        surface.MarkAsModified(is_modified);
+    }
+
+private:
+    CachedSurface& surface;
+    const ViewKey key;
+};
+
+class TextureCacheNull final : public TextureCacheBase {
+public:
+    explicit TextureCacheNull(Core::System& system, VideoCore::RasterizerInterface& rasterizer);
+    ~TextureCacheNull();
+
+protected:
+    std::tuple<CachedSurfaceView*, ExecutionContext> TryFastGetSurfaceView(
+        ExecutionContext exctx, VAddr cpu_addr, u8* host_ptr, const SurfaceParams& params,
+        bool preserve_contents, const std::vector<CachedSurface*>& overlaps) override;
+
+    std::unique_ptr<CachedSurface> CreateSurface(const SurfaceParams& params) override;
+
+    ExecutionContext CopyImage(ExecutionContext exctx, CachedSurface& src_surface,
+                               CachedSurface& dst_surface,
+                               const VideoCommon::CopyParams& copy_params) override;
+};
+
+} // namespace Null
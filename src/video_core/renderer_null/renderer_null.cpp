@@ -0,0 +1,77 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "common/logging/log.h"
+#include "common/telemetry.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/frontend/emu_window.h"
+#include "core/memory.h"
+#include "core/perf_stats.h"
+#include "core/telemetry_session.h"
+#include "video_core/morton.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+namespace Null {
+
+RendererNull::RendererNull(Core::Frontend::EmuWindow& window, Core::System& system)
+    : VideoCore::RendererBase{window}, system{system} {}
+
+RendererNull::~RendererNull() = default;
+
+void RendererNull::SwapBuffers(
+    std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) {
+
+    system.GetPerfStats().EndSystemFrame();
+
+    if (framebuffer) {
+        LoadFramebuffer(*framebuffer);
+
+        if (renderer_settings.screenshot_requested) {
+            LOG_WARNING(Render, "Screenshots are not supported by the null renderer");
+            renderer_settings.screenshot_requested = false;
+        }
+
+        m_current_frame++;
+    }
+
+    render_window.PollEvents();
+
+    system.FrameLimiter().DoFrameLimiting(system.CoreTiming().GetGlobalTimeUs());
+    system.GetPerfStats().BeginSystemFrame();
+}
+
+void RendererNull::LoadFramebuffer(const Tegra::FramebufferConfig& framebuffer) {
+    const u32 bytes_per_pixel{Tegra::FramebufferConfig::BytesPerPixel(framebuffer.pixel_format)};
+    const u64 size_in_bytes{framebuffer.stride * framebuffer.height * bytes_per_pixel};
+    const VAddr framebuffer_addr{framebuffer.address + framebuffer.offset};
+    u8* const host_ptr{Memory::GetPointer(framebuffer_addr)};
+    if (host_ptr == nullptr) {
+        LOG_ERROR(Render, "Framebuffer at 0x{:016X} is not mapped", framebuffer_addr);
+        return;
+    }
+
+    rasterizer->FlushRegion(ToCacheAddr(host_ptr), size_in_bytes);
+
+    constexpr u32 linear_bpp = 4;
+    framebuffer_data.resize(framebuffer.stride * framebuffer.height * linear_bpp);
+    VideoCore::MortonCopyPixels128(VideoCore::MortonSwizzleMode::MortonToLinear,
+                                   framebuffer.width, framebuffer.height, bytes_per_pixel,
+                                   linear_bpp, host_ptr, framebuffer_data.data());
+}
+
+bool RendererNull::Init() {
+    LOG_INFO(Render, "Using the null renderer, nothing will be presented");
+    system.TelemetrySession().AddField(Telemetry::FieldType::UserSystem, "GPU_Renderer", "Null");
+
+    rasterizer = std::make_unique<RasterizerNull>(system);
+    return true;
+}
+
+void RendererNull::ShutDown() {}
+
+} // namespace Null
@@ -0,0 +1,52 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/renderer_base.h"
+
+namespace Core {
+class System;
+}
+
+namespace Core::Frontend {
+class EmuWindow;
+}
+
+namespace Null {
+
+/**
+ * Renderer that doesn't present anything. Presented framebuffers are still flushed and read back
+ * from guest memory, so the CPU cost of a frame matches the one of the hardware renderers. It
+ * doesn't need a graphics context, so it can be used on headless machines.
+ */
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& window, Core::System& system);
+    ~RendererNull() override;
+
+    /// Swap buffers (render frame)
+    void SwapBuffers(
+        std::optional<std::reference_wrapper<const Tegra::FramebufferConfig>> framebuffer) override;
+
+    /// Initialize the renderer
+    bool Init() override;
+
+    /// Shutdown the renderer
+    void ShutDown() override;
+
+private:
+    /// Reads the framebuffer from emulated memory, like a presenting renderer would.
+    void LoadFramebuffer(const Tegra::FramebufferConfig& framebuffer);
+
+    Core::System& system;
+
+    /// Linear copy of the last presented framebuffer
+    std::vector<u8> framebuffer_data;
+};
+
+} // namespace Null
@@ -13,16 +13,17 @@
 
 namespace OpenGL {
 
-CachedBufferEntry::CachedBufferEntry(VAddr cpu_addr, std::size_t size, GLintptr offset,
-                                     std::size_t alignment, u8* host_ptr)
-    : RasterizerCacheObject{host_ptr}, cpu_addr{cpu_addr}, size{size}, offset{offset},
-      alignment{alignment} {}
+/// Size of the cached buffers above which the least recently used ones are evicted
+constexpr std::size_t CACHED_BUFFERS_BUDGET = 256 * 1024 * 1024;
 
 OGLBufferCache::OGLBufferCache(RasterizerOpenGL& rasterizer, std::size_t size)
-    : RasterizerCache{rasterizer}, stream_buffer(size, true) {}
+    : VideoCommon::BufferCache<OGLBuffer, GLuint>{rasterizer, CACHED_BUFFERS_BUDGET},
+      stream_buffer(size, true) {}
 
-GLintptr OGLBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size, std::size_t alignment,
-                                      bool cache) {
+OGLBufferCache::~OGLBufferCache() = default;
+
+OGLBufferCache::BufferInfo OGLBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size,
+                                                        std::size_t alignment, bool cache) {
     auto& memory_manager = Core::System::GetInstance().GPU().MemoryManager();
 
     // Cache management is a big overhead, so only cache entries with a given size.
@@ -30,34 +31,25 @@ GLintptr OGLBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size, std::
     cache &= size >= 2048;
 
     const auto& host_ptr{memory_manager.GetPointer(gpu_addr)};
-    if (cache) {
-        auto entry = TryGet(host_ptr);
-        if (entry) {
-            if (entry->GetSize() >= size && entry->GetAlignment() == alignment) {
-                return entry->GetOffset();
-            }
-            Unregister(entry);
-        }
+    if (cache && host_ptr) {
+        // Cached ranges always start at the beginning of their buffer, which satisfies any
+        // alignment
+        return VideoCommon::BufferCache<OGLBuffer, GLuint>::UploadMemory(
+            host_ptr, *memory_manager.GpuToCpuAddress(gpu_addr), size);
     }
 
     AlignBuffer(alignment);
     const GLintptr uploaded_offset = buffer_offset;
 
     if (!host_ptr) {
-        return uploaded_offset;
+        return {stream_buffer.GetHandle(), uploaded_offset};
     }
 
     std::memcpy(buffer_ptr, host_ptr, size);
     buffer_ptr += size;
     buffer_offset += size;
 
-    if (cache) {
-        auto entry = std::make_shared<CachedBufferEntry>(
-            *memory_manager.GpuToCpuAddress(gpu_addr), size, uploaded_offset, alignment, host_ptr);
-        Register(entry);
-    }
-
-    return uploaded_offset;
+    return {stream_buffer.GetHandle(), uploaded_offset};
 }
 
 GLintptr OGLBufferCache::UploadHostMemory(const void* raw_pointer, std::size_t size,
@@ -87,10 +79,9 @@ bool OGLBufferCache::Map(std::size_t max_size) {
         stream_buffer.Map(static_cast<GLsizeiptr>(max_size), 4);
     buffer_offset = buffer_offset_base;
 
-    if (invalidate) {
-        InvalidateAll();
-    }
-    return invalidate;
+    // Buffers bound from evicted blocks have to be bound again, like the stream buffer's
+    const bool evicted = EvictOverBudget();
+    return invalidate || evicted;
 }
 
 void OGLBufferCache::Unmap() {
@@ -101,6 +92,30 @@ GLuint OGLBufferCache::GetHandle() const {
     return stream_buffer.GetHandle();
 }
 
+OGLBuffer OGLBufferCache::CreateBuffer(std::size_t size) {
+    OGLBuffer buffer;
+    buffer.Create();
+    glNamedBufferData(buffer.handle, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+    return buffer;
+}
+
+GLuint OGLBufferCache::ToHandle(const OGLBuffer& buffer) const {
+    return buffer.handle;
+}
+
+void OGLBufferCache::UploadBufferData(const OGLBuffer& buffer, std::size_t offset, std::size_t size,
+                                      const u8* data) {
+    glNamedBufferSubData(buffer.handle, static_cast<GLintptr>(offset),
+                         static_cast<GLsizeiptr>(size), data);
+}
+
+void OGLBufferCache::CopyBufferData(const OGLBuffer& src, const OGLBuffer& dst,
+                                    std::size_t src_offset, std::size_t dst_offset,
+                                    std::size_t size) {
+    glCopyNamedBufferSubData(src.handle, dst.handle, static_cast<GLintptr>(src_offset),
+                             static_cast<GLintptr>(dst_offset), static_cast<GLsizeiptr>(size));
+}
+
 void OGLBufferCache::AlignBuffer(std::size_t alignment) {
     // Align the offset, not the mapped pointer
     const GLintptr offset_aligned =
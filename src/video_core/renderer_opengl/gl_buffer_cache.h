@@ -9,7 +9,7 @@
 #include <tuple>
 
 #include "common/common_types.h"
-#include "video_core/rasterizer_cache.h"
+#include "video_core/buffer_cache.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_stream_buffer.h"
 
@@ -17,49 +17,15 @@ namespace OpenGL {
 
 class RasterizerOpenGL;
 
-class CachedBufferEntry final : public RasterizerCacheObject {
-public:
-    explicit CachedBufferEntry(VAddr cpu_addr, std::size_t size, GLintptr offset,
-                               std::size_t alignment, u8* host_ptr);
-
-    VAddr GetCpuAddr() const override {
-        return cpu_addr;
-    }
-
-    std::size_t GetSizeInBytes() const override {
-        return size;
-    }
-
-    std::size_t GetSize() const {
-        return size;
-    }
-
-    GLintptr GetOffset() const {
-        return offset;
-    }
-
-    std::size_t GetAlignment() const {
-        return alignment;
-    }
-
-    // We do not have to flush this cache as things in it are never modified by us.
-    void Flush() override {}
-
-private:
-    VAddr cpu_addr{};
-    std::size_t size{};
-    GLintptr offset{};
-    std::size_t alignment{};
-};
-
-class OGLBufferCache final : public RasterizerCache<std::shared_ptr<CachedBufferEntry>> {
+class OGLBufferCache final : public VideoCommon::BufferCache<OGLBuffer, GLuint> {
 public:
     explicit OGLBufferCache(RasterizerOpenGL& rasterizer, std::size_t size);
+    ~OGLBufferCache();
 
-    /// Uploads data from a guest GPU address. Returns host's buffer offset where it's been
-    /// allocated.
-    GLintptr UploadMemory(GPUVAddr gpu_addr, std::size_t size, std::size_t alignment = 4,
-                          bool cache = true);
+    /// Uploads data from a guest GPU address. Returns the host buffer and the offset inside of it
+    /// where the data can be read from.
+    BufferInfo UploadMemory(GPUVAddr gpu_addr, std::size_t size, std::size_t alignment = 4,
+                            bool cache = true);
 
     /// Uploads from a host memory. Returns host's buffer offset where it's been allocated.
     GLintptr UploadHostMemory(const void* raw_pointer, std::size_t size, std::size_t alignment = 4);
@@ -67,12 +33,25 @@ public:
     /// Reserves memory to be used by host's CPU. Returns mapped address and offset.
     std::tuple<u8*, GLintptr> ReserveMemory(std::size_t size, std::size_t alignment = 4);
 
+    /// Maps the stream buffer and starts a new draw. Returns true if buffers bound by previous
+    /// draws were invalidated and have to be bound again.
     bool Map(std::size_t max_size);
     void Unmap();
 
+    /// Returns the handle of the stream buffer, used by uploads that are not cached
     GLuint GetHandle() const;
 
 protected:
+    OGLBuffer CreateBuffer(std::size_t size) override;
+
+    GLuint ToHandle(const OGLBuffer& buffer) const override;
+
+    void UploadBufferData(const OGLBuffer& buffer, std::size_t offset, std::size_t size,
+                          const u8* data) override;
+
+    void CopyBufferData(const OGLBuffer& src, const OGLBuffer& dst, std::size_t src_offset,
+                        std::size_t dst_offset, std::size_t size) override;
+
     void AlignBuffer(std::size_t alignment);
 
 private:
@@ -99,8 +99,9 @@ struct FramebufferCacheKey {
 };
 
 RasterizerOpenGL::RasterizerOpenGL(Core::System& system, ScreenInfo& info)
-    : res_cache{*this}, shader_cache{*this, system, device}, global_cache{*this}, system{system},
-      screen_info{info}, buffer_cache(*this, STREAM_BUFFER_SIZE) {
+    : res_cache{*this}, shader_cache{*this, system, device}, global_cache{*this},
+      texture_descriptor_cache{system, *this}, system{system}, screen_info{info},
+      buffer_cache(*this, STREAM_BUFFER_SIZE) {
     OpenGLState::ApplyDefaultState();
 
     shader_program_manager = std::make_unique<GLShader::ProgramManager>();
@@ -150,8 +151,6 @@ GLuint RasterizerOpenGL::SetupVertexFormat() {
         state.draw.vertex_array = vao;
         state.ApplyVertexArrayState();
 
-        glVertexArrayElementBuffer(vao, buffer_cache.GetHandle());
-
         // Use the vertex array as-is, assumes that the data is formatted correctly for OpenGL.
         // Enables the first 16 vertex attributes always, as we don't know which ones are actually
         // used until shader time. Note, Tegra technically supports 32, but we're capping this to 16
@@ -218,10 +217,10 @@ void RasterizerOpenGL::SetupVertexBuffer(GLuint vao) {
 
         ASSERT(end > start);
         const u64 size = end - start + 1;
-        const GLintptr vertex_buffer_offset = buffer_cache.UploadMemory(start, size);
+        const auto [vertex_buffer, vertex_buffer_offset] = buffer_cache.UploadMemory(start, size);
 
         // Bind the vertex array to the buffer at the current offset.
-        glVertexArrayVertexBuffer(vao, index, buffer_cache.GetHandle(), vertex_buffer_offset,
+        glVertexArrayVertexBuffer(vao, index, vertex_buffer, vertex_buffer_offset,
                                   vertex_array.stride);
 
         if (regs.instanced_arrays.IsInstancingEnabled(index) && vertex_array.divisor != 0) {
@@ -264,6 +263,8 @@ DrawParameters RasterizerOpenGL::SetupDraw() {
             params.index_buffer_offset =
                 primitive_assembler.MakeQuadArray(regs.vertex_buffer.first, params.count);
         }
+        // Generated indices are written to the stream buffer
+        glVertexArrayElementBuffer(state.draw.vertex_array, buffer_cache.GetHandle());
         return params;
     }
 
@@ -274,8 +275,10 @@ DrawParameters RasterizerOpenGL::SetupDraw() {
         MICROPROFILE_SCOPE(OpenGL_Index);
         params.index_format = MaxwellToGL::IndexFormat(regs.index_array.format);
         params.count = regs.index_array.count;
-        params.index_buffer_offset =
+        const auto [index_buffer, index_buffer_offset] =
             buffer_cache.UploadMemory(regs.index_array.IndexStart(), CalculateIndexBufferSize());
+        glVertexArrayElementBuffer(state.draw.vertex_array, index_buffer);
+        params.index_buffer_offset = static_cast<GLintptr>(index_buffer_offset);
         params.base_vertex = static_cast<GLint>(regs.vb_element_base);
     } else {
         params.count = regs.vertex_buffer.count;
@@ -719,7 +722,7 @@ void RasterizerOpenGL::DrawArrays() {
 
     const bool invalidate = buffer_cache.Map(buffer_size);
     if (invalidate) {
-        // As all cached buffers are invalidated, we need to recheck their state.
+        // Buffers bound by previous draws may be gone, we need to recheck their state.
         gpu.dirty_flags.vertex_array.set();
     }
 
@@ -761,6 +764,7 @@ void RasterizerOpenGL::InvalidateRegion(CacheAddr addr, u64 size) {
     shader_cache.InvalidateRegion(addr, size);
     global_cache.InvalidateRegion(addr, size);
     buffer_cache.InvalidateRegion(addr, size);
+    texture_descriptor_cache.InvalidateRegion(addr, size);
 }
 
 void RasterizerOpenGL::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
@@ -847,10 +851,10 @@ void RasterizerOpenGL::SetupConstBuffers(Tegra::Engines::Maxwell3D::Regs::Shader
         size = Common::AlignUp(size, sizeof(GLvec4));
         ASSERT_MSG(size <= MaxConstbufferSize, "Constbuffer too big");
 
-        const GLintptr const_buffer_offset =
+        const auto [const_buffer, const_buffer_offset] =
             buffer_cache.UploadMemory(buffer.address, size, device.GetUniformBufferAlignment());
 
-        bind_ubo_pushbuffer.Push(buffer_cache.GetHandle(), const_buffer_offset, size);
+        bind_ubo_pushbuffer.Push(const_buffer, static_cast<GLintptr>(const_buffer_offset), size);
     }
 }
 
@@ -879,29 +883,82 @@ void RasterizerOpenGL::SetupTextures(Maxwell::ShaderStage stage, const Shader& s
     ASSERT_MSG(base_bindings.sampler + entries.size() <= std::size(state.texture_units),
                "Exceeded the number of active textures.");
 
+    auto& cache = stage_textures[static_cast<std::size_t>(stage)];
+    const GPUVAddr tic_address = maxwell3d.regs.tic.TICAddress();
+    const GPUVAddr tsc_address = maxwell3d.regs.tsc.TSCAddress();
+    const u64 descriptor_generation = texture_descriptor_cache.GetGeneration();
+    const u64 surface_generation = res_cache.GetRegistryGeneration();
+    bool is_cache_valid = cache.shader == shader && cache.base_binding == base_bindings.sampler &&
+                          cache.tic_address == tic_address && cache.tsc_address == tsc_address &&
+                          cache.descriptor_generation == descriptor_generation &&
+                          cache.surface_generation == surface_generation;
+
+    // Texture handles live in const buffers, they are the only thing read on every draw
+    cache.handles.resize(entries.size());
     for (u32 bindpoint = 0; bindpoint < entries.size(); ++bindpoint) {
         const auto& entry = entries[bindpoint];
-        Tegra::Texture::FullTextureInfo texture;
+        u32 handle;
         if (entry.IsBindless()) {
             const auto cbuf = entry.GetBindlessCBuf();
-            Tegra::Texture::TextureHandle tex_handle;
-            tex_handle.raw = maxwell3d.AccessConstBuffer32(stage, cbuf.first, cbuf.second);
-            texture = maxwell3d.GetTextureInfo(tex_handle, entry.GetOffset());
+            handle = maxwell3d.AccessConstBuffer32(stage, cbuf.first, cbuf.second);
         } else {
-            texture = maxwell3d.GetStageTexture(stage, entry.GetOffset());
+            handle = maxwell3d.GetStageTextureHandle(stage, entry.GetOffset()).raw;
+        }
+        if (cache.handles[bindpoint] != handle) {
+            cache.handles[bindpoint] = handle;
+            is_cache_valid = false;
         }
-        const u32 current_bindpoint = base_bindings.sampler + bindpoint;
+    }
+    if (is_cache_valid) {
+        is_cache_valid = std::none_of(cache.textures.begin(), cache.textures.end(),
+                                      [](const CachedTexture& texture) {
+                                          return texture.surface && texture.surface->MustReload();
+                                      });
+    }
 
-        state.texture_units[current_bindpoint].sampler = sampler_cache.GetSampler(texture.tsc);
+    if (!is_cache_valid) {
+        // Generations are taken before resolving the bindings, if a lookup changes the caches the
+        // bindings will be resolved again on the next draw
+        cache.shader = shader;
+        cache.base_binding = base_bindings.sampler;
+        cache.tic_address = tic_address;
+        cache.tsc_address = tsc_address;
+        cache.descriptor_generation = descriptor_generation;
+        cache.surface_generation = surface_generation;
+        cache.textures.resize(entries.size());
+
+        for (u32 bindpoint = 0; bindpoint < entries.size(); ++bindpoint) {
+            const auto& entry = entries[bindpoint];
+            Tegra::Texture::TextureHandle tex_handle;
+            tex_handle.raw = cache.handles[bindpoint];
+            const Tegra::Texture::FullTextureInfo texture =
+                texture_descriptor_cache.GetTextureInfo(tex_handle, entry.GetOffset());
+
+            auto& cached_texture = cache.textures[bindpoint];
+            cached_texture.sampler = sampler_cache.GetSampler(texture.tsc);
+            cached_texture.surface = res_cache.GetTextureSurface(texture, entry);
+            if (cached_texture.surface) {
+                cached_texture.texture = cached_texture.surface->Texture(entry.IsArray()).handle;
+            } else {
+                // Can occur when texture addr is null or its memory is unmapped/invalid
+                cached_texture.texture = 0;
+            }
+            cached_texture.x_source = texture.tic.x_source;
+            cached_texture.y_source = texture.tic.y_source;
+            cached_texture.z_source = texture.tic.z_source;
+            cached_texture.w_source = texture.tic.w_source;
+        }
+    }
 
-        if (Surface surface = res_cache.GetTextureSurface(texture, entry); surface) {
-            state.texture_units[current_bindpoint].texture =
-                surface->Texture(entry.IsArray()).handle;
-            surface->UpdateSwizzle(texture.tic.x_source, texture.tic.y_source, texture.tic.z_source,
-                                   texture.tic.w_source);
-        } else {
-            // Can occur when texture addr is null or its memory is unmapped/invalid
-            state.texture_units[current_bindpoint].texture = 0;
+    for (u32 bindpoint = 0; bindpoint < entries.size(); ++bindpoint) {
+        const auto& cached_texture = cache.textures[bindpoint];
+        auto& unit = state.texture_units[base_bindings.sampler + bindpoint];
+        unit.sampler = cached_texture.sampler;
+        unit.texture = cached_texture.texture;
+        // Other stages may have changed the swizzle of a shared surface, apply it every draw
+        if (cached_texture.surface) {
+            cached_texture.surface->UpdateSwizzle(cached_texture.x_source, cached_texture.y_source,
+                                                  cached_texture.z_source, cached_texture.w_source);
         }
     }
 }
@@ -12,6 +12,7 @@
 #include <optional>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <boost/icl/interval_map.hpp>
 #include <glad/glad.h>
@@ -31,6 +32,7 @@
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_state.h"
 #include "video_core/renderer_opengl/utils.h"
+#include "video_core/texture_descriptor_cache.h"
 
 namespace Core {
 class System;
@@ -180,6 +182,7 @@ private:
     ShaderCacheOpenGL shader_cache;
     GlobalRegionCacheOpenGL global_cache;
     SamplerCacheOpenGL sampler_cache;
+    VideoCommon::TextureDescriptorCache texture_descriptor_cache;
 
     Core::System& system;
     ScreenInfo& screen_info;
@@ -221,6 +224,30 @@ private:
 
     using CachedPageMap = boost::icl::interval_map<u64, int>;
     CachedPageMap cached_pages;
+
+    struct CachedTexture {
+        Surface surface;
+        GLuint texture{};
+        GLuint sampler{};
+        Tegra::Texture::SwizzleSource x_source{};
+        Tegra::Texture::SwizzleSource y_source{};
+        Tegra::Texture::SwizzleSource z_source{};
+        Tegra::Texture::SwizzleSource w_source{};
+    };
+
+    /// Texture bindings resolved by the last draw of a shader stage. They are reused as long as
+    /// the texture handles and the descriptor and surface caches didn't change since then.
+    struct StageTextures {
+        Shader shader;
+        u32 base_binding{};
+        GPUVAddr tic_address{};
+        GPUVAddr tsc_address{};
+        u64 descriptor_generation{};
+        u64 surface_generation{};
+        std::vector<u32> handles;
+        std::vector<CachedTexture> textures;
+    };
+    std::array<StageTextures, Tegra::Engines::Maxwell3D::Regs::MaxShaderStage> stage_textures;
 };
 
 } // namespace OpenGL
@@ -479,12 +479,19 @@ void RasterizerCacheOpenGL::FastCopySurface(const Surface& src_surface,
     const auto& src_params{src_surface->GetSurfaceParams()};
     const auto& dst_params{dst_surface->GetSurfaceParams()};
 
-    const u32 width{std::min(src_params.width, dst_params.width)};
-    const u32 height{std::min(src_params.height, dst_params.height)};
-
-    glCopyImageSubData(src_surface->Texture().handle, SurfaceTargetToGL(src_params.target), 0, 0, 0,
-                       0, dst_surface->Texture().handle, SurfaceTargetToGL(dst_params.target), 0, 0,
-                       0, 0, width, height, 1);
+    // Copy every level and layer both surfaces have, so layered and 3D surfaces reinterpreted with
+    // the same layout don't have to go through guest memory
+    const u32 num_levels{std::min(src_params.max_mip_level, dst_params.max_mip_level)};
+    for (u32 level = 0; level < num_levels; ++level) {
+        const u32 width{std::min(src_params.MipWidth(level), dst_params.MipWidth(level))};
+        const u32 height{std::min(src_params.MipHeight(level), dst_params.MipHeight(level))};
+        const u32 depth{std::min(src_params.MipDepth(level), dst_params.MipDepth(level))};
+
+        glCopyImageSubData(src_surface->Texture().handle, SurfaceTargetToGL(src_params.target),
+                           level, 0, 0, 0, dst_surface->Texture().handle,
+                           SurfaceTargetToGL(dst_params.target), level, 0, 0, 0, width, height,
+                           depth);
+    }
 
     dst_surface->MarkAsModified(true, *this);
 }
@@ -577,9 +584,10 @@ void RasterizerCacheOpenGL::CopySurface(const Surface& src_surface, const Surfac
     dst_surface->MarkAsModified(true, *this);
 }
 
-CachedSurface::CachedSurface(const SurfaceParams& params)
+CachedSurface::CachedSurface(const SurfaceParams& params, SwizzlePass* swizzle_pass)
     : RasterizerCacheObject{params.host_ptr}, params{params},
-      gl_target{SurfaceTargetToGL(params.target)}, cached_size_in_bytes{params.size_in_bytes} {
+      gl_target{SurfaceTargetToGL(params.target)}, cached_size_in_bytes{params.size_in_bytes},
+      swizzle_pass{swizzle_pass} {
 
     const auto optional_cpu_addr{
         Core::System::GetInstance().GPU().MemoryManager().GpuToCpuAddress(params.gpu_addr)};
@@ -676,6 +684,10 @@ void CachedSurface::FlushGLBuffer() {
 
     ASSERT_MSG(!IsPixelFormatASTC(params.pixel_format), "Unimplemented");
 
+    if (FlushWithSwizzlePass()) {
+        return;
+    }
+
     // OpenGL temporary buffer needs to be big enough to store raw texture size
     gl_buffer.resize(1);
     gl_buffer[0].resize(GetSizeInBytes());
@@ -713,6 +725,90 @@ void CachedSurface::FlushGLBuffer() {
     }
 }
 
+bool CachedSurface::LoadWithSwizzlePass() {
+    if (!swizzle_pass || !IsSwizzlePassCompatible()) {
+        return false;
+    }
+    MICROPROFILE_SCOPE(OpenGL_SurfaceLoad);
+
+    // Each level is unswizzled to its own region of the linear buffer, size it before the first
+    // level is written
+    std::size_t linear_size = 0;
+    for (u32 i = 0; i < params.max_mip_level; i++) {
+        linear_size += params.MipWidth(i) * params.MipHeight(i) *
+                       GetBytesPerPixel(params.pixel_format);
+    }
+    const GLuint linear_buffer{swizzle_pass->GetLinearBuffer(linear_size)};
+
+    const FormatTuple& tuple = GetFormatTuple(params.pixel_format, params.component_type);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, linear_buffer);
+
+    std::size_t linear_offset = 0;
+    for (u32 i = 0; i < params.max_mip_level; i++) {
+        const SwizzleParams swizzle_params{GetSwizzleParams(i)};
+        swizzle_pass->Unswizzle(params.host_ptr + params.GetMipmapLevelOffset(i),
+                               params.GetMipmapSingleSize(i), linear_offset, swizzle_params);
+
+        const auto& rect{params.GetRect(i)};
+        glTextureSubImage2D(texture.handle, i, 0, 0, static_cast<GLsizei>(rect.GetWidth()),
+                            static_cast<GLsizei>(rect.GetHeight()), tuple.format, tuple.type,
+                            reinterpret_cast<const void*>(linear_offset));
+        linear_offset += swizzle_params.width * swizzle_params.height *
+                         swizzle_params.bytes_per_pixel;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+bool CachedSurface::FlushWithSwizzlePass() {
+    if (!swizzle_pass || !IsSwizzlePassCompatible()) {
+        return false;
+    }
+
+    // Only the first level is flushed, like in the CPU path
+    const SwizzleParams swizzle_params{GetSwizzleParams(0)};
+    const std::size_t linear_size{swizzle_params.width * swizzle_params.height *
+                                  swizzle_params.bytes_per_pixel};
+    const GLuint linear_buffer{swizzle_pass->GetLinearBuffer(linear_size)};
+
+    const FormatTuple& tuple = GetFormatTuple(params.pixel_format, params.component_type);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, linear_buffer);
+    glGetTextureImage(texture.handle, 0, tuple.format, tuple.type,
+                      static_cast<GLsizei>(linear_size), nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    swizzle_pass->Swizzle(params.host_ptr, params.GetMipmapSingleSize(0), swizzle_params);
+    return true;
+}
+
+bool CachedSurface::IsSwizzlePassCompatible() const {
+    // Formats converted on the CPU and compressed formats are left to the CPU path
+    if (!params.is_tiled || params.block_width != 1 || params.target != SurfaceTarget::Texture2D ||
+        IsPixelFormatASTC(params.pixel_format) || params.pixel_format == PixelFormat::S8Z24 ||
+        GetFormatTuple(params.pixel_format, params.component_type).compressed) {
+        return false;
+    }
+    for (u32 i = 0; i < params.max_mip_level; i++) {
+        if (!SwizzlePass::IsSupported(GetSwizzleParams(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SwizzleParams CachedSurface::GetSwizzleParams(u32 mip_level) const {
+    return {params.MipWidth(mip_level),
+            params.MipHeight(mip_level),
+            1,
+            GetBytesPerPixel(params.pixel_format),
+            params.MipBlockHeight(mip_level),
+            params.MipBlockDepth(mip_level),
+            params.tile_width_spacing};
+}
+
 void CachedSurface::UploadGLMipmapTexture(u32 mip_map, GLuint read_fb_handle,
                                           GLuint draw_fb_handle) {
     const auto& rect{params.GetRect(mip_map)};
@@ -876,6 +972,9 @@ RasterizerCacheOpenGL::RasterizerCacheOpenGL(RasterizerOpenGL& rasterizer)
     read_framebuffer.Create();
     draw_framebuffer.Create();
     copy_pbo.Create();
+    if (Settings::values.use_gpu_swizzle) {
+        swizzle_pass = std::make_unique<SwizzlePass>();
+    }
 }
 
 Surface RasterizerCacheOpenGL::GetTextureSurface(const Tegra::Texture::FullTextureInfo& config,
@@ -929,8 +1028,10 @@ Surface RasterizerCacheOpenGL::GetColorBufferSurface(std::size_t index, bool pre
 }
 
 void RasterizerCacheOpenGL::LoadSurface(const Surface& surface) {
-    surface->LoadGLBuffer();
-    surface->UploadGLTexture(read_framebuffer.handle, draw_framebuffer.handle);
+    if (!surface->LoadWithSwizzlePass()) {
+        surface->LoadGLBuffer();
+        surface->UploadGLTexture(read_framebuffer.handle, draw_framebuffer.handle);
+    }
     surface->MarkAsModified(false, *this);
     surface->MarkForReload(false);
 }
@@ -980,7 +1081,7 @@ Surface RasterizerCacheOpenGL::GetUncachedSurface(const SurfaceParams& params) {
     Surface surface{TryGetReservedSurface(params)};
     if (!surface) {
         // No reserved surface available, create a new one and reserve it
-        surface = std::make_shared<CachedSurface>(params);
+        surface = std::make_shared<CachedSurface>(params, swizzle_pass.get());
         ReserveSurface(surface);
     }
     return surface;
@@ -1201,9 +1302,20 @@ Surface RasterizerCacheOpenGL::RecreateSurface(const Surface& old_surface,
     const bool compatible_formats =
         GetFormatBpp(old_params.pixel_format) == GetFormatBpp(new_params.pixel_format) &&
         !(old_compressed || new_compressed);
+    // Surfaces with the same dimensions and tiling keep the same layer and level strides in guest
+    // memory, so their levels and layers can be copied as they are
+    const bool same_size = old_params.width == new_params.width &&
+                           old_params.height == new_params.height &&
+                           old_params.max_mip_level == new_params.max_mip_level;
+    const bool same_tiling =
+        old_params.is_tiled == new_params.is_tiled &&
+        (!old_params.is_tiled || (old_params.block_height == new_params.block_height &&
+                                  old_params.block_depth == new_params.block_depth &&
+                                  old_params.tile_width_spacing == new_params.tile_width_spacing));
+    const bool same_layout = same_size && same_tiling;
     // For compatible surfaces, we can just do fast glCopyImageSubData based copy
     if (old_params.target == new_params.target && old_params.depth == new_params.depth &&
-        old_params.depth == 1 && compatible_formats) {
+        (old_params.depth == 1 || same_layout) && compatible_formats) {
         FastCopySurface(old_surface, new_surface);
         return new_surface;
     }
@@ -20,6 +20,7 @@
 #include "video_core/rasterizer_cache.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_gen.h"
+#include "video_core/renderer_opengl/gl_swizzle_pass.h"
 #include "video_core/surface.h"
 #include "video_core/textures/decoders.h"
 #include "video_core/textures/texture.h"
@@ -357,7 +358,8 @@ class RasterizerOpenGL;
 
 class CachedSurface final : public RasterizerCacheObject {
 public:
-    explicit CachedSurface(const SurfaceParams& params);
+    /// swizzle_pass is null when tiled surfaces have to be processed by the CPU.
+    explicit CachedSurface(const SurfaceParams& params, SwizzlePass* swizzle_pass);
 
     VAddr GetCpuAddr() const override {
         return cpu_addr;
@@ -403,6 +405,11 @@ public:
     // Upload data in gl_buffer to this surface's texture
     void UploadGLTexture(GLuint read_fb_handle, GLuint draw_fb_handle);
 
+    /// Loads the surface from Switch memory unswizzling it on the GPU. Returns false when the
+    /// swizzle pass is disabled or can't process the surface, LoadGLBuffer and UploadGLTexture
+    /// have to be used.
+    bool LoadWithSwizzlePass();
+
     void UpdateSwizzle(Tegra::Texture::SwizzleSource swizzle_x,
                        Tegra::Texture::SwizzleSource swizzle_y,
                        Tegra::Texture::SwizzleSource swizzle_z,
@@ -433,6 +440,15 @@ private:
 
     void EnsureTextureDiscrepantView();
 
+    /// Flushes the surface to Switch memory swizzling it on the GPU. Returns false when the
+    /// swizzle pass is disabled or can't process the surface.
+    bool FlushWithSwizzlePass();
+
+    /// Returns true if the swizzle pass can process every level of the surface.
+    bool IsSwizzlePassCompatible() const;
+
+    SwizzleParams GetSwizzleParams(u32 mip_level) const;
+
     OGLTexture texture;
     OGLTexture discrepant_view;
     std::vector<std::vector<u8>> gl_buffer;
@@ -445,6 +461,7 @@ private:
     bool reinterpreted = false;
     bool must_reload = false;
     VAddr cpu_addr{};
+    SwizzlePass* swizzle_pass;
 };
 
 class RasterizerCacheOpenGL final : public RasterizerCache<Surface> {
@@ -515,6 +532,9 @@ private:
     /// using the new format.
     OGLBuffer copy_pbo;
 
+    /// Swizzles and unswizzles tiled surfaces on the GPU, only created when it's enabled.
+    std::unique_ptr<SwizzlePass> swizzle_pass;
+
     std::array<Surface, Maxwell::NumRenderTargets> last_color_buffers;
     std::array<Surface, Maxwell::NumRenderTargets> current_color_buffers;
     Surface last_depth_buffer;
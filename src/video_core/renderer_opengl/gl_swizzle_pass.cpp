@@ -0,0 +1,203 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <glad/glad.h>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/scope_exit.h"
+#include "video_core/renderer_opengl/gl_state.h"
+#include "video_core/renderer_opengl/gl_swizzle_pass.h"
+
+namespace OpenGL {
+
+MICROPROFILE_DEFINE(OpenGL_SwizzlePass, "OpenGL", "Swizzle Pass", MP_RGB(128, 128, 192));
+
+namespace {
+
+constexpr u32 GOB_SIZE_X = 64;
+constexpr u32 GOB_SIZE_Y = 8;
+constexpr u32 GOB_SIZE = GOB_SIZE_X * GOB_SIZE_Y;
+constexpr u32 WORKGROUP_SIZE_X = 32;
+constexpr u32 WORKGROUP_SIZE_Y = 8;
+
+/// Each invocation moves a 4 byte word. Words never straddle the 16 byte wide columns of a GOB.
+/// GetSwizzledOffset is mirrored by SwizzlePass::GetSwizzledOffset, which is tested against the
+/// CPU swizzler.
+constexpr char SWIZZLE_SHADER[] = R"(#version 430 core
+
+layout (local_size_x = 32, local_size_y = 8, local_size_z = 1) in;
+
+layout (std430, binding = 0) buffer SwizzledBuffer {
+    uint swizzled_data[];
+};
+
+layout (std430, binding = 1) buffer LinearBuffer {
+    uint linear_data[];
+};
+
+// Size of the image, the width is measured in words
+layout (location = 0) uniform uvec3 size;
+// Number of blocks in the horizontal and vertical axes
+layout (location = 1) uniform uvec2 num_blocks;
+// Height and depth of a block in GOBs
+layout (location = 2) uniform uvec2 block_size;
+layout (location = 3) uniform uint linear_offset;
+layout (location = 4) uniform bool unswizzle;
+
+const uint GOB_SIZE_X = 64;
+const uint GOB_SIZE_Y = 8;
+const uint GOB_SIZE = GOB_SIZE_X * GOB_SIZE_Y;
+
+uint GetSwizzledOffset(uint x, uint y, uint z) {
+    const uint block_height = GOB_SIZE_Y * block_size.x;
+    const uint xy_block_size = GOB_SIZE * block_size.x;
+    const uint block_index = (z / block_size.y) * num_blocks.y * num_blocks.x +
+                             (y / block_height) * num_blocks.x + x / GOB_SIZE_X;
+    const uint gob_offset = (z % block_size.y) * xy_block_size +
+                            (y % block_height) / GOB_SIZE_Y * GOB_SIZE;
+    const uint gob_x = x % GOB_SIZE_X;
+    const uint gob_y = y % GOB_SIZE_Y;
+    const uint inner_offset = (gob_x / 32) * 256 + (gob_y / 2) * 64 + ((gob_x % 32) / 16) * 32 +
+                              (gob_y % 2) * 16 + gob_x % 16;
+    return block_index * xy_block_size * block_size.y + gob_offset + inner_offset;
+}
+
+void main() {
+    const uvec3 pos = gl_GlobalInvocationID;
+    if (any(greaterThanEqual(pos, size))) {
+        return;
+    }
+    const uint swizzled_index = GetSwizzledOffset(pos.x * 4, pos.y, pos.z) / 4;
+    const uint linear_index = linear_offset + (pos.z * size.y + pos.y) * size.x + pos.x;
+    if (unswizzle) {
+        linear_data[linear_index] = swizzled_data[swizzled_index];
+    } else {
+        swizzled_data[swizzled_index] = linear_data[linear_index];
+    }
+}
+)";
+
+void GrowBuffer(OGLBuffer& buffer, std::size_t& buffer_size, std::size_t size) {
+    if (size <= buffer_size) {
+        return;
+    }
+    buffer_size = Common::AlignUp(size, 0x10000);
+    glNamedBufferData(buffer.handle, static_cast<GLsizeiptr>(buffer_size), nullptr,
+                      GL_STREAM_COPY);
+}
+
+} // Anonymous namespace
+
+SwizzlePass::SwizzlePass() {
+    shader.Create(SWIZZLE_SHADER, GL_COMPUTE_SHADER);
+    program.Create(false, false, shader.handle);
+    swizzled_buffer.Create();
+    linear_buffer.Create();
+}
+
+SwizzlePass::~SwizzlePass() = default;
+
+bool SwizzlePass::IsSupported(const SwizzleParams& params) {
+    // Texels have to be packed in whole words, both in GOBs and in linear rows
+    switch (params.bytes_per_pixel) {
+    case 1:
+    case 2:
+    case 4:
+    case 8:
+    case 16:
+        return (params.width * params.bytes_per_pixel) % sizeof(u32) == 0;
+    default:
+        return false;
+    }
+}
+
+SwizzleLayout SwizzlePass::GetLayout(const SwizzleParams& params) {
+    const u32 row_size{params.width * params.bytes_per_pixel};
+    const u32 width_alignment{GOB_SIZE_X * std::max(params.width_spacing, 1U)};
+    const u32 block_height{GOB_SIZE_Y * params.block_height};
+    return {row_size / static_cast<u32>(sizeof(u32)),
+            params.height,
+            params.depth,
+            Common::AlignUp(row_size, width_alignment) / GOB_SIZE_X,
+            (params.height + block_height - 1) / block_height,
+            params.block_height,
+            params.block_depth};
+}
+
+u32 SwizzlePass::GetSwizzledOffset(const SwizzleLayout& layout, u32 x, u32 y, u32 z) {
+    const u32 block_height{GOB_SIZE_Y * layout.block_height};
+    const u32 xy_block_size{GOB_SIZE * layout.block_height};
+    const u32 block_index{(z / layout.block_depth) * layout.num_blocks_y * layout.num_blocks_x +
+                          (y / block_height) * layout.num_blocks_x + x / GOB_SIZE_X};
+    const u32 gob_offset{(z % layout.block_depth) * xy_block_size +
+                         (y % block_height) / GOB_SIZE_Y * GOB_SIZE};
+    const u32 gob_x{x % GOB_SIZE_X};
+    const u32 gob_y{y % GOB_SIZE_Y};
+    const u32 inner_offset{(gob_x / 32) * 256 + (gob_y / 2) * 64 + ((gob_x % 32) / 16) * 32 +
+                           (gob_y % 2) * 16 + gob_x % 16};
+    return block_index * xy_block_size * layout.block_depth + gob_offset + inner_offset;
+}
+
+GLuint SwizzlePass::GetLinearBuffer(std::size_t size) {
+    GrowBuffer(linear_buffer, linear_buffer_size, size);
+    return linear_buffer.handle;
+}
+
+void SwizzlePass::Unswizzle(const u8* swizzled_data, std::size_t swizzled_size,
+                            std::size_t linear_offset, const SwizzleParams& params) {
+    UploadSwizzledData(swizzled_data, swizzled_size);
+    GetLinearBuffer(linear_offset + params.width * params.height * params.depth *
+                                        params.bytes_per_pixel);
+    Dispatch(true, linear_offset, params);
+    // The linear buffer is read by pixel transfers and buffer copies
+    glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void SwizzlePass::Swizzle(u8* swizzled_data, std::size_t swizzled_size,
+                          const SwizzleParams& params) {
+    // Upload the current guest data to preserve the bytes that are not overwritten
+    UploadSwizzledData(swizzled_data, swizzled_size);
+    Dispatch(false, 0, params);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetNamedBufferSubData(swizzled_buffer.handle, 0, static_cast<GLsizeiptr>(swizzled_size),
+                            swizzled_data);
+}
+
+void SwizzlePass::UploadSwizzledData(const u8* swizzled_data, std::size_t swizzled_size) {
+    GrowBuffer(swizzled_buffer, swizzled_buffer_size, swizzled_size);
+    glNamedBufferSubData(swizzled_buffer.handle, 0, static_cast<GLsizeiptr>(swizzled_size),
+                         swizzled_data);
+}
+
+void SwizzlePass::Dispatch(bool unswizzle, std::size_t linear_offset,
+                           const SwizzleParams& params) {
+    MICROPROFILE_SCOPE(OpenGL_SwizzlePass);
+    ASSERT(IsSupported(params));
+    ASSERT(linear_offset % sizeof(u32) == 0);
+
+    const SwizzleLayout layout{GetLayout(params)};
+    const GLuint handle{program.handle};
+    glProgramUniform3ui(handle, 0, layout.width_in_words, layout.height, layout.depth);
+    glProgramUniform2ui(handle, 1, layout.num_blocks_x, layout.num_blocks_y);
+    glProgramUniform2ui(handle, 2, layout.block_height, layout.block_depth);
+    glProgramUniform1ui(handle, 3, static_cast<GLuint>(linear_offset / sizeof(u32)));
+    glProgramUniform1ui(handle, 4, unswizzle ? GL_TRUE : GL_FALSE);
+
+    OpenGLState prev_state{OpenGLState::GetCurState()};
+    SCOPE_EXIT({ prev_state.Apply(); });
+
+    OpenGLState state{prev_state};
+    state.draw.shader_program = handle;
+    state.Apply();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, swizzled_buffer.handle);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, linear_buffer.handle);
+    glDispatchCompute((layout.width_in_words + WORKGROUP_SIZE_X - 1) / WORKGROUP_SIZE_X,
+                      (layout.height + WORKGROUP_SIZE_Y - 1) / WORKGROUP_SIZE_Y, layout.depth);
+}
+
+} // namespace OpenGL
@@ -0,0 +1,97 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+
+#include "common/common_types.h"
+#include "video_core/renderer_opengl/gl_resource_manager.h"
+
+namespace OpenGL {
+
+/// Layout of a block linear image processed by the swizzle pass.
+struct SwizzleParams {
+    u32 width;           ///< Width in texels.
+    u32 height;          ///< Height in texels.
+    u32 depth;           ///< Depth in texels.
+    u32 bytes_per_pixel; ///< Size of a texel in bytes.
+    u32 block_height;    ///< Height of a block in GOBs.
+    u32 block_depth;     ///< Depth of a block in GOBs.
+    u32 width_spacing;   ///< Alignment of the width in GOBs.
+};
+
+/// Layout of an image as seen by the swizzle shader, these are the uniforms of a dispatch.
+struct SwizzleLayout {
+    u32 width_in_words; ///< Width of a row in 4 byte words.
+    u32 height;         ///< Height in texels.
+    u32 depth;          ///< Depth in texels.
+    u32 num_blocks_x;   ///< Number of blocks in a row, the width is aligned to the width spacing.
+    u32 num_blocks_y;   ///< Number of blocks in a column.
+    u32 block_height;   ///< Height of a block in GOBs.
+    u32 block_depth;    ///< Depth of a block in GOBs.
+};
+
+/**
+ * Swizzles and unswizzles block linear images with a compute shader, so tiled surfaces don't have
+ * to be processed by the CPU. Guest data goes through a staging buffer, linear data is kept in a
+ * buffer that can be bound as a pixel pack or unpack buffer.
+ */
+class SwizzlePass {
+public:
+    SwizzlePass();
+    ~SwizzlePass();
+
+    /// Returns true if the pass can process the image, the CPU swizzler has to be used otherwise.
+    static bool IsSupported(const SwizzleParams& params);
+
+    /// Returns the layout the shader is dispatched with to process the image.
+    static SwizzleLayout GetLayout(const SwizzleParams& params);
+
+    /**
+     * Returns the offset of a byte of the image in block linear memory. This is a copy of
+     * GetSwizzledOffset in the shader, both have to be kept in sync.
+     * @param x Horizontal coordinate in bytes, the shader only uses multiples of 4.
+     */
+    static u32 GetSwizzledOffset(const SwizzleLayout& layout, u32 x, u32 y, u32 z);
+
+    /// Returns the buffer holding linear data, it's grown to hold at least size bytes.
+    GLuint GetLinearBuffer(std::size_t size);
+
+    /**
+     * Unswizzles guest data into the linear buffer.
+     * @param swizzled_data Block linear data in guest memory.
+     * @param swizzled_size Size in bytes of the block linear data.
+     * @param linear_offset Offset in the linear buffer where tightly packed texels are written.
+     * @param params Layout of the image.
+     */
+    void Unswizzle(const u8* swizzled_data, std::size_t swizzled_size, std::size_t linear_offset,
+                   const SwizzleParams& params);
+
+    /**
+     * Swizzles the tightly packed texels at the beginning of the linear buffer into guest memory.
+     * Bytes of the guest data that don't belong to a texel are preserved.
+     * @param swizzled_data Block linear data in guest memory.
+     * @param swizzled_size Size in bytes of the block linear data.
+     * @param params Layout of the image.
+     */
+    void Swizzle(u8* swizzled_data, std::size_t swizzled_size, const SwizzleParams& params);
+
+private:
+    /// Uploads guest data to the staging buffer.
+    void UploadSwizzledData(const u8* swizzled_data, std::size_t swizzled_size);
+
+    void Dispatch(bool unswizzle, std::size_t linear_offset, const SwizzleParams& params);
+
+    OGLShader shader;
+    OGLProgram program;
+
+    OGLBuffer swizzled_buffer;
+    OGLBuffer linear_buffer;
+    std::size_t swizzled_buffer_size{};
+    std::size_t linear_buffer_size{};
+};
+
+} // namespace OpenGL
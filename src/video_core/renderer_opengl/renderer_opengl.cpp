@@ -9,6 +9,7 @@
 #include <glad/glad.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "common/telemetry.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -97,10 +98,97 @@ static std::array<GLfloat, 3 * 2> MakeOrthographicMatrix(const float width, cons
     return matrix;
 }
 
+FrameMailbox::FrameMailbox() {
+    for (auto& frame : swap_chain) {
+        free_queue.push_back(&frame);
+    }
+}
+
+FrameMailbox::~FrameMailbox() = default;
+
+Frame* FrameMailbox::GetRenderFrame() {
+    std::unique_lock lock{mutex};
+
+    if (Settings::values.present_mode == Settings::PresentMode::VSync) {
+        // Every frame has to be presented, wait for the presenter to catch up
+        free_cv.wait(lock, [this] { return !free_queue.empty() || is_closed; });
+    }
+
+    if (free_queue.empty()) {
+        // The presenter is behind, drop the oldest frame that wasn't presented yet. With one frame
+        // being drawn and at most one being presented, there is always a queued frame here.
+        ASSERT(!present_queue.empty());
+        Frame* const frame = present_queue.front();
+        present_queue.pop_front();
+        return frame;
+    }
+
+    Frame* const frame = free_queue.front();
+    free_queue.pop_front();
+    return frame;
+}
+
+void FrameMailbox::ReleaseRenderFrame(Frame* frame) {
+    {
+        std::lock_guard lock{mutex};
+        present_queue.push_back(frame);
+    }
+    present_cv.notify_one();
+}
+
+Frame* FrameMailbox::TryGetPresentFrame(std::chrono::milliseconds timeout) {
+    std::unique_lock lock{mutex};
+    present_cv.wait_for(lock, timeout, [this] { return !present_queue.empty() || is_closed; });
+    if (present_queue.empty()) {
+        return nullptr;
+    }
+
+    if (Settings::values.present_mode == Settings::PresentMode::VSync) {
+        Frame* const frame = present_queue.front();
+        present_queue.pop_front();
+        return frame;
+    }
+
+    // Only the latest frame is presented, give the older ones back to the renderer
+    while (present_queue.size() > 1) {
+        free_queue.push_back(present_queue.front());
+        present_queue.pop_front();
+    }
+    Frame* const frame = present_queue.front();
+    present_queue.pop_front();
+    lock.unlock();
+
+    free_cv.notify_one();
+    return frame;
+}
+
+void FrameMailbox::ReleasePresentFrame(Frame* frame) {
+    {
+        std::lock_guard lock{mutex};
+        free_queue.push_back(frame);
+    }
+    free_cv.notify_one();
+}
+
+void FrameMailbox::Close() {
+    {
+        std::lock_guard lock{mutex};
+        is_closed = true;
+    }
+    free_cv.notify_all();
+    present_cv.notify_all();
+}
+
 RendererOpenGL::RendererOpenGL(Core::Frontend::EmuWindow& window, Core::System& system)
     : VideoCore::RendererBase{window}, system{system} {}
 
-RendererOpenGL::~RendererOpenGL() = default;
+RendererOpenGL::~RendererOpenGL() {
+    if (present_thread.joinable()) {
+        stop_presenting = true;
+        frame_mailbox.Close();
+        present_thread.join();
+    }
+}
 
 /// Swap buffers (render frame)
 void RendererOpenGL::SwapBuffers(
@@ -129,9 +217,37 @@ void RendererOpenGL::SwapBuffers(
         if (renderer_settings.screenshot_requested)
             CaptureScreenshot();
 
-        DrawScreen(render_window.GetFramebufferLayout());
+        const auto submit_time = Core::PerfStats::Clock::now();
+        const Layout::FramebufferLayout layout{render_window.GetFramebufferLayout()};
 
-        render_window.SwapBuffers();
+        Frame* const frame = frame_mailbox.GetRenderFrame();
+        ConfigureFrame(*frame, layout.width, layout.height);
+        if (frame->present_fence.handle != nullptr) {
+            // Don't overwrite the frame while it's still being read by the presenter
+            glWaitSync(frame->present_fence.handle, 0, GL_TIMEOUT_IGNORED);
+            frame->present_fence.Release();
+        }
+
+        frame->is_srgb = OpenGLState::GetsRGBUsed();
+        frame->submit_time = submit_time;
+
+        state.draw.draw_framebuffer = frame->render.handle;
+        state.Apply();
+        DrawScreen(layout);
+        state.draw.draw_framebuffer = 0;
+        state.Apply();
+
+        frame->render_fence.Release();
+        frame->render_fence.Create();
+        // Submit the commands so the fence becomes visible to the presentation context
+        glFlush();
+
+        frame_mailbox.ReleaseRenderFrame(frame);
+
+        if (!present_thread.joinable()) {
+            // The frontend can't present from another thread, present the frame right away
+            TryPresent(std::chrono::milliseconds{0});
+        }
     }
 
     render_window.PollEvents();
@@ -383,6 +499,103 @@ void RendererOpenGL::DrawScreen(const Layout::FramebufferLayout& layout) {
 /// Updates the framerate
 void RendererOpenGL::UpdateFramerate() {}
 
+void RendererOpenGL::ConfigureFrame(Frame& frame, u32 width, u32 height) {
+    if (frame.render.handle == 0) {
+        frame.render.Create();
+    }
+    if (frame.width == width && frame.height == height && frame.color.handle != 0) {
+        return;
+    }
+
+    frame.width = width;
+    frame.height = height;
+    frame.color.Release();
+    frame.color.Create();
+    glNamedRenderbufferStorage(frame.color.handle, GL_RGBA8, width, height);
+    glNamedFramebufferRenderbuffer(frame.render.handle, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                                   frame.color.handle);
+    frame.color_reloaded = true;
+}
+
+bool RendererOpenGL::TryPresent(std::chrono::milliseconds timeout) {
+    Frame* const frame = frame_mailbox.TryGetPresentFrame(timeout);
+    if (frame == nullptr) {
+        return false;
+    }
+
+    // Framebuffers are not shared between contexts, the presenter uses its own one
+    if (frame->present.handle == 0 || frame->color_reloaded) {
+        frame->present.Release();
+        frame->present.Create();
+        glNamedFramebufferRenderbuffer(frame->present.handle, GL_COLOR_ATTACHMENT0,
+                                       GL_RENDERBUFFER, frame->color.handle);
+        frame->color_reloaded = false;
+    }
+
+    glWaitSync(frame->render_fence.handle, 0, GL_TIMEOUT_IGNORED);
+
+    if (frame->is_srgb) {
+        glEnable(GL_FRAMEBUFFER_SRGB);
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, frame->present.handle);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, frame->width, frame->height, 0, 0, frame->width, frame->height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    if (frame->is_srgb) {
+        glDisable(GL_FRAMEBUFFER_SRGB);
+    }
+
+    frame->present_fence.Release();
+    frame->present_fence.Create();
+
+    if (present_context) {
+        present_context->SwapBuffers();
+    } else {
+        // Presenting inline, give the renderer's bindings back
+        const OpenGLState& cur_state{OpenGLState::GetCurState()};
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, cur_state.draw.read_framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cur_state.draw.draw_framebuffer);
+        render_window.SwapBuffers();
+    }
+
+    system.GetPerfStats().EndPresentFrame(frame->submit_time);
+    frame_mailbox.ReleasePresentFrame(frame);
+    return true;
+}
+
+void RendererOpenGL::PresentLoop() {
+    MicroProfileOnThreadCreate("PresentThread");
+    present_context->MakeCurrent();
+
+    // Swap intervals are disabled by the frontends, pace the presentation to the display rate
+    constexpr auto frame_interval = std::chrono::microseconds{16667};
+    auto next_present = std::chrono::steady_clock::now();
+
+    while (!stop_presenting) {
+        if (!TryPresent(std::chrono::milliseconds{100})) {
+            continue;
+        }
+        if (Settings::values.present_mode == Settings::PresentMode::Uncapped) {
+            continue;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        next_present += frame_interval;
+        if (next_present < now) {
+            // Fell behind the display rate, don't try to catch up with a burst of frames
+            next_present = now;
+            continue;
+        }
+        std::this_thread::sleep_until(next_present);
+    }
+
+    // The presentation framebuffers belong to this context, delete them before releasing it
+    for (auto& frame : frame_mailbox.GetSwapChain()) {
+        frame.present.Release();
+    }
+    present_context->DoneCurrent();
+}
+
 void RendererOpenGL::CaptureScreenshot() {
     // Draw the current frame to the screenshot framebuffer
     screenshot_framebuffer.Create();
@@ -490,6 +703,15 @@ bool RendererOpenGL::Init() {
     InitOpenGLObjects();
     CreateRasterizer();
 
+    // The presentation context has to be created while the render context is current, to share
+    // the frames' renderbuffers and fences with it
+    present_context = render_window.CreatePresentationContext();
+    if (present_context) {
+        present_thread = std::thread(&RendererOpenGL::PresentLoop, this);
+    } else {
+        LOG_INFO(Render_OpenGL, "Frames will be presented from the rendering thread");
+    }
+
     return true;
 }
 
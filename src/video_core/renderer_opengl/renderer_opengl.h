@@ -4,10 +4,19 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <glad/glad.h>
 #include "common/common_types.h"
 #include "common/math_util.h"
+#include "core/perf_stats.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_state.h"
@@ -18,6 +27,7 @@ class System;
 
 namespace Core::Frontend {
 class EmuWindow;
+class GraphicsContext;
 }
 
 namespace Layout {
@@ -43,6 +53,67 @@ struct ScreenInfo {
     TextureInfo texture;
 };
 
+/// Image of the presentation swap chain, drawn by the renderer and later presented to the window
+struct Frame {
+    u32 width = 0;
+    u32 height = 0;
+    bool color_reloaded = false; ///< Color attachment was recreated since it was last presented
+    bool is_srgb = false;        ///< Frame has to be presented with sRGB conversion enabled
+
+    OGLRenderbuffer color;  ///< Color attachment, shared between contexts
+    OGLFramebuffer render;  ///< Framebuffer used to draw the frame, owned by the render context
+    OGLFramebuffer present; ///< Framebuffer used to read the frame, owned by the present context
+
+    OGLSync render_fence;  ///< Signaled when the frame has been drawn
+    OGLSync present_fence; ///< Signaled when the frame has been read for presentation
+
+    Core::PerfStats::Clock::time_point submit_time; ///< Point when the frame was submitted
+};
+
+/**
+ * Hands frames over from the thread that renders them to the thread that presents them. Depending
+ * on Settings::values.present_mode, the renderer either waits for a free frame (VSync) or takes
+ * back the oldest pending frame, and the presenter either consumes frames in order or skips to
+ * the latest one.
+ */
+class FrameMailbox {
+public:
+    static constexpr std::size_t SWAP_CHAIN_SIZE = 3;
+
+    FrameMailbox();
+    ~FrameMailbox();
+
+    /// Returns a frame to draw into, it has to be handed back through ReleaseRenderFrame
+    Frame* GetRenderFrame();
+
+    /// Queues a frame drawn by the renderer for presentation
+    void ReleaseRenderFrame(Frame* frame);
+
+    /// Returns the next frame to present, or nullptr if none is queued within the timeout
+    Frame* TryGetPresentFrame(std::chrono::milliseconds timeout);
+
+    /// Gives a presented frame back to the renderer
+    void ReleasePresentFrame(Frame* frame);
+
+    /// Wakes up any thread waiting on the mailbox, no further waits will block
+    void Close();
+
+    /// Returns all the frames of the swap chain, frames must not be in use by another thread
+    std::array<Frame, SWAP_CHAIN_SIZE>& GetSwapChain() {
+        return swap_chain;
+    }
+
+private:
+    std::array<Frame, SWAP_CHAIN_SIZE> swap_chain;
+    std::deque<Frame*> free_queue;
+    std::deque<Frame*> present_queue;
+
+    std::mutex mutex;
+    std::condition_variable free_cv;
+    std::condition_variable present_cv;
+    bool is_closed = false;
+};
+
 class RendererOpenGL : public VideoCore::RendererBase {
 public:
     explicit RendererOpenGL(Core::Frontend::EmuWindow& window, Core::System& system);
@@ -71,6 +142,15 @@ private:
 
     void CaptureScreenshot();
 
+    /// Resizes the color attachment of a frame to the given dimensions, if needed
+    void ConfigureFrame(Frame& frame, u32 width, u32 height);
+
+    /// Presents the next queued frame to the window, returns false if none was queued in time
+    bool TryPresent(std::chrono::milliseconds timeout);
+
+    /// Presents frames from the presentation context until the renderer is destroyed
+    void PresentLoop();
+
     // Loads framebuffer from emulated memory into the display information structure
     void LoadFBToScreenInfo(const Tegra::FramebufferConfig& framebuffer);
     // Fills active OpenGL texture with the given RGBA color.
@@ -104,6 +184,14 @@ private:
     /// Used for transforming the framebuffer orientation
     Tegra::FramebufferConfig::TransformFlags framebuffer_transform_flags;
     Common::Rectangle<int> framebuffer_crop_rect;
+
+    /// Frames pending presentation
+    FrameMailbox frame_mailbox;
+
+    /// Context and thread used to present frames, unused when the frontend doesn't provide one
+    std::unique_ptr<Core::Frontend::GraphicsContext> present_context;
+    std::thread present_thread;
+    std::atomic_bool stop_presenting{false};
 };
 
 } // namespace OpenGL
@@ -2,10 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -13,20 +15,74 @@
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_device.h"
+#include "video_core/renderer_vulkan/vk_memory_manager.h"
+#include "video_core/renderer_vulkan/vk_resource_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
 
 namespace Vulkan {
 
-CachedBufferEntry::CachedBufferEntry(VAddr cpu_addr, std::size_t size, u64 offset,
-                                     std::size_t alignment, u8* host_ptr)
-    : RasterizerCacheObject{host_ptr}, cpu_addr{cpu_addr}, size{size}, offset{offset},
-      alignment{alignment} {}
+namespace {
+
+/// Maximum size of the data recorded in a single vkCmdUpdateBuffer call
+constexpr std::size_t MAX_UPDATE_SIZE = 0x10000;
+
+/// Size of the cached blocks above which the least recently used ones are evicted
+constexpr std::size_t CACHED_BUFFERS_BUDGET = 256 * 1024 * 1024;
+
+constexpr auto BLOCK_USAGE = vk::BufferUsageFlagBits::eVertexBuffer |
+                             vk::BufferUsageFlagBits::eIndexBuffer |
+                             vk::BufferUsageFlagBits::eUniformBuffer |
+                             vk::BufferUsageFlagBits::eTransferSrc |
+                             vk::BufferUsageFlagBits::eTransferDst;
+
+constexpr auto BLOCK_ACCESS = vk::AccessFlagBits::eVertexAttributeRead |
+                              vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eUniformRead;
+
+/// Records a barrier between transfers to cached blocks and the draws reading from them
+void TransferBarrier(vk::CommandBuffer cmdbuf, const vk::DispatchLoaderDynamic& dld,
+                     bool before_transfer) {
+    if (before_transfer) {
+        // Wait for previous draws to finish reading before overwriting the data
+        const vk::MemoryBarrier barrier(BLOCK_ACCESS, vk::AccessFlagBits::eTransferWrite);
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                               vk::PipelineStageFlagBits::eTransfer, {}, {barrier}, {}, {}, dld);
+    } else {
+        const vk::MemoryBarrier barrier(vk::AccessFlagBits::eTransferWrite,
+                                        BLOCK_ACCESS | vk::AccessFlagBits::eTransferRead);
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eAllCommands, {}, {barrier}, {}, {},
+                               dld);
+    }
+}
+
+} // Anonymous namespace
+
+CachedBufferBlock::CachedBufferBlock(const VKDevice& device, VKMemoryManager& memory_manager,
+                                     std::size_t size) {
+    // vkCmdUpdateBuffer works in multiples of 4 bytes
+    const vk::BufferCreateInfo buffer_ci({}, static_cast<vk::DeviceSize>(Common::AlignUp(size, 4)),
+                                         BLOCK_USAGE, vk::SharingMode::eExclusive, 0, nullptr);
+
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    buffer = dev.createBufferUnique(buffer_ci, nullptr, dld);
+    commit = memory_manager.Commit(*buffer, false);
+}
+
+CachedBufferBlock::~CachedBufferBlock() = default;
+
+void CachedBufferBlock::OnFenceRemoval(VKFence* signaling_fence) {
+    is_released = true;
+}
 
 VKBufferCache::VKBufferCache(Tegra::MemoryManager& tegra_memory_manager,
                              VideoCore::RasterizerInterface& rasterizer, const VKDevice& device,
                              VKMemoryManager& memory_manager, VKScheduler& scheduler, u64 size)
-    : RasterizerCache{rasterizer}, tegra_memory_manager{tegra_memory_manager} {
+    : VideoCommon::BufferCache<Buffer, vk::Buffer>{rasterizer, CACHED_BUFFERS_BUDGET},
+      tegra_memory_manager{tegra_memory_manager}, device{device}, memory_manager{memory_manager},
+      scheduler{scheduler} {
     const auto usage = vk::BufferUsageFlagBits::eVertexBuffer |
                        vk::BufferUsageFlagBits::eIndexBuffer |
                        vk::BufferUsageFlagBits::eUniformBuffer;
@@ -40,7 +96,8 @@ VKBufferCache::VKBufferCache(Tegra::MemoryManager& tegra_memory_manager,
 
 VKBufferCache::~VKBufferCache() = default;
 
-u64 VKBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size, u64 alignment, bool cache) {
+VKBufferCache::BufferInfo VKBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size,
+                                                      u64 alignment, bool cache) {
     const auto cpu_addr{tegra_memory_manager.GpuToCpuAddress(gpu_addr)};
     ASSERT_MSG(cpu_addr, "Invalid GPU address");
 
@@ -49,34 +106,25 @@ u64 VKBufferCache::UploadMemory(GPUVAddr gpu_addr, std::size_t size, u64 alignme
     cache &= size >= 2048;
 
     const auto& host_ptr{Memory::GetPointer(*cpu_addr)};
-    if (cache) {
-        auto entry = TryGet(host_ptr);
-        if (entry) {
-            if (entry->GetSize() >= size && entry->GetAlignment() == alignment) {
-                return entry->GetOffset();
-            }
-            Unregister(entry);
-        }
+    if (cache && host_ptr) {
+        // Cached ranges always start at the beginning of their buffer, which satisfies any
+        // alignment
+        return VideoCommon::BufferCache<Buffer, vk::Buffer>::UploadMemory(host_ptr, *cpu_addr,
+                                                                           size);
     }
 
     AlignBuffer(alignment);
     const u64 uploaded_offset = buffer_offset;
 
     if (!host_ptr) {
-        return uploaded_offset;
+        return {buffer_handle, uploaded_offset};
     }
 
     std::memcpy(buffer_ptr, host_ptr, size);
     buffer_ptr += size;
     buffer_offset += size;
 
-    if (cache) {
-        auto entry = std::make_shared<CachedBufferEntry>(*cpu_addr, size, uploaded_offset,
-                                                         alignment, host_ptr);
-        Register(entry);
-    }
-
-    return uploaded_offset;
+    return {buffer_handle, uploaded_offset};
 }
 
 u64 VKBufferCache::UploadHostMemory(const u8* raw_pointer, std::size_t size, u64 alignment) {
@@ -99,20 +147,74 @@ std::tuple<u8*, u64> VKBufferCache::ReserveMemory(std::size_t size, u64 alignmen
     return {uploaded_ptr, uploaded_offset};
 }
 
-void VKBufferCache::Reserve(std::size_t max_size) {
-    bool invalidate;
-    std::tie(buffer_ptr, buffer_offset_base, invalidate) = stream_buffer->Reserve(max_size);
+bool VKBufferCache::Reserve(std::size_t max_size) {
+    // Cached blocks live in their own buffers, so a stream buffer invalidation doesn't affect them
+    std::tie(buffer_ptr, buffer_offset_base, std::ignore) = stream_buffer->Reserve(max_size);
     buffer_offset = buffer_offset_base;
 
-    if (invalidate) {
-        InvalidateAll();
-    }
+    const bool evicted = EvictOverBudget();
+    CollectReleasedBuffers();
+    return evicted;
 }
 
 VKExecutionContext VKBufferCache::Send(VKExecutionContext exctx) {
     return stream_buffer->Send(exctx, buffer_offset - buffer_offset_base);
 }
 
+Buffer VKBufferCache::CreateBuffer(std::size_t size) {
+    return std::make_unique<CachedBufferBlock>(device, memory_manager, size);
+}
+
+vk::Buffer VKBufferCache::ToHandle(const Buffer& buffer) const {
+    return buffer->GetHandle();
+}
+
+void VKBufferCache::UploadBufferData(const Buffer& buffer, std::size_t offset, std::size_t size,
+                                     const u8* data) {
+    // Commands are recorded later on by the scheduler's worker, the data has to be copied now.
+    // Blocks are allocated with a size aligned to 4 bytes, so the copy is padded to that size.
+    std::vector<u8> staging(Common::AlignUp(size, 4));
+    std::memcpy(staging.data(), data, size);
+
+    // Transfers are not allowed inside of a render pass
+    scheduler.RequestOutsideRenderPassOperationContext();
+    scheduler.Record([handle = buffer->GetHandle(), offset,
+                      staging = std::move(staging)](auto cmdbuf, auto& dld) {
+        TransferBarrier(cmdbuf, dld, true);
+        // The data is stored in the command buffer, so no staging memory has to be managed
+        for (std::size_t chunk = 0; chunk < staging.size(); chunk += MAX_UPDATE_SIZE) {
+            const std::size_t chunk_size = std::min(MAX_UPDATE_SIZE, staging.size() - chunk);
+            cmdbuf.updateBuffer(handle, offset + chunk, chunk_size, staging.data() + chunk, dld);
+        }
+        TransferBarrier(cmdbuf, dld, false);
+    });
+}
+
+void VKBufferCache::CopyBufferData(const Buffer& src, const Buffer& dst, std::size_t src_offset,
+                                   std::size_t dst_offset, std::size_t size) {
+    scheduler.RequestOutsideRenderPassOperationContext();
+    scheduler.Record([src_handle = src->GetHandle(), dst_handle = dst->GetHandle(), src_offset,
+                      dst_offset, size](auto cmdbuf, auto& dld) {
+        TransferBarrier(cmdbuf, dld, true);
+        const vk::BufferCopy copy(src_offset, dst_offset, size);
+        cmdbuf.copyBuffer(src_handle, dst_handle, {copy}, dld);
+        TransferBarrier(cmdbuf, dld, false);
+    });
+}
+
+void VKBufferCache::ReleaseBuffer(Buffer buffer) {
+    // Commands recorded up to this point may still read from the block, destroy it once the
+    // current execution context is done
+    scheduler.GetExecutionContext().GetFence().Protect(buffer.get());
+    released_buffers.push_back(std::move(buffer));
+}
+
+void VKBufferCache::CollectReleasedBuffers() {
+    const auto it = std::remove_if(released_buffers.begin(), released_buffers.end(),
+                                   [](const Buffer& buffer) { return buffer->IsReleased(); });
+    released_buffers.erase(it, released_buffers.end());
+}
+
 void VKBufferCache::AlignBuffer(std::size_t alignment) {
     // Align the offset, not the mapped pointer
     const u64 offset_aligned = Common::AlignUp(buffer_offset, alignment);
@@ -6,11 +6,14 @@
 
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #include "common/common_types.h"
+#include "video_core/buffer_cache.h"
 #include "video_core/gpu.h"
-#include "video_core/rasterizer_cache.h"
 #include "video_core/renderer_vulkan/declarations.h"
+#include "video_core/renderer_vulkan/vk_memory_manager.h"
+#include "video_core/renderer_vulkan/vk_resource_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 
 namespace Tegra {
@@ -20,55 +23,45 @@ class MemoryManager;
 namespace Vulkan {
 
 class VKDevice;
-class VKFence;
-class VKMemoryManager;
 class VKStreamBuffer;
 
-class CachedBufferEntry final : public RasterizerCacheObject {
+/// Device local buffer holding a cached guest memory range
+class CachedBufferBlock final : public VKResource {
 public:
-    explicit CachedBufferEntry(VAddr cpu_addr, std::size_t size, u64 offset, std::size_t alignment,
-                               u8* host_ptr);
+    explicit CachedBufferBlock(const VKDevice& device, VKMemoryManager& memory_manager,
+                               std::size_t size);
+    ~CachedBufferBlock() override;
 
-    VAddr GetCpuAddr() const override {
-        return cpu_addr;
-    }
-
-    std::size_t GetSizeInBytes() const override {
-        return size;
-    }
+    void OnFenceRemoval(VKFence* signaling_fence) override;
 
-    std::size_t GetSize() const {
-        return size;
+    vk::Buffer GetHandle() const {
+        return *buffer;
     }
 
-    u64 GetOffset() const {
-        return offset;
+    /// Returns true when the GPU is done with a block that was removed from the cache
+    bool IsReleased() const {
+        return is_released;
     }
 
-    std::size_t GetAlignment() const {
-        return alignment;
-    }
-
-    // We do not have to flush this cache as things in it are never modified by us.
-    void Flush() override {}
-
 private:
-    VAddr cpu_addr{};
-    std::size_t size{};
-    u64 offset{};
-    std::size_t alignment{};
+    UniqueBuffer buffer;
+    VKMemoryCommit commit;
+    bool is_released = false;
 };
 
-class VKBufferCache final : public RasterizerCache<std::shared_ptr<CachedBufferEntry>> {
+using Buffer = std::unique_ptr<CachedBufferBlock>;
+
+class VKBufferCache final : public VideoCommon::BufferCache<Buffer, vk::Buffer> {
 public:
     explicit VKBufferCache(Tegra::MemoryManager& tegra_memory_manager,
                            VideoCore::RasterizerInterface& rasterizer, const VKDevice& device,
                            VKMemoryManager& memory_manager, VKScheduler& scheduler, u64 size);
     ~VKBufferCache();
 
-    /// Uploads data from a guest GPU address. Returns host's buffer offset where it's been
-    /// allocated.
-    u64 UploadMemory(GPUVAddr gpu_addr, std::size_t size, u64 alignment = 4, bool cache = true);
+    /// Uploads data from a guest GPU address. Returns the host buffer and the offset inside of it
+    /// where the data can be read from.
+    BufferInfo UploadMemory(GPUVAddr gpu_addr, std::size_t size, u64 alignment = 4,
+                            bool cache = true);
 
     /// Uploads from a host memory. Returns host's buffer offset where it's been allocated.
     u64 UploadHostMemory(const u8* raw_pointer, std::size_t size, u64 alignment = 4);
@@ -76,21 +69,41 @@ public:
     /// Reserves memory to be used by host's CPU. Returns mapped address and offset.
     std::tuple<u8*, u64> ReserveMemory(std::size_t size, u64 alignment = 4);
 
-    /// Reserves a region of memory to be used in subsequent upload/reserve operations.
-    void Reserve(std::size_t max_size);
+    /// Reserves a region of memory to be used in subsequent upload/reserve operations. Returns
+    /// true if cached blocks were evicted and buffers bound from them have to be bound again.
+    bool Reserve(std::size_t max_size);
 
     /// Ensures that the set data is sent to the device.
     [[nodiscard]] VKExecutionContext Send(VKExecutionContext exctx);
 
-    /// Returns the buffer cache handle.
+    /// Returns the stream buffer handle, used by uploads that are not cached.
     vk::Buffer GetBuffer() const {
         return buffer_handle;
     }
 
+protected:
+    Buffer CreateBuffer(std::size_t size) override;
+
+    vk::Buffer ToHandle(const Buffer& buffer) const override;
+
+    void UploadBufferData(const Buffer& buffer, std::size_t offset, std::size_t size,
+                          const u8* data) override;
+
+    void CopyBufferData(const Buffer& src, const Buffer& dst, std::size_t src_offset,
+                        std::size_t dst_offset, std::size_t size) override;
+
+    void ReleaseBuffer(Buffer buffer) override;
+
 private:
     void AlignBuffer(std::size_t alignment);
 
+    /// Destroys the removed blocks that are no longer used by the GPU.
+    void CollectReleasedBuffers();
+
     Tegra::MemoryManager& tegra_memory_manager;
+    const VKDevice& device;
+    VKMemoryManager& memory_manager;
+    VKScheduler& scheduler;
 
     std::unique_ptr<VKStreamBuffer> stream_buffer;
     vk::Buffer buffer_handle;
@@ -98,6 +111,9 @@ private:
     u8* buffer_ptr = nullptr;
     u64 buffer_offset = 0;
     u64 buffer_offset_base = 0;
+
+    /// Blocks removed from the cache that may still be in use by the GPU
+    std::vector<Buffer> released_buffers;
 };
 
 } // namespace Vulkan
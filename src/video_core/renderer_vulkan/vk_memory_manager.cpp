@@ -3,11 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
-#include <optional>
+#include <array>
+#include <deque>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "video_core/renderer_vulkan/declarations.h"
@@ -19,6 +23,15 @@ namespace Vulkan {
 // TODO(Rodrigo): Fine tune this number
 constexpr u64 ALLOC_CHUNK_SIZE = 64 * 1024 * 1024;
 
+/// Number of commits between passes releasing unused allocations.
+constexpr u64 TRIM_PERIOD = 4096;
+
+/**
+ * Two-level segregated fit allocator working on a single device memory allocation. Free regions
+ * are binned in size classes, a first level splitting sizes in powers of two and a second level
+ * splitting each power of two in linear steps. Finding a region and returning it are done in
+ * constant time. Returned regions are coalesced with their free neighbours.
+ */
 class VKMemoryAllocation final {
 public:
     explicit VKMemoryAllocation(const VKDevice& device, vk::DeviceMemory memory,
@@ -31,6 +44,11 @@ public:
             const auto& dld = device.GetDispatchLoader();
             base_address = static_cast<u8*>(dev.mapMemory(memory, 0, alloc_size, {}, dld));
         }
+
+        Block* const block = AcquireBlock();
+        block->offset = 0;
+        block->size = Common::AlignDown(alloc_size, MIN_BLOCK_SIZE);
+        InsertFreeBlock(block);
     }
 
     ~VKMemoryAllocation() {
@@ -42,38 +60,60 @@ public:
     }
 
     VKMemoryCommit Commit(vk::DeviceSize commit_size, vk::DeviceSize alignment) {
-        auto found = TryFindFreeSection(free_iterator, alloc_size, static_cast<u64>(commit_size),
-                                        static_cast<u64>(alignment));
-        if (!found) {
-            found = TryFindFreeSection(0, free_iterator, static_cast<u64>(commit_size),
-                                       static_cast<u64>(alignment));
-            if (!found) {
-                // Signal out of memory, it'll try to do more allocations.
-                return nullptr;
-            }
+        const u64 size = Common::AlignUp(std::max<u64>(commit_size, 1), MIN_BLOCK_SIZE);
+        const u64 block_alignment = std::max<u64>(alignment, MIN_BLOCK_SIZE);
+
+        // Blocks are always aligned to the minimum block size, reserve room for the padding
+        // needed to honour bigger alignments.
+        Block* block = FindFreeBlock(size + block_alignment - MIN_BLOCK_SIZE);
+        if (block == nullptr) {
+            // Signal out of memory, it'll try to do more allocations.
+            return nullptr;
         }
-        u8* address = is_mappable ? base_address + *found : nullptr;
-        auto commit = std::make_unique<VKMemoryCommitImpl>(this, memory, address, *found,
-                                                           *found + commit_size);
-        commits.push_back(commit.get());
+        RemoveFreeBlock(block);
 
-        // Last commit's address is highly probable to be free.
-        free_iterator = *found + commit_size;
+        if (const u64 padding = Common::AlignUp(block->offset, block_alignment) - block->offset;
+            padding > 0) {
+            InsertFreeBlock(SplitBlock(block, padding));
+            block = block->next_physical;
+        }
+        if (block->size - size >= MIN_BLOCK_SIZE) {
+            InsertFreeBlock(SplitBlock(block, size)->next_physical);
+        }
 
-        return commit;
+        block->is_free = false;
+        committed_bytes += block->size;
+        used_blocks.emplace(block->offset, block);
+
+        u8* address = is_mappable ? base_address + block->offset : nullptr;
+        return std::make_unique<VKMemoryCommitImpl>(this, memory, address, block->offset,
+                                                    block->offset + commit_size);
     }
 
     void Free(const VKMemoryCommitImpl* commit) {
         ASSERT(commit);
-        const auto it =
-            std::find_if(commits.begin(), commits.end(),
-                         [&](const auto& stored_commit) { return stored_commit == commit; });
-        if (it == commits.end()) {
+        const auto it = used_blocks.find(commit->interval.first);
+        if (it == used_blocks.end()) {
             LOG_CRITICAL(Render_Vulkan, "Freeing unallocated commit!");
             UNREACHABLE();
             return;
         }
-        commits.erase(it);
+        Block* block = it->second;
+        used_blocks.erase(it);
+        committed_bytes -= block->size;
+        block->is_free = true;
+
+        // Coalesce with the free neighbours, free blocks are never adjacent to each other.
+        if (Block* const prev = block->prev_physical; prev != nullptr && prev->is_free) {
+            RemoveFreeBlock(prev);
+            MergeWithNext(prev);
+            block = prev;
+        }
+        if (Block* const next = block->next_physical; next != nullptr && next->is_free) {
+            RemoveFreeBlock(next);
+            MergeWithNext(block);
+        }
+        InsertFreeBlock(block);
     }
 
     /// Returns whether this allocation is compatible with the arguments.
@@ -82,36 +122,175 @@ public:
                (type_mask & shifted_type) != 0;
     }
 
+    /// Returns whether this allocation has the same memory type and properties as another one.
+    bool IsSameKind(const VKMemoryAllocation& other) const {
+        return properties == other.properties && shifted_type == other.shifted_type;
+    }
+
+    /// Returns true when there are no commits alive in this allocation.
+    bool IsEmpty() const {
+        return used_blocks.empty();
+    }
+
+    u64 GetSize() const {
+        return alloc_size;
+    }
+
+    u64 GetCommittedBytes() const {
+        return committed_bytes;
+    }
+
+    std::size_t GetNumCommits() const {
+        return used_blocks.size();
+    }
+
+    /// Returns the size of the biggest free region.
+    u64 GetLargestFreeBlock() const {
+        if (fl_bitmap == 0) {
+            return 0;
+        }
+        // Every block in the highest non-empty class is bigger than the ones in lower classes.
+        const u32 fl = 63 - Common::CountLeadingZeroes64(fl_bitmap);
+        const u32 sl = 31 - Common::CountLeadingZeroes32(sl_bitmaps[fl]);
+        u64 largest = 0;
+        for (const Block* block = free_lists[fl][sl]; block != nullptr; block = block->next_free) {
+            largest = std::max(largest, block->size);
+        }
+        return largest;
+    }
+
 private:
+    static constexpr u32 MIN_BLOCK_BITS = 8;
+    static constexpr u64 MIN_BLOCK_SIZE = u64{1} << MIN_BLOCK_BITS;
+    static constexpr u32 SL_BITS = 4;
+    static constexpr u32 SL_COUNT = 1U << SL_BITS;
+    /// Sizes below this value are binned linearly in the first class.
+    static constexpr u64 SMALL_BLOCK_SIZE = u64{SL_COUNT} << MIN_BLOCK_BITS;
+    static constexpr u32 FL_COUNT = 64 - (MIN_BLOCK_BITS + SL_BITS) + 1;
+
+    struct Block {
+        u64 offset{};
+        u64 size{};
+        bool is_free = true;
+        Block* prev_physical{}; ///< Block right before this one in the allocation.
+        Block* next_physical{}; ///< Block right after this one in the allocation.
+        Block* prev_free{};     ///< Previous block in the same size class, when free.
+        Block* next_free{};     ///< Next block in the same size class, when free.
+    };
+
     static constexpr u32 ShiftType(u32 type) {
         return 1U << type;
     }
 
-    /// A memory allocator, it may return a free region between "start" and "end" with the solicited
-    /// requeriments.
-    std::optional<u64> TryFindFreeSection(u64 start, u64 end, u64 size, u64 alignment) const {
-        u64 iterator = start;
-        while (iterator + size < end) {
-            const u64 try_left = Common::AlignUp(iterator, alignment);
-            const u64 try_right = try_left + size;
-
-            bool overlap = false;
-            for (const auto& commit : commits) {
-                const auto [commit_left, commit_right] = commit->interval;
-                if (try_left < commit_right && commit_left < try_right) {
-                    // There's an overlap, continue the search where the overlapping commit ends.
-                    iterator = commit_right;
-                    overlap = true;
-                    break;
-                }
+    /// Returns the size class a block of the given size belongs to.
+    static std::pair<u32, u32> MappingInsert(u64 size) {
+        if (size < SMALL_BLOCK_SIZE) {
+            return {0, static_cast<u32>(size >> MIN_BLOCK_BITS)};
+        }
+        const u32 msb = 63 - Common::CountLeadingZeroes64(size);
+        const u32 fl = msb - (MIN_BLOCK_BITS + SL_BITS) + 1;
+        const u32 sl = static_cast<u32>(size >> (msb - SL_BITS)) ^ SL_COUNT;
+        return {fl, sl};
+    }
+
+    /// Returns the first size class where every block is big enough for the given size.
+    static std::pair<u32, u32> MappingSearch(u64 size) {
+        if (size >= SMALL_BLOCK_SIZE) {
+            const u32 msb = 63 - Common::CountLeadingZeroes64(size);
+            size += (u64{1} << (msb - SL_BITS)) - 1;
+        }
+        return MappingInsert(size);
+    }
+
+    Block* FindFreeBlock(u64 size) const {
+        auto [fl, sl] = MappingSearch(size);
+        if (fl >= FL_COUNT) {
+            return nullptr;
+        }
+        u32 sl_map = sl_bitmaps[fl] & (~0U << sl);
+        if (sl_map == 0) {
+            const u64 fl_map = fl + 1 < FL_COUNT ? fl_bitmap & (~u64{0} << (fl + 1)) : 0;
+            if (fl_map == 0) {
+                return nullptr;
             }
-            if (!overlap) {
-                // A free address has been found.
-                return try_left;
+            fl = Common::CountTrailingZeroes64(fl_map);
+            sl_map = sl_bitmaps[fl];
+        }
+        sl = Common::CountTrailingZeroes32(sl_map);
+        return free_lists[fl][sl];
+    }
+
+    void InsertFreeBlock(Block* block) {
+        const auto [fl, sl] = MappingInsert(block->size);
+        block->is_free = true;
+        block->prev_free = nullptr;
+        block->next_free = free_lists[fl][sl];
+        if (block->next_free != nullptr) {
+            block->next_free->prev_free = block;
+        }
+        free_lists[fl][sl] = block;
+        fl_bitmap |= u64{1} << fl;
+        sl_bitmaps[fl] |= 1U << sl;
+    }
+
+    void RemoveFreeBlock(Block* block) {
+        const auto [fl, sl] = MappingInsert(block->size);
+        if (block->prev_free != nullptr) {
+            block->prev_free->next_free = block->next_free;
+        } else {
+            free_lists[fl][sl] = block->next_free;
+        }
+        if (block->next_free != nullptr) {
+            block->next_free->prev_free = block->prev_free;
+        }
+        block->prev_free = block->next_free = nullptr;
+
+        if (free_lists[fl][sl] == nullptr) {
+            sl_bitmaps[fl] &= ~(1U << sl);
+            if (sl_bitmaps[fl] == 0) {
+                fl_bitmap &= ~(u64{1} << fl);
             }
         }
-        // No free regions where found, return an empty optional.
-        return std::nullopt;
+    }
+
+    /// Splits a block in two, the first one keeps the given size. Returns the first block.
+    Block* SplitBlock(Block* block, u64 size) {
+        Block* const remainder = AcquireBlock();
+        remainder->offset = block->offset + size;
+        remainder->size = block->size - size;
+        remainder->prev_physical = block;
+        remainder->next_physical = block->next_physical;
+        if (remainder->next_physical != nullptr) {
+            remainder->next_physical->prev_physical = remainder;
+        }
+        block->size = size;
+        block->next_physical = remainder;
+        return block;
+    }
+
+    /// Absorbs the block following the given one.
+    void MergeWithNext(Block* block) {
+        Block* const next = block->next_physical;
+        block->size += next->size;
+        block->next_physical = next->next_physical;
+        if (block->next_physical != nullptr) {
+            block->next_physical->prev_physical = block;
+        }
+        ReleaseBlock(next);
+    }
+
+    Block* AcquireBlock() {
+        if (unused_blocks.empty()) {
+            return &block_pool.emplace_back();
+        }
+        Block* const block = unused_blocks.back();
+        unused_blocks.pop_back();
+        *block = Block{};
+        return block;
+    }
+
+    void ReleaseBlock(Block* block) {
+        unused_blocks.push_back(block);
     }
 
     const VKDevice& device;                   ///< Vulkan device.
@@ -124,11 +303,20 @@ private:
     /// Base address of the mapped pointer.
     u8* base_address{};
 
-    /// Hints where the next free region is likely going to be.
-    u64 free_iterator{};
+    /// Bytes used by commits, including the padding added to their sizes.
+    u64 committed_bytes{};
+
+    u64 fl_bitmap{};                        ///< Non-empty first level classes.
+    std::array<u32, FL_COUNT> sl_bitmaps{}; ///< Non-empty second level classes.
 
-    /// Stores all commits done from this allocation.
-    std::vector<const VKMemoryCommitImpl*> commits;
+    /// Free blocks of each size class.
+    std::array<std::array<Block*, SL_COUNT>, FL_COUNT> free_lists{};
+
+    std::deque<Block> block_pool;      ///< Storage of the block descriptors.
+    std::vector<Block*> unused_blocks; ///< Block descriptors ready to be reused.
+
+    /// Blocks in use by commits, indexed by their offset.
+    std::unordered_map<u64, Block*> used_blocks;
 };
 
 VKMemoryManager::VKMemoryManager(const VKDevice& device)
@@ -138,7 +326,10 @@ VKMemoryManager::VKMemoryManager(const VKDevice& device)
 VKMemoryManager::~VKMemoryManager() = default;
 
 VKMemoryCommit VKMemoryManager::Commit(const vk::MemoryRequirements& reqs, bool host_visible) {
-    ASSERT(reqs.size < ALLOC_CHUNK_SIZE);
+    if (++commits_since_trim >= TRIM_PERIOD) {
+        commits_since_trim = 0;
+        ReleaseUnusedAllocations();
+    }
 
     // When a host visible commit is asked, search for host visible and coherent, otherwise search
     // for a fast device local type.
@@ -163,8 +354,11 @@ VKMemoryCommit VKMemoryManager::Commit(const vk::MemoryRequirements& reqs, bool
         return commit;
     }
 
-    // Commit has failed, allocate more memory.
-    if (!AllocMemory(wanted_properties, reqs.memoryTypeBits, ALLOC_CHUNK_SIZE)) {
+    // Commit has failed, allocate more memory. Commits bigger than a chunk get their own
+    // allocation, with room for the worst alignment padding.
+    const u64 alloc_size =
+        std::max(ALLOC_CHUNK_SIZE, Common::AlignUp(reqs.size + reqs.alignment, ALLOC_CHUNK_SIZE));
+    if (!AllocMemory(wanted_properties, reqs.memoryTypeBits, alloc_size)) {
         // TODO(Rodrigo): Try to use host memory.
         LOG_CRITICAL(Render_Vulkan, "Ran out of memory!");
         UNREACHABLE();
@@ -226,6 +420,47 @@ bool VKMemoryManager::AllocMemory(vk::MemoryPropertyFlags wanted_properties, u32
     return true;
 }
 
+VKMemoryStatistics VKMemoryManager::GetStatistics() const {
+    VKMemoryStatistics stats;
+    stats.num_allocations = allocs.size();
+    for (const auto& alloc : allocs) {
+        stats.allocated_bytes += alloc->GetSize();
+        stats.committed_bytes += alloc->GetCommittedBytes();
+        stats.num_commits += alloc->GetNumCommits();
+        stats.largest_free_block = std::max(stats.largest_free_block, alloc->GetLargestFreeBlock());
+    }
+    return stats;
+}
+
+void VKMemoryManager::ReleaseUnusedAllocations() {
+    // Keep one empty allocation of each kind around to avoid allocating it again right away.
+    std::vector<const VKMemoryAllocation*> kept;
+    const auto it = std::remove_if(allocs.begin(), allocs.end(), [&kept](const auto& alloc) {
+        if (!alloc->IsEmpty()) {
+            return false;
+        }
+        const bool is_kind_kept =
+            std::any_of(kept.begin(), kept.end(), [&alloc](const VKMemoryAllocation* other) {
+                return alloc->IsSameKind(*other);
+            });
+        if (!is_kind_kept) {
+            kept.push_back(alloc.get());
+        }
+        return is_kind_kept;
+    });
+    const auto num_released = static_cast<std::size_t>(std::distance(it, allocs.end()));
+    allocs.erase(it, allocs.end());
+
+    if (num_released > 0) {
+        const VKMemoryStatistics stats = GetStatistics();
+        LOG_DEBUG(Render_Vulkan,
+                  "Released {} unused allocations, {} allocations left with {} of {} bytes "
+                  "committed and a largest free block of {} bytes",
+                  num_released, stats.num_allocations, stats.committed_bytes,
+                  stats.allocated_bytes, stats.largest_free_block);
+    }
+}
+
 /*static*/ bool VKMemoryManager::GetMemoryUnified(const vk::PhysicalDeviceMemoryProperties& props) {
     for (u32 heap_index = 0; heap_index < props.memoryHeapCount; ++heap_index) {
         if (!(props.memoryHeaps[heap_index].flags & vk::MemoryHeapFlagBits::eDeviceLocal)) {
@@ -18,6 +18,15 @@ class VKMemoryCommitImpl;
 
 using VKMemoryCommit = std::unique_ptr<VKMemoryCommitImpl>;
 
+/// Snapshot of the device memory usage, used to measure fragmentation.
+struct VKMemoryStatistics {
+    u64 allocated_bytes{};         ///< Device memory allocated from the driver.
+    u64 committed_bytes{};         ///< Memory used by commits, including their padding.
+    u64 largest_free_block{};      ///< Biggest region that can be committed without allocating.
+    std::size_t num_allocations{}; ///< Number of device memory allocations.
+    std::size_t num_commits{};     ///< Number of live commits.
+};
+
 class VKMemoryManager final {
 public:
     explicit VKMemoryManager(const VKDevice& device);
@@ -43,7 +52,13 @@ public:
         return is_memory_unified;
     }
 
+    /// Returns the current memory usage.
+    VKMemoryStatistics GetStatistics() const;
+
 private:
+    /// Frees the allocations without commits, keeping one of each kind for reuse.
+    void ReleaseUnusedAllocations();
+
     /// Allocates a chunk of memory.
     bool AllocMemory(vk::MemoryPropertyFlags wanted_properties, u32 type_mask, u64 size);
 
@@ -54,6 +69,7 @@ private:
     const vk::PhysicalDeviceMemoryProperties props;          ///< Physical device properties.
     const bool is_memory_unified;                            ///< True if memory model is unified.
     std::vector<std::unique_ptr<VKMemoryAllocation>> allocs; ///< Current allocations.
+    u64 commits_since_trim{}; ///< Commits done since unused allocations were last released.
 };
 
 class VKMemoryCommitImpl final {
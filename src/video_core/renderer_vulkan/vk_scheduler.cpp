@@ -2,8 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <memory>
+#include <mutex>
+#include <utility>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
@@ -11,16 +17,42 @@
 
 namespace Vulkan {
 
+MICROPROFILE_DEFINE(Vulkan_WaitForWorker, "Vulkan", "Wait for worker", MP_RGB(255, 192, 192));
+MICROPROFILE_DEFINE(Vulkan_Record, "Vulkan", "Record commands", MP_RGB(192, 128, 128));
+
+void VKScheduler::CommandChunk::ExecuteAll(const vk::DispatchLoaderDynamic& dld) {
+    auto command = first;
+    while (command != nullptr) {
+        auto next = command->GetNext();
+        command->Execute(cmdbuf, dld);
+        command->~Command();
+        command = next;
+    }
+
+    command_offset = 0;
+    first = nullptr;
+    last = nullptr;
+}
+
 VKScheduler::VKScheduler(const VKDevice& device, VKResourceManager& resource_manager)
     : device{device}, resource_manager{resource_manager} {
+    worker_thread = std::thread(&VKScheduler::WorkerThread, this);
     next_fence = &resource_manager.CommitFence();
     AllocateNewContext();
 }
 
-VKScheduler::~VKScheduler() = default;
+VKScheduler::~VKScheduler() {
+    DispatchWork();
+    {
+        std::lock_guard lock{mutex};
+        quit = true;
+    }
+    work_cv.notify_all();
+    worker_thread.join();
+}
 
 VKExecutionContext VKScheduler::GetExecutionContext() const {
-    return VKExecutionContext(current_fence, current_cmdbuf);
+    return VKExecutionContext(current_fence);
 }
 
 VKExecutionContext VKScheduler::Flush(vk::Semaphore semaphore) {
@@ -32,20 +64,105 @@ VKExecutionContext VKScheduler::Flush(vk::Semaphore semaphore) {
 
 VKExecutionContext VKScheduler::Finish(vk::Semaphore semaphore) {
     SubmitExecution(semaphore);
+    // The fence can't be waited until the worker has submitted it
+    WaitWorker();
     current_fence->Wait();
     current_fence->Release();
     AllocateNewContext();
     return GetExecutionContext();
 }
 
-void VKScheduler::SubmitExecution(vk::Semaphore semaphore) {
+void VKScheduler::DispatchWork() {
+    if (chunk->Empty()) {
+        return;
+    }
+    {
+        std::lock_guard lock{mutex};
+        chunk_queue.push(std::move(chunk));
+    }
+    work_cv.notify_one();
+    AcquireNewChunk();
+}
+
+void VKScheduler::WaitWorker() {
+    MICROPROFILE_SCOPE(Vulkan_WaitForWorker);
+    DispatchWork();
+
+    std::unique_lock lock{mutex};
+    idle_cv.wait(lock, [this] { return chunk_queue.empty() && !is_executing; });
+}
+
+void VKScheduler::RequestRenderpass(vk::RenderPass renderpass, vk::Framebuffer framebuffer,
+                                    vk::Rect2D render_area) {
+    if (renderpass_state && renderpass_state->renderpass == renderpass &&
+        renderpass_state->framebuffer == framebuffer &&
+        renderpass_state->render_area == render_area) {
+        return;
+    }
+    RequestOutsideRenderPassOperationContext();
+
+    renderpass_state = RenderpassState{renderpass, framebuffer, render_area};
+    Record([renderpass, framebuffer, render_area](auto cmdbuf, auto& dld) {
+        const vk::RenderPassBeginInfo renderpass_bi(renderpass, framebuffer, render_area, 0,
+                                                    nullptr);
+        cmdbuf.beginRenderPass(renderpass_bi, vk::SubpassContents::eInline, dld);
+    });
+}
+
+void VKScheduler::RequestOutsideRenderPassOperationContext() {
+    if (!renderpass_state) {
+        return;
+    }
+    renderpass_state.reset();
+    Record([](auto cmdbuf, auto& dld) { cmdbuf.endRenderPass(dld); });
+}
+
+void VKScheduler::WorkerThread() {
+    Common::SetCurrentThreadName("yuzu:VulkanWorker");
+    MicroProfileOnThreadCreate("VulkanWorker");
+
     const auto& dld = device.GetDispatchLoader();
-    current_cmdbuf.end(dld);
+    std::unique_lock lock{mutex};
+    while (true) {
+        work_cv.wait(lock, [this] { return !chunk_queue.empty() || quit; });
+        if (chunk_queue.empty()) {
+            // Quit was requested and every chunk has been recorded
+            return;
+        }
+        std::unique_ptr<CommandChunk> work = std::move(chunk_queue.front());
+        chunk_queue.pop();
+        is_executing = true;
+        lock.unlock();
+
+        {
+            MICROPROFILE_SCOPE(Vulkan_Record);
+            work->ExecuteAll(dld);
+        }
+
+        lock.lock();
+        is_executing = false;
+        chunk_reserve.push_back(std::move(work));
+        if (chunk_queue.empty()) {
+            idle_cv.notify_all();
+        }
+    }
+}
+
+void VKScheduler::SubmitExecution(vk::Semaphore semaphore) {
+    // Command buffers can't end inside of a render pass
+    RequestOutsideRenderPassOperationContext();
 
     const auto queue = device.GetGraphicsQueue();
-    const vk::SubmitInfo submit_info(0, nullptr, nullptr, 1, &current_cmdbuf, semaphore ? 1u : 0u,
-                                     &semaphore);
-    queue.submit({submit_info}, *current_fence, dld);
+    const vk::Fence fence = *current_fence;
+    Record([queue, fence, semaphore](auto cmdbuf, auto& dld) {
+        cmdbuf.end(dld);
+
+        const vk::SubmitInfo submit_info(0, nullptr, nullptr, 1, &cmdbuf, semaphore ? 1u : 0u,
+                                         &semaphore);
+        queue.submit({submit_info}, fence, dld);
+    });
+    // Each chunk targets a single command buffer, don't mix this one with the next context
+    DispatchWork();
 }
 
 void VKScheduler::AllocateNewContext() {
@@ -53,8 +170,24 @@ void VKScheduler::AllocateNewContext() {
     current_cmdbuf = resource_manager.CommitCommandBuffer(*current_fence);
     next_fence = &resource_manager.CommitFence();
 
-    const auto& dld = device.GetDispatchLoader();
-    current_cmdbuf.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit}, dld);
+    AcquireNewChunk();
+    Record([](auto cmdbuf, auto& dld) {
+        cmdbuf.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit}, dld);
+    });
+}
+
+void VKScheduler::AcquireNewChunk() {
+    {
+        std::lock_guard lock{mutex};
+        if (!chunk_reserve.empty()) {
+            chunk = std::move(chunk_reserve.back());
+            chunk_reserve.pop_back();
+        }
+    }
+    if (!chunk) {
+        chunk = std::make_unique<CommandChunk>();
+    }
+    chunk->SetCommandBuffer(current_cmdbuf);
 }
 
 } // namespace Vulkan
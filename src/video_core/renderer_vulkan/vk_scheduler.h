@@ -4,6 +4,17 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "common/common_types.h"
 #include "video_core/renderer_vulkan/declarations.h"
 
@@ -16,6 +27,10 @@ class VKResourceManager;
 
 /// The scheduler abstracts command buffer and fence management with an interface that's able to do
 /// OpenGL-like operations on Vulkan command buffers.
+///
+/// Commands are not recorded into the command buffer when they are issued. They are stored in
+/// chunks that are handed to a worker thread, which does the actual recording and submission while
+/// the GPU thread keeps processing guest commands.
 class VKScheduler {
 public:
     explicit VKScheduler(const VKDevice& device, VKResourceManager& resource_manager);
@@ -32,16 +47,153 @@ public:
     /// the current execution context and returns a new one.
     VKExecutionContext Finish(vk::Semaphore semaphore = nullptr);
 
+    /// Sends the recorded commands to the worker thread.
+    void DispatchWork();
+
+    /// Waits for the worker thread to record and submit all the dispatched commands. It has to be
+    /// called before waiting on the fence of a flushed execution context.
+    void WaitWorker();
+
+    /// Begins a render pass without clearing its attachments, unless it's the render pass in
+    /// progress. The render pass in progress, if any, is ended first.
+    void RequestRenderpass(vk::RenderPass renderpass, vk::Framebuffer framebuffer,
+                           vk::Rect2D render_area);
+
+    /// Ends the render pass in progress, if any. It has to be called before recording commands
+    /// that are not allowed inside of a render pass, like transfers.
+    void RequestOutsideRenderPassOperationContext();
+
+    /**
+     * Records a command to be executed on the current command buffer by the worker thread. The
+     * command is a callable taking a vk::CommandBuffer and a vk::DispatchLoaderDynamic, anything
+     * it references has to be captured by value.
+     */
+    template <typename T>
+    void Record(T&& command) {
+        if (chunk->Record(command)) {
+            return;
+        }
+        DispatchWork();
+        [[maybe_unused]] const bool recorded = chunk->Record(command);
+    }
+
 private:
+    class Command {
+    public:
+        virtual ~Command() = default;
+
+        virtual void Execute(vk::CommandBuffer cmdbuf,
+                             const vk::DispatchLoaderDynamic& dld) const = 0;
+
+        Command* GetNext() const {
+            return next;
+        }
+
+        void SetNext(Command* next_) {
+            next = next_;
+        }
+
+    private:
+        Command* next = nullptr;
+    };
+
+    template <typename T>
+    class TypedCommand final : public Command {
+    public:
+        explicit TypedCommand(T&& command) : command{std::move(command)} {}
+        ~TypedCommand() override = default;
+
+        TypedCommand(TypedCommand&&) = delete;
+        TypedCommand& operator=(TypedCommand&&) = delete;
+
+        void Execute(vk::CommandBuffer cmdbuf,
+                     const vk::DispatchLoaderDynamic& dld) const override {
+            command(cmdbuf, dld);
+        }
+
+    private:
+        T command;
+    };
+
+    /// Fixed size block of commands targeting a single command buffer.
+    class CommandChunk final {
+    public:
+        /// Executes and destroys all the commands in the chunk.
+        void ExecuteAll(const vk::DispatchLoaderDynamic& dld);
+
+        template <typename T>
+        bool Record(T& command) {
+            using FuncType = TypedCommand<T>;
+            static_assert(sizeof(FuncType) < sizeof(data), "Command is too big to be recorded");
+
+            const std::size_t offset =
+                (command_offset + alignof(FuncType) - 1) & ~(alignof(FuncType) - 1);
+            if (offset + sizeof(FuncType) > sizeof(data)) {
+                return false;
+            }
+
+            Command* const current_last = last;
+            last = new (data.data() + offset) FuncType(std::move(command));
+            if (current_last) {
+                current_last->SetNext(last);
+            } else {
+                first = last;
+            }
+            command_offset = offset + sizeof(FuncType);
+            return true;
+        }
+
+        void SetCommandBuffer(vk::CommandBuffer cmdbuf_) {
+            cmdbuf = cmdbuf_;
+        }
+
+        bool Empty() const {
+            return first == nullptr;
+        }
+
+    private:
+        vk::CommandBuffer cmdbuf;
+        Command* first = nullptr;
+        Command* last = nullptr;
+
+        std::size_t command_offset = 0;
+        alignas(std::max_align_t) std::array<u8, 0x8000> data{};
+    };
+
+    void WorkerThread();
+
     void SubmitExecution(vk::Semaphore semaphore);
 
     void AllocateNewContext();
 
+    /// Replaces the current chunk with an empty one targeting the current command buffer.
+    void AcquireNewChunk();
+
     const VKDevice& device;
     VKResourceManager& resource_manager;
     vk::CommandBuffer current_cmdbuf;
     VKFence* current_fence = nullptr;
     VKFence* next_fence = nullptr;
+
+    /// Render pass in progress in the recorded commands, tracked by the GPU thread.
+    struct RenderpassState {
+        vk::RenderPass renderpass;
+        vk::Framebuffer framebuffer;
+        vk::Rect2D render_area;
+    };
+    std::optional<RenderpassState> renderpass_state;
+
+    std::unique_ptr<CommandChunk> chunk; ///< Chunk being filled by the GPU thread.
+
+    std::mutex mutex;
+    std::condition_variable work_cv;  ///< Signaled when chunks are queued or on shutdown.
+    std::condition_variable idle_cv;  ///< Signaled when the worker runs out of chunks.
+    std::queue<std::unique_ptr<CommandChunk>> chunk_queue; ///< Chunks waiting to be recorded.
+    std::vector<std::unique_ptr<CommandChunk>> chunk_reserve; ///< Chunks ready to be reused.
+    bool is_executing = false; ///< The worker is recording a chunk.
+    bool quit = false;
+
+    std::thread worker_thread;
 };
 
 class VKExecutionContext {
@@ -54,16 +206,10 @@ public:
         return *fence;
     }
 
-    vk::CommandBuffer GetCommandBuffer() const {
-        return cmdbuf;
-    }
-
 private:
-    explicit VKExecutionContext(VKFence* fence, vk::CommandBuffer cmdbuf)
-        : fence{fence}, cmdbuf{cmdbuf} {}
+    explicit VKExecutionContext(VKFence* fence) : fence{fence} {}
 
     VKFence* fence{};
-    vk::CommandBuffer cmdbuf;
 };
 
 } // namespace Vulkan
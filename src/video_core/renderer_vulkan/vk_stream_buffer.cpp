@@ -52,6 +52,8 @@ VKExecutionContext VKStreamBuffer::Send(VKExecutionContext exctx, u64 size) {
     if (invalidation_mark) {
         // TODO(Rodrigo): Find a better way to invalidate than waiting for all watches to finish.
         exctx = scheduler.Flush();
+        // Watched fences are submitted by the scheduler's worker, make sure they reached the queue
+        scheduler.WaitWorker();
         std::for_each(watches.begin(), watches.begin() + *invalidation_mark,
                       [&](auto& resource) { resource->Wait(); });
         invalidation_mark = std::nullopt;
@@ -14,6 +14,7 @@
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_swapchain.h"
 
 namespace Vulkan {
@@ -53,8 +54,8 @@ vk::Extent2D ChooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities, u3
 }
 } // namespace
 
-VKSwapchain::VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device)
-    : surface{surface}, device{device} {}
+VKSwapchain::VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device, VKScheduler& scheduler)
+    : surface{surface}, device{device}, scheduler{scheduler} {}
 
 VKSwapchain::~VKSwapchain() = default;
 
@@ -100,6 +101,10 @@ bool VKSwapchain::Present(vk::Semaphore render_semaphore, VKFence& fence) {
     const auto present_queue{device.GetPresentQueue()};
     bool recreated = false;
 
+    // Queues must be externally synchronized, and the render semaphore must have been submitted
+    // before it's waited on. Both are only true once the worker is done with the queue.
+    scheduler.WaitWorker();
+
     const vk::PresentInfoKHR present_info(wait_semaphore_count, semaphores.data(), 1,
                                           &swapchain.get(), &image_index, {});
     switch (const auto result = present_queue.presentKHR(&present_info, dld); result) {
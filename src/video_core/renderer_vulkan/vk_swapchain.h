@@ -17,10 +17,11 @@ namespace Vulkan {
 
 class VKDevice;
 class VKFence;
+class VKScheduler;
 
 class VKSwapchain {
 public:
-    explicit VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device);
+    explicit VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device, VKScheduler& scheduler);
     ~VKSwapchain();
 
     /// Creates (or recreates) the swapchain with a given size.
@@ -30,7 +31,8 @@ public:
     void AcquireNextImage();
 
     /// Presents the rendered image to the swapchain. Returns true when the swapchains had to be
-    /// recreated. Takes responsability for the ownership of fence.
+    /// recreated. Takes responsability for the ownership of fence. Waits for the scheduler's worker
+    /// to submit its commands, as it owns the queue until then.
     bool Present(vk::Semaphore render_semaphore, VKFence& fence);
 
     /// Returns true when the framebuffer layout has changed.
@@ -69,6 +71,7 @@ private:
 
     const vk::SurfaceKHR surface;
     const VKDevice& device;
+    VKScheduler& scheduler;
 
     UniqueSwapchainKHR swapchain;
 
@@ -14,6 +14,7 @@
 
 namespace VideoCommon {
 
+using VideoCore::Surface::PixelFormat;
 using VideoCore::Surface::SurfaceTarget;
 
 using VideoCore::Surface::ComponentTypeFromDepthFormat;
@@ -342,6 +343,45 @@ bool SurfaceParams::IsViewValid(const SurfaceParams& view_params, u32 layer, u32
            IsInBounds(view_params, layer, level);
 }
 
+bool SurfaceParams::IsCopyCompatible(const SurfaceParams& src_params, u32 layer, u32 level) const {
+    // Reinterpreted formats must have blocks of the same size and dimensions
+    const PixelFormat src_format{src_params.pixel_format};
+    if (GetBytesPerPixel(src_format) != GetBytesPerPixel(pixel_format) ||
+        GetDefaultBlockWidth(src_format) != GetDefaultBlockWidth(pixel_format) ||
+        GetDefaultBlockHeight(src_format) != GetDefaultBlockHeight(pixel_format)) {
+        return false;
+    }
+
+    if (src_params.is_tiled != is_tiled || src_params.tile_width_spacing != tile_width_spacing ||
+        src_params.num_levels != 1) {
+        return false;
+    }
+    if (is_tiled) {
+        if (src_params.block_height != GetMipBlockHeight(level) ||
+            src_params.block_depth != GetMipBlockDepth(level)) {
+            return false;
+        }
+    } else if (src_params.pitch != pitch) {
+        return false;
+    }
+    if (src_params.width != GetMipWidth(level) || src_params.height != GetMipHeight(level)) {
+        return false;
+    }
+
+    // Slices of 3D surfaces are interleaved in memory, they can't be mixed with layers
+    const bool is_3d{target == SurfaceTarget::Texture3D};
+    if (is_3d != (src_params.target == SurfaceTarget::Texture3D)) {
+        return false;
+    }
+    if (is_3d) {
+        return src_params.depth == GetMipDepth(level);
+    }
+    if (src_params.num_layers > 1 && src_params.GetGuestLayerSize() != GetGuestLayerSize()) {
+        return false;
+    }
+    return layer + src_params.num_layers <= num_layers;
+}
+
 bool SurfaceParams::IsDimensionValid(const SurfaceParams& view_params, u32 level) const {
     return view_params.width == GetMipWidth(level) && view_params.height == GetMipHeight(level);
 }
@@ -4,22 +4,27 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <set>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/icl/interval_map.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include "common/assert.h"
 #include "common/common_types.h"
+#include "core/core.h"
 #include "core/memory.h"
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/surface.h"
 
@@ -187,6 +192,11 @@ public:
     /// Returns true if the passed surface view parameters is equal or a valid subset of this.
     bool IsViewValid(const SurfaceParams& view_params, u32 layer, u32 level) const;
 
+    /// Returns true if a surface with the passed parameters has the same guest memory layout as
+    /// this surface at a given layer and mipmap level. Pixel formats may differ as long as their
+    /// blocks have the same size, the texels are then reinterpreted when copied.
+    bool IsCopyCompatible(const SurfaceParams& src_params, u32 layer, u32 level) const;
+
 private:
     /// Calculates values that can be deduced from HasheableSurfaceParams.
     void CalculateCachedValues();
@@ -224,6 +234,15 @@ struct ViewKey {
     u32 num_levels{};
 };
 
+/// Region copied between two surfaces, the source region starts at its first level and layer.
+struct CopyParams {
+    u32 dest_layer{};
+    u32 dest_level{};
+    u32 width{};
+    u32 height{};
+    u32 depth{}; ///< Number of layers, or number of slices on 3D surfaces.
+};
+
 } // namespace VideoCommon
 
 namespace std {
@@ -301,6 +320,10 @@ public:
         is_modified = is_modified_;
     }
 
+    bool IsModified() const {
+        return is_modified;
+    }
+
     const SurfaceParams& GetSurfaceParams() const {
         return params;
     }
@@ -340,10 +363,6 @@ protected:
 
     virtual std::unique_ptr<TView> CreateView(const ViewKey& view_key) = 0;
 
-    bool IsModified() const {
-        return is_modified;
-    }
-
     const SurfaceParams params;
 
 private:
@@ -385,6 +404,17 @@ public:
         }
     }
 
+    TExecutionContext FlushRegion(TExecutionContext exctx, CacheAddr addr, std::size_t size) {
+        for (TSurface* surface : GetSurfacesInRegion(addr, size)) {
+            if (!surface->IsModified()) {
+                continue;
+            }
+            exctx = surface->FlushBuffer(exctx);
+            surface->MarkAsModified(false);
+        }
+        return exctx;
+    }
+
     ResultType GetTextureSurface(TExecutionContext exctx,
                                  const Tegra::Texture::FullTextureInfo& config) {
         auto& memory_manager{system.GPU().MemoryManager()};
@@ -462,6 +492,11 @@ protected:
 
     virtual std::unique_ptr<TSurface> CreateSurface(const SurfaceParams& params) = 0;
 
+    /// Copies a region of a surface to another one on the host. Pixel formats may differ as long
+    /// as they have the same block size, the texels are then reinterpreted.
+    virtual TExecutionContext CopyImage(TExecutionContext exctx, TSurface& src_surface,
+                                        TSurface& dst_surface, const CopyParams& copy_params) = 0;
+
     void Register(TSurface* surface, VAddr cpu_addr, u8* host_ptr) {
         surface->Register(cpu_addr, host_ptr);
         registered_surfaces.add({GetSurfaceInterval(surface), {surface}});
@@ -501,6 +536,13 @@ private:
                 return {view, exctx};
         }
 
+        TView* copied_view;
+        std::tie(copied_view, exctx) =
+            TryCopyOverlaps(exctx, cpu_addr, host_ptr, params, preserve_contents, overlaps);
+        if (copied_view) {
+            return {copied_view, exctx};
+        }
+
         TView* fast_view;
         std::tie(fast_view, exctx) =
             TryFastGetSurfaceView(exctx, cpu_addr, host_ptr, params, preserve_contents, overlaps);
@@ -531,6 +573,68 @@ private:
         return {new_surface->GetView(cpu_addr, params), exctx};
     }
 
+    /**
+     * Tries to build the requested surface from the surfaces overlapping it using host copies,
+     * without going through guest memory. This resolves format reinterpretations and surfaces
+     * assembled from previously rendered layers or mipmap levels.
+     * @returns The new view, or a null view when an overlap doesn't fit in the requested surface.
+     */
+    ResultType TryCopyOverlaps(TExecutionContext exctx, VAddr cpu_addr, u8* host_ptr,
+                               const SurfaceParams& params, bool preserve_contents,
+                               const std::vector<TSurface*>& overlaps) {
+        const VAddr end_addr{cpu_addr + params.GetGuestSizeInBytes()};
+        const auto view_offset_map{params.CreateViewOffsetMap()};
+
+        std::vector<std::pair<TSurface*, CopyParams>> copies;
+        for (TSurface* overlap : overlaps) {
+            const VAddr overlap_addr{overlap->GetCpuAddr()};
+            if (overlap_addr < cpu_addr || overlap_addr + overlap->GetSizeInBytes() > end_addr) {
+                return {{}, exctx};
+            }
+            const auto it{view_offset_map.find(overlap_addr - cpu_addr)};
+            if (it == view_offset_map.end()) {
+                return {{}, exctx};
+            }
+            const auto [layer, level] = it->second;
+            const auto& src_params{overlap->GetSurfaceParams()};
+            if (!params.IsCopyCompatible(src_params, layer, level)) {
+                return {{}, exctx};
+            }
+            if (!overlap->IsModified()) {
+                // Guest memory is up to date, it will be loaded with the new surface
+                continue;
+            }
+            if (std::any_of(copies.begin(), copies.end(),
+                            [overlap](const auto& copy) { return copy.first == overlap; })) {
+                // Surfaces spanning multiple intervals are found more than once
+                continue;
+            }
+            const u32 depth{src_params.GetTarget() == VideoCore::Surface::SurfaceTarget::Texture3D
+                                ? src_params.GetDepth()
+                                : src_params.GetNumLayers()};
+            copies.push_back(
+                {overlap, {layer, level, src_params.GetWidth(), src_params.GetHeight(), depth}});
+        }
+
+        // Take the new surface while the overlaps are registered, so none of them is reused.
+        // Overlaps stay alive in the reserve after being unregistered and can still be copied.
+        TSurface* new_surface{GetUncachedSurface(params)};
+        for (TSurface* overlap : overlaps) {
+            if (overlap->IsRegistered()) {
+                Unregister(overlap);
+            }
+        }
+        Register(new_surface, cpu_addr, host_ptr);
+        if (preserve_contents) {
+            exctx = LoadSurface(exctx, new_surface);
+        }
+        for (const auto& [overlap, copy_params] : copies) {
+            exctx = CopyImage(exctx, *overlap, *new_surface, copy_params);
+        }
+        new_surface->MarkAsModified(!copies.empty());
+        return {new_surface->GetView(cpu_addr, params), exctx};
+    }
+
     TExecutionContext LoadSurface(TExecutionContext exctx, TSurface* surface) {
         surface->LoadBuffer();
         exctx = surface->UploadTexture(exctx);
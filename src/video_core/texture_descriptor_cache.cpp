@@ -0,0 +1,135 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <optional>
+
+#include "common/assert.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/texture_descriptor_cache.h"
+
+namespace VideoCommon {
+
+TextureDescriptorCache::TextureDescriptorCache(Core::System& system,
+                                               VideoCore::RasterizerInterface& rasterizer)
+    : system{system}, rasterizer{rasterizer} {}
+
+TextureDescriptorCache::~TextureDescriptorCache() = default;
+
+Tegra::Texture::FullTextureInfo TextureDescriptorCache::GetTextureInfo(
+    Tegra::Texture::TextureHandle tex_handle, std::size_t offset) {
+    std::lock_guard lock{mutex};
+
+    Tegra::Texture::FullTextureInfo tex_info{};
+    tex_info.index = static_cast<u32>(offset);
+    // BitField's move constructor is deleted, copy the raw entries instead
+    std::memcpy(&tex_info.tic, GetTICEntry(tex_handle.tic_id).data(), EntrySize);
+    std::memcpy(&tex_info.tsc, GetTSCEntry(tex_handle.tsc_id).data(), EntrySize);
+    return tex_info;
+}
+
+void TextureDescriptorCache::InvalidateRegion(CacheAddr addr, u64 size) {
+    std::lock_guard lock{mutex};
+    if (size == 0) {
+        return;
+    }
+
+    // Entries starting up to EntrySize - 1 bytes before the region still overlap it
+    const CacheAddr begin = addr < EntrySize ? 0 : addr - EntrySize + 1;
+    const CacheAddr end = addr + size;
+    auto iter = descriptor_addrs.lower_bound(begin);
+    while (iter != descriptor_addrs.end() && iter->first < end) {
+        const GPUVAddr gpu_addr = iter->second;
+        // Unregister erases the current node, move to the next one before that happens
+        ++iter;
+        Unregister(descriptors.find(gpu_addr));
+    }
+}
+
+void TextureDescriptorCache::InvalidateAll() {
+    std::lock_guard lock{mutex};
+
+    while (!descriptors.empty()) {
+        Unregister(descriptors.begin());
+    }
+}
+
+u64 TextureDescriptorCache::GetGeneration() {
+    std::lock_guard lock{mutex};
+    return generation;
+}
+
+const std::array<u8, TextureDescriptorCache::EntrySize>& TextureDescriptorCache::GetTICEntry(
+    u32 tic_index) {
+    const auto& maxwell3d = system.GPU().Maxwell3D();
+    const GPUVAddr gpu_addr{maxwell3d.regs.tic.TICAddress() + tic_index * EntrySize};
+    if (const auto iter = descriptors.find(gpu_addr); iter != descriptors.end()) {
+        return iter->second.raw;
+    }
+
+    const Tegra::Texture::TICEntry tic_entry = maxwell3d.GetTICEntry(tic_index);
+    if (const Descriptor* const descriptor = Register(gpu_addr, &tic_entry); descriptor) {
+        return descriptor->raw;
+    }
+    std::memcpy(uncached_entry.data(), &tic_entry, EntrySize);
+    return uncached_entry;
+}
+
+const std::array<u8, TextureDescriptorCache::EntrySize>& TextureDescriptorCache::GetTSCEntry(
+    u32 tsc_index) {
+    const auto& maxwell3d = system.GPU().Maxwell3D();
+    const GPUVAddr gpu_addr{maxwell3d.regs.tsc.TSCAddress() + tsc_index * EntrySize};
+    if (const auto iter = descriptors.find(gpu_addr); iter != descriptors.end()) {
+        return iter->second.raw;
+    }
+
+    const Tegra::Texture::TSCEntry tsc_entry = maxwell3d.GetTSCEntry(tsc_index);
+    if (const Descriptor* const descriptor = Register(gpu_addr, &tsc_entry); descriptor) {
+        return descriptor->raw;
+    }
+    std::memcpy(uncached_entry.data(), &tsc_entry, EntrySize);
+    return uncached_entry;
+}
+
+const TextureDescriptorCache::Descriptor* TextureDescriptorCache::Register(GPUVAddr gpu_addr,
+                                                                          const void* entry) {
+    const auto& memory_manager = system.GPU().MemoryManager();
+    const u8* const host_ptr = memory_manager.GetPointer(gpu_addr);
+    const std::optional<VAddr> cpu_addr = memory_manager.GpuToCpuAddress(gpu_addr);
+    if (host_ptr == nullptr || !cpu_addr) {
+        // Writes to this entry can't be tracked, don't cache it
+        return nullptr;
+    }
+
+    Descriptor& descriptor = descriptors[gpu_addr];
+    descriptor.cache_addr = ToCacheAddr(host_ptr);
+    descriptor.cpu_addr = *cpu_addr;
+    std::memcpy(descriptor.raw.data(), entry, EntrySize);
+
+    descriptor_addrs.emplace(descriptor.cache_addr, gpu_addr);
+    rasterizer.UpdatePagesCachedCount(descriptor.cpu_addr, EntrySize, 1);
+    return &descriptor;
+}
+
+void TextureDescriptorCache::Unregister(std::unordered_map<GPUVAddr, Descriptor>::iterator iter) {
+    ASSERT(iter != descriptors.end());
+    const GPUVAddr gpu_addr = iter->first;
+    const Descriptor& descriptor = iter->second;
+
+    rasterizer.UpdatePagesCachedCount(descriptor.cpu_addr, EntrySize, -1);
+    const auto [begin, end] = descriptor_addrs.equal_range(descriptor.cache_addr);
+    for (auto addr_iter = begin; addr_iter != end; ++addr_iter) {
+        if (addr_iter->second == gpu_addr) {
+            descriptor_addrs.erase(addr_iter);
+            break;
+        }
+    }
+    descriptors.erase(iter);
+    ++generation;
+}
+
+} // namespace VideoCommon
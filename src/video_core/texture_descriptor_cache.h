@@ -0,0 +1,90 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "video_core/gpu.h"
+#include "video_core/textures/texture.h"
+
+namespace Core {
+class System;
+}
+
+namespace VideoCore {
+class RasterizerInterface;
+}
+
+namespace VideoCommon {
+
+/**
+ * Caches the TIC and TSC entries read from the texture header pools. Entries are keyed by the GPU
+ * address of the entry in its pool, which is the pool address plus the entry index times the entry
+ * size, so changing the pool registers naturally misses the cache.
+ *
+ * The pages backing cached entries are marked as cached in the rasterizer, writes to them reach
+ * InvalidateRegion and drop the overlapping entries. Every invalidation bumps a generation
+ * counter, users that derive state from the descriptors can compare it to know if their state is
+ * still valid without reading any of the entries.
+ */
+class TextureDescriptorCache final {
+public:
+    explicit TextureDescriptorCache(Core::System& system,
+                                    VideoCore::RasterizerInterface& rasterizer);
+    ~TextureDescriptorCache();
+
+    /// Returns the TIC and TSC entries referenced by a texture handle
+    Tegra::Texture::FullTextureInfo GetTextureInfo(Tegra::Texture::TextureHandle tex_handle,
+                                                   std::size_t offset);
+
+    /// Drops the cached entries overlapping the specified region
+    void InvalidateRegion(CacheAddr addr, u64 size);
+
+    /// Drops all the cached entries
+    void InvalidateAll();
+
+    /// Returns a counter that changes every time a cached entry is dropped
+    u64 GetGeneration();
+
+private:
+    static_assert(sizeof(Tegra::Texture::TICEntry) == sizeof(Tegra::Texture::TSCEntry));
+    static constexpr std::size_t EntrySize = sizeof(Tegra::Texture::TICEntry);
+
+    struct Descriptor {
+        CacheAddr cache_addr{};
+        VAddr cpu_addr{};
+        std::array<u8, EntrySize> raw{};
+    };
+
+    /// Returns the raw TIC entry of the current pool, reading it from memory on a cache miss
+    const std::array<u8, EntrySize>& GetTICEntry(u32 tic_index);
+
+    /// Returns the raw TSC entry of the current pool, reading it from memory on a cache miss
+    const std::array<u8, EntrySize>& GetTSCEntry(u32 tsc_index);
+
+    /// Inserts an entry in the cache, returns nullptr when its memory can't be tracked
+    const Descriptor* Register(GPUVAddr gpu_addr, const void* entry);
+
+    void Unregister(std::unordered_map<GPUVAddr, Descriptor>::iterator iter);
+
+    Core::System& system;
+    VideoCore::RasterizerInterface& rasterizer;
+
+    std::unordered_map<GPUVAddr, Descriptor> descriptors; ///< Cached entries by GPU address
+    std::multimap<CacheAddr, GPUVAddr> descriptor_addrs;  ///< Cached entries by host address
+
+    /// Storage for entries whose memory can't be tracked, they are read again on every use
+    std::array<u8, EntrySize> uncached_entry{};
+
+    u64 generation{};
+    std::recursive_mutex mutex;
+};
+
+} // namespace VideoCommon
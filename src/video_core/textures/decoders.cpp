@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include "common/alignment.h"
@@ -182,6 +183,21 @@ void CopySwizzledData(u32 width, u32 height, u32 depth, u32 bytes_per_pixel,
     }
 }
 
+u32 GetBlockLinearOffset(u32 x, u32 y, u32 z, u32 width, u32 height, u32 block_height,
+                         u32 block_depth, u32 width_spacing) {
+    const u32 aligned_width = Common::AlignUp(width, gob_size_x * std::max(width_spacing, 1U));
+    const u32 blocks_on_x = aligned_width / gob_size_x;
+    const u32 blocks_on_y = (height + gob_size_y * block_height - 1) / (gob_size_y * block_height);
+    const u32 xy_block_size = gob_size * block_height;
+
+    const u32 block_index = (z / block_depth) * blocks_on_y * blocks_on_x +
+                            (y / (gob_size_y * block_height)) * blocks_on_x + x / gob_size_x;
+    const u32 gob_offset = (z % block_depth) * xy_block_size +
+                           (y % (gob_size_y * block_height)) / gob_size_y * gob_size;
+    return block_index * xy_block_size * block_depth + gob_offset +
+           legacy_swizzle_table[y % gob_size_y][x % gob_size_x];
+}
+
 u32 BytesPerPixel(TextureFormat format) {
     switch (format) {
     case TextureFormat::DXT1:
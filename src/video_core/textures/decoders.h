@@ -34,6 +34,14 @@ void CopySwizzledData(u32 width, u32 height, u32 depth, u32 bytes_per_pixel,
                       u32 out_bytes_per_pixel, u8* swizzled_data, u8* unswizzled_data,
                       bool unswizzle, u32 block_height, u32 block_depth, u32 width_spacing);
 
+/**
+ * Returns the offset of a byte inside a block linear surface. Coordinates and the width are
+ * measured in bytes, which is equivalent to texels for formats with a power of two size. The GPU
+ * swizzle passes implement this same formula.
+ */
+u32 GetBlockLinearOffset(u32 x, u32 y, u32 z, u32 width, u32 height, u32 block_height,
+                         u32 block_depth, u32 width_spacing);
+
 /// Decodes an unswizzled texture into a A8R8G8B8 texture.
 std::vector<u8> DecodeTexture(const std::vector<u8>& texture_data, TextureFormat format, u32 width,
                               u32 height);
@@ -8,6 +8,7 @@
 #include "video_core/gpu_asynch.h"
 #include "video_core/gpu_synch.h"
 #include "video_core/renderer_base.h"
+#include "video_core/renderer_null/renderer_null.h"
 #include "video_core/renderer_opengl/renderer_opengl.h"
 #include "video_core/video_core.h"
 
@@ -15,15 +16,28 @@ namespace VideoCore {
 
 std::unique_ptr<RendererBase> CreateRenderer(Core::Frontend::EmuWindow& emu_window,
                                              Core::System& system) {
-    return std::make_unique<OpenGL::RendererOpenGL>(emu_window, system);
+    switch (Settings::values.renderer_backend) {
+    case Settings::RendererBackend::Null:
+        return std::make_unique<Null::RendererNull>(emu_window, system);
+    case Settings::RendererBackend::OpenGL:
+    default:
+        return std::make_unique<OpenGL::RendererOpenGL>(emu_window, system);
+    }
 }
 
 std::unique_ptr<Tegra::GPU> CreateGPU(Core::System& system) {
+    std::unique_ptr<Tegra::GPU> gpu;
     if (Settings::values.use_asynchronous_gpu_emulation) {
-        return std::make_unique<VideoCommon::GPUAsynch>(system, system.Renderer());
+        gpu = std::make_unique<VideoCommon::GPUAsynch>(system, system.Renderer());
+    } else {
+        gpu = std::make_unique<VideoCommon::GPUSynch>(system, system.Renderer());
+    }
+
+    if (!Settings::values.gpu_capture_path.empty()) {
+        gpu->StartCapture(Settings::values.gpu_capture_path);
     }
 
-    return std::make_unique<VideoCommon::GPUSynch>(system, system.Renderer());
+    return gpu;
 }
 
 u16 GetResolutionScaleFactor(const RendererBase& renderer) {
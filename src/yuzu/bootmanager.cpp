@@ -50,6 +50,8 @@ void EmuThread::run() {
     // next execution step
     bool was_active = false;
     while (!stop_run) {
+        ProcessSnapshotRequests();
+
         if (running) {
             if (!was_active)
                 emit DebugModeLeft();
@@ -75,7 +77,10 @@ void EmuThread::run() {
             was_active = false;
         } else {
             std::unique_lock lock{running_mutex};
-            running_cv.wait(lock, [this] { return IsRunning() || exec_step || stop_run; });
+            running_cv.wait(lock, [this] {
+                return IsRunning() || exec_step || stop_run || capture_snapshot ||
+                       restore_snapshot;
+            });
         }
     }
 
@@ -89,6 +94,16 @@ void EmuThread::run() {
     render_window->moveContext();
 }
 
+void EmuThread::ProcessSnapshotRequests() {
+    auto& system = Core::System::GetInstance();
+    if (capture_snapshot.exchange(false)) {
+        system.CaptureSnapshot();
+    }
+    if (restore_snapshot.exchange(false)) {
+        system.RestoreSnapshot();
+    }
+}
+
 class GGLContext : public Core::Frontend::GraphicsContext {
 public:
     explicit GGLContext(QOpenGLContext* shared_context)
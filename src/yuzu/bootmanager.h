@@ -77,10 +77,39 @@ public:
         SetRunning(false);
     }
 
+    /**
+     * Requests the emulation thread to capture a snapshot of the emulated state before running
+     * the next CPU slice
+     * @note This function is thread-safe
+     */
+    void RequestSnapshotCapture() {
+        std::unique_lock lock{running_mutex};
+        capture_snapshot = true;
+        lock.unlock();
+        running_cv.notify_all();
+    }
+
+    /**
+     * Requests the emulation thread to restore the last captured snapshot before running the
+     * next CPU slice
+     * @note This function is thread-safe
+     */
+    void RequestSnapshotRestore() {
+        std::unique_lock lock{running_mutex};
+        restore_snapshot = true;
+        lock.unlock();
+        running_cv.notify_all();
+    }
+
 private:
+    /// Handles the pending snapshot requests, snapshots can't be used in the middle of a slice
+    void ProcessSnapshotRequests();
+
     bool exec_step = false;
     bool running = false;
     std::atomic_bool stop_run{false};
+    std::atomic_bool capture_snapshot{false};
+    std::atomic_bool restore_snapshot{false};
     std::mutex running_mutex;
     std::condition_variable running_cv;
 
@@ -209,8 +209,10 @@ const std::array<int, Settings::NativeKeyboard::NumKeyboardMods> Config::default
 // QKeySequnce(...).toString() is NOT ALLOWED HERE.
 // This must be in alphabetical order according to action name as it must have the same order as
 // UISetting::values.shortcuts, which is alphabetically ordered.
-const std::array<UISettings::Shortcut, 15> Config::default_hotkeys{
+const std::array<UISettings::Shortcut, 18> Config::default_hotkeys{
     {{"Capture Screenshot", "Main Window", {"Ctrl+P", Qt::ApplicationShortcut}},
+     {"Capture Snapshot", "Main Window", {"F7", Qt::ApplicationShortcut}},
+     {"Capture Trace", "Main Window", {"Ctrl+T", Qt::ApplicationShortcut}},
      {"Continue/Pause Emulation", "Main Window", {"F4", Qt::WindowShortcut}},
      {"Decrease Speed Limit", "Main Window", {"-", Qt::ApplicationShortcut}},
      {"Exit yuzu", "Main Window", {"Ctrl+Q", Qt::WindowShortcut}},
@@ -220,6 +222,7 @@ const std::array<UISettings::Shortcut, 15> Config::default_hotkeys{
      {"Load Amiibo", "Main Window", {"F2", Qt::ApplicationShortcut}},
      {"Load File", "Main Window", {"Ctrl+O", Qt::WindowShortcut}},
      {"Restart Emulation", "Main Window", {"F6", Qt::WindowShortcut}},
+     {"Restore Snapshot", "Main Window", {"F8", Qt::ApplicationShortcut}},
      {"Stop Emulation", "Main Window", {"F5", Qt::WindowShortcut}},
      {"Toggle Filter Bar", "Main Window", {"Ctrl+F", Qt::WindowShortcut}},
      {"Toggle Speed Limit", "Main Window", {"Ctrl+Z", Qt::ApplicationShortcut}},
@@ -386,6 +389,8 @@ void Config::ReadValues() {
     qt_config->endGroup();
 
     qt_config->beginGroup("Renderer");
+    Settings::values.renderer_backend =
+        static_cast<Settings::RendererBackend>(ReadSetting("backend", 0).toInt());
     Settings::values.resolution_factor = ReadSetting("resolution_factor", 1.0).toFloat();
     Settings::values.use_frame_limit = ReadSetting("use_frame_limit", true).toBool();
     Settings::values.frame_limit = ReadSetting("frame_limit", 100).toInt();
@@ -396,6 +401,9 @@ void Config::ReadValues() {
         ReadSetting("use_accurate_gpu_emulation", false).toBool();
     Settings::values.use_asynchronous_gpu_emulation =
         ReadSetting("use_asynchronous_gpu_emulation", false).toBool();
+    Settings::values.use_gpu_swizzle = ReadSetting("use_gpu_swizzle", false).toBool();
+    Settings::values.present_mode =
+        static_cast<Settings::PresentMode>(ReadSetting("present_mode", 1).toInt());
     Settings::values.force_30fps_mode = ReadSetting("force_30fps_mode", false).toBool();
 
     Settings::values.bg_red = ReadSetting("bg_red", 0.0).toFloat();
@@ -660,6 +668,7 @@ void Config::SaveValues() {
     qt_config->endGroup();
 
     qt_config->beginGroup("Renderer");
+    WriteSetting("backend", static_cast<int>(Settings::values.renderer_backend), 0);
     WriteSetting("resolution_factor", (double)Settings::values.resolution_factor, 1.0);
     WriteSetting("use_frame_limit", Settings::values.use_frame_limit, true);
     WriteSetting("frame_limit", Settings::values.frame_limit, 100);
@@ -668,6 +677,8 @@ void Config::SaveValues() {
     WriteSetting("use_accurate_gpu_emulation", Settings::values.use_accurate_gpu_emulation, false);
     WriteSetting("use_asynchronous_gpu_emulation", Settings::values.use_asynchronous_gpu_emulation,
                  false);
+    WriteSetting("use_gpu_swizzle", Settings::values.use_gpu_swizzle, false);
+    WriteSetting("present_mode", static_cast<int>(Settings::values.present_mode), 1);
     WriteSetting("force_30fps_mode", Settings::values.force_30fps_mode, false);
 
     // Cast to double because Qt's written float values are not human-readable
@@ -160,11 +160,11 @@ std::unique_ptr<WaitTreeWaitObject> WaitTreeWaitObject::make(const Kernel::WaitO
 std::vector<std::unique_ptr<WaitTreeItem>> WaitTreeWaitObject::GetChildren() const {
     std::vector<std::unique_ptr<WaitTreeItem>> list;
 
-    const auto& threads = object.GetWaitingThreads();
+    auto threads = object.GetWaitingThreads();
     if (threads.empty()) {
         list.push_back(std::make_unique<WaitTreeText>(tr("waited by no thread")));
     } else {
-        list.push_back(std::make_unique<WaitTreeThreadList>(threads));
+        list.push_back(std::make_unique<WaitTreeThreadList>(std::move(threads)));
     }
     return list;
 }
@@ -180,9 +180,9 @@ QString WaitTreeWaitObject::GetResetTypeQString(Kernel::ResetType reset_type) {
     return {};
 }
 
-WaitTreeObjectList::WaitTreeObjectList(
-    const std::vector<Kernel::SharedPtr<Kernel::WaitObject>>& list, bool w_all)
-    : object_list(list), wait_all(w_all) {}
+WaitTreeObjectList::WaitTreeObjectList(std::vector<Kernel::SharedPtr<Kernel::WaitObject>> list,
+                                       bool w_all)
+    : object_list(std::move(list)), wait_all(w_all) {}
 
 WaitTreeObjectList::~WaitTreeObjectList() = default;
 
@@ -324,8 +324,11 @@ std::vector<std::unique_ptr<WaitTreeItem>> WaitTreeThread::GetChildren() const {
 
     if (thread.GetStatus() == Kernel::ThreadStatus::WaitSynchAny ||
         thread.GetStatus() == Kernel::ThreadStatus::WaitSynchAll) {
-        list.push_back(std::make_unique<WaitTreeObjectList>(thread.GetWaitObjects(),
-                                                            thread.IsSleepingOnWaitAll()));
+        const auto& wait_objects = thread.GetWaitObjects();
+        list.push_back(std::make_unique<WaitTreeObjectList>(
+            std::vector<Kernel::SharedPtr<Kernel::WaitObject>>(wait_objects.begin(),
+                                                               wait_objects.end()),
+            thread.IsSleepingOnWaitAll()));
     }
 
     list.push_back(std::make_unique<WaitTreeCallstack>(thread));
@@ -346,8 +349,8 @@ std::vector<std::unique_ptr<WaitTreeItem>> WaitTreeEvent::GetChildren() const {
     return list;
 }
 
-WaitTreeThreadList::WaitTreeThreadList(const std::vector<Kernel::SharedPtr<Kernel::Thread>>& list)
-    : thread_list(list) {}
+WaitTreeThreadList::WaitTreeThreadList(std::vector<Kernel::SharedPtr<Kernel::Thread>> list)
+    : thread_list(std::move(list)) {}
 WaitTreeThreadList::~WaitTreeThreadList() = default;
 
 QString WaitTreeThreadList::GetText() const {
@@ -221,9 +221,24 @@ GMainWindow::GMainWindow()
     // Show one-time "callout" messages to the user
     ShowTelemetryCallout();
 
-    QStringList args = QApplication::arguments();
-    if (args.length() >= 2) {
-        BootGame(args[1]);
+    QString game_path;
+    u32 trace_frames = 0;
+    u32 trace_start = 0;
+    for (const QString& arg : QApplication::arguments().mid(1)) {
+        if (arg.startsWith("--trace-frames=")) {
+            trace_frames = arg.section('=', 1).toUInt();
+        } else if (arg.startsWith("--trace-start=")) {
+            trace_start = arg.section('=', 1).toUInt();
+        } else if (game_path.isEmpty()) {
+            game_path = arg;
+        }
+    }
+    if (!game_path.isEmpty()) {
+        if (trace_frames != 0) {
+            Common::ProfileCapture::Start(Common::ProfileCapture::GetDefaultPath(), trace_frames,
+                                          trace_start);
+        }
+        BootGame(game_path);
     }
 }
 
@@ -604,6 +619,25 @@ void GMainWindow::InitializeHotkeys() {
                     OnCaptureScreenshot();
                 }
             });
+    connect(hotkey_registry.GetHotkey("Main Window", "Capture Snapshot", this),
+            &QShortcut::activated, this, [&] {
+                if (emulation_running) {
+                    emu_thread->RequestSnapshotCapture();
+                }
+            });
+    connect(hotkey_registry.GetHotkey("Main Window", "Restore Snapshot", this),
+            &QShortcut::activated, this, [&] {
+                if (emulation_running) {
+                    emu_thread->RequestSnapshotRestore();
+                }
+            });
+    connect(hotkey_registry.GetHotkey("Main Window", "Capture Trace", this),
+            &QShortcut::activated, this, [&] {
+                if (emulation_running && !Common::ProfileCapture::IsActive()) {
+                    Common::ProfileCapture::Start(Common::ProfileCapture::GetDefaultPath(),
+                                                  Common::ProfileCapture::DEFAULT_FRAME_COUNT);
+                }
+            });
     connect(hotkey_registry.GetHotkey("Main Window", "Change Docked Mode", this),
             &QShortcut::activated, this, [&] {
                 Settings::values.use_docked_mode = !Settings::values.use_docked_mode;
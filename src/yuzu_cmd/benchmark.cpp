@@ -0,0 +1,244 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/param_package.h"
+#include "common/string_util.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/process.h"
+#include "core/perf_stats.h"
+#include "core/settings.h"
+#include "input_common/keyboard.h"
+#include "input_common/main.h"
+#include "yuzu_cmd/benchmark.h"
+
+#ifdef _WIN32
+// windows.h needs to be included before psapi.h
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr std::array<std::pair<Core::FrameStage, const char*>, 3> FRAME_STAGES{{
+    {Core::FrameStage::Game, "game"},
+    {Core::FrameStage::System, "system"},
+    {Core::FrameStage::Present, "present"},
+}};
+
+/// Returns the peak resident memory of the host process in bytes
+u64 GetHostMemoryPeak() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<u64>(counters.PeakWorkingSetSize);
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<u64>(usage.ru_maxrss);
+#else
+    // Linux and the BSDs report kilobytes
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// Returns the keyboard key mapped to the first player's button, or -1 if it isn't mapped to one
+int FindButtonKey(const std::string& name) {
+    constexpr std::size_t prefix_length = std::char_traits<char>::length("button_");
+    for (std::size_t i = 0; i < Settings::NativeButton::NumButtons; ++i) {
+        if (name != Settings::NativeButton::mapping[i] + prefix_length) {
+            continue;
+        }
+        const Common::ParamPackage params{Settings::values.players[0].buttons[i]};
+        if (params.Get("engine", "") != "keyboard") {
+            return -1;
+        }
+        return params.Get("code", -1);
+    }
+    return -1;
+}
+
+std::string FormatFrameTimeStats(const Core::FrameTimeStats& stats) {
+    return fmt::format("{{\"frames\":{},\"average_ms\":{:.4f},\"p50_ms\":{:.4f},\"p95_ms\":{:.4f},"
+                       "\"p99_ms\":{:.4f},\"max_ms\":{:.4f},\"stutters\":{}}}",
+                       stats.frames, stats.average, stats.p50, stats.p95, stats.p99, stats.max,
+                       stats.stutters);
+}
+
+/// JSON has no representation for NaN, averages over no frames are reported as zero
+double Finite(double value) {
+    return std::isfinite(value) ? value : 0.0;
+}
+
+std::string EscapeJson(const std::string& text) {
+    std::string escaped;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // Anonymous namespace
+
+Benchmark::Benchmark(Core::System& system, BenchmarkOptions options)
+    : system{system}, options{std::move(options)} {}
+
+Benchmark::~Benchmark() = default;
+
+bool Benchmark::LoadInputScript() {
+    if (options.input_script_path.empty()) {
+        return true;
+    }
+    std::string script;
+    if (FileUtil::ReadFileToString(true, options.input_script_path.c_str(), script) == 0) {
+        LOG_CRITICAL(Frontend, "Failed to read the input script {}", options.input_script_path);
+        return false;
+    }
+
+    std::istringstream stream{script};
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(stream, line); ++line_number) {
+        line = Common::StripSpaces(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream line_stream{line};
+        u64 frame = 0;
+        std::string action;
+        std::string button;
+        if (!(line_stream >> frame >> action >> button) ||
+            (action != "press" && action != "release")) {
+            LOG_CRITICAL(Frontend, "Invalid input script event on line {}: {}", line_number,
+                         line);
+            return false;
+        }
+        const int key_code = FindButtonKey(button);
+        if (key_code < 0) {
+            LOG_CRITICAL(Frontend, "Button {} on line {} is not mapped to a keyboard key", button,
+                         line_number);
+            return false;
+        }
+        input_events.push_back({frame, key_code, action == "press"});
+    }
+    // Events of the same frame keep their order
+    std::stable_sort(input_events.begin(), input_events.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.frame < rhs.frame; });
+    return true;
+}
+
+void Benchmark::Start() {
+    auto& perf_stats = system.GetPerfStats();
+    start_walltime = std::chrono::steady_clock::now();
+    start_emulated_time = system.CoreTiming().GetGlobalTimeUs();
+    start_frame = perf_stats.GetTotalGameFrames();
+    for (std::size_t i = 0; i < FRAME_STAGES.size(); ++i) {
+        start_recorded_frames[i] = perf_stats.GetNumRecordedFrames(FRAME_STAGES[i].first);
+    }
+    system.GetAndResetPerfStats();
+    Common::ProfileCapture::BeginTotals();
+
+    LOG_INFO(Frontend, "Benchmark started, running for {} frames and {} us of emulated time",
+             options.num_frames, options.emulated_time.count());
+}
+
+bool Benchmark::Update() {
+    frames_run = system.GetPerfStats().GetTotalGameFrames() - start_frame;
+    emulated_time_run = system.CoreTiming().GetGlobalTimeUs() - start_emulated_time;
+
+    auto* const keyboard = InputCommon::GetKeyboard();
+    for (; next_input_event < input_events.size(); ++next_input_event) {
+        const InputEvent& event = input_events[next_input_event];
+        if (event.frame > frames_run) {
+            break;
+        }
+        if (event.is_press) {
+            keyboard->PressKey(event.key_code);
+        } else {
+            keyboard->ReleaseKey(event.key_code);
+        }
+    }
+
+    if (const Kernel::Process* const process = system.CurrentProcess(); process != nullptr) {
+        guest_memory_peak = std::max(guest_memory_peak, process->GetTotalPhysicalMemoryUsed());
+    }
+
+    return (options.num_frames != 0 && frames_run >= options.num_frames) ||
+           (options.emulated_time.count() != 0 && emulated_time_run >= options.emulated_time);
+}
+
+bool Benchmark::WriteReport() {
+    const double walltime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_walltime).count();
+    const Core::PerfStatsResults results = system.GetAndResetPerfStats();
+    const auto& perf_stats = system.GetPerfStats();
+    const std::vector<Common::ProfileCapture::TimerTotal> timers =
+        Common::ProfileCapture::EndTotals();
+
+    std::string report = "{\n";
+    report += fmt::format("  \"frames\": {},\n  \"emulated_time_ms\": {:.3f},\n"
+                          "  \"walltime_s\": {:.3f},\n",
+                          frames_run, emulated_time_run.count() / 1000.0, walltime);
+    report += fmt::format(
+        "  \"perf_stats\": {{\"system_fps\":{:.3f},\"game_fps\":{:.3f},\"frametime_ms\":{:.4f},"
+        "\"emulation_speed\":{:.4f},\"present_fps\":{:.3f},\"present_latency_ms\":{:.4f}}},\n",
+        Finite(results.system_fps), Finite(results.game_fps), Finite(results.frametime * 1000.0),
+        Finite(results.emulation_speed), Finite(results.present_fps),
+        Finite(results.present_latency * 1000.0));
+
+    report += "  \"frame_times\": {";
+    for (std::size_t i = 0; i < FRAME_STAGES.size(); ++i) {
+        const auto [stage, name] = FRAME_STAGES[i];
+        const u64 num_frames = perf_stats.GetNumRecordedFrames(stage) - start_recorded_frames[i];
+        const auto stats =
+            perf_stats.GetFrameTimeStats(stage, static_cast<std::size_t>(num_frames));
+        report += fmt::format("{}\n    \"{}\": {}", i == 0 ? "" : ",", name,
+                              FormatFrameTimeStats(stats));
+    }
+    report += "\n  },\n";
+
+    report += "  \"microprofile\": [";
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+        const auto& timer = timers[i];
+        report += fmt::format(
+            "{}\n    {{\"group\":\"{}\",\"name\":\"{}\",\"count\":{},\"total_ms\":{:.4f}}}",
+            i == 0 ? "" : ",", EscapeJson(timer.group), EscapeJson(timer.name), timer.count,
+            timer.total_ms);
+    }
+    report += "\n  ],\n";
+
+    report += fmt::format("  \"memory\": {{\"host_peak_bytes\":{},\"guest_peak_bytes\":{}}}\n}}\n",
+                          GetHostMemoryPeak(), guest_memory_peak);
+
+    if (options.report_path.empty()) {
+        std::cout << report << std::flush;
+        return true;
+    }
+    FileUtil::IOFile file(options.report_path, "w");
+    if (!file.IsOpen() || file.WriteBytes(report.data(), report.size()) != report.size()) {
+        LOG_CRITICAL(Frontend, "Failed to write the benchmark report to {}", options.report_path);
+        return false;
+    }
+    LOG_INFO(Frontend, "Wrote the benchmark report to {}", options.report_path);
+    return true;
+}
@@ -0,0 +1,86 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/frame_time_recorder.h"
+
+namespace Core {
+class System;
+}
+
+struct BenchmarkOptions {
+    /// Game frames to run for, 0 doesn't limit the frames
+    u64 num_frames = 0;
+    /// Emulated time to run for, 0 doesn't limit the time
+    std::chrono::microseconds emulated_time{0};
+    /// Input script to play, empty to play no input
+    std::string input_script_path;
+    /// File to write the report to, empty to write it to the standard output
+    std::string report_path;
+
+    /// Returns true when a run length has been specified
+    bool IsEnabled() const {
+        return num_frames != 0 || emulated_time.count() != 0;
+    }
+};
+
+/**
+ * Runs the emulation for a fixed number of game frames or a fixed emulated time, optionally
+ * playing scripted input, and writes a JSON report of the performance of the run.
+ *
+ * Input scripts have an event per line, formatted as "<frame> <press|release> <button>". Frames
+ * are counted from the beginning of the run and buttons are named after the first player's
+ * mappings without their prefix (a, b, dup, plus...). The buttons have to be mapped to the
+ * keyboard. Empty lines and lines starting with '#' are ignored.
+ */
+class Benchmark {
+public:
+    explicit Benchmark(Core::System& system, BenchmarkOptions options);
+    ~Benchmark();
+
+    /// Parses the input script, returns false on error
+    bool LoadInputScript();
+
+    /// Starts measuring, it has to be called right before running the emulation
+    void Start();
+
+    /**
+     * Plays the input scheduled up to the current frame and samples the memory usage. It has to
+     * be called periodically while the emulation runs.
+     * @returns true once the run has reached its length
+     */
+    bool Update();
+
+    /// Writes the report of the run, returns false on error
+    bool WriteReport();
+
+private:
+    struct InputEvent {
+        u64 frame;
+        int key_code;
+        bool is_press;
+    };
+
+    Core::System& system;
+    BenchmarkOptions options;
+
+    std::vector<InputEvent> input_events;
+    std::size_t next_input_event = 0;
+
+    std::chrono::steady_clock::time_point start_walltime;
+    std::chrono::microseconds start_emulated_time{0};
+    u64 start_frame = 0;
+    std::array<u64, static_cast<std::size_t>(Core::FrameStage::Count)> start_recorded_frames{};
+
+    u64 frames_run = 0;
+    std::chrono::microseconds emulated_time_run{0};
+    u64 guest_memory_peak = 0;
+};
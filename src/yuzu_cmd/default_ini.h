@@ -85,6 +85,10 @@ use_cpu_jit =
 use_multi_core=
 
 [Renderer]
+# Which rendering backend to use
+# 0 (default): OpenGL, 1: Null (emulates the GPU without presenting, no graphics context needed)
+backend =
+
 # Whether to use software or hardware rendering.
 # 0: Software, 1 (default): Hardware
 use_hw_renderer =
@@ -122,6 +126,15 @@ use_accurate_gpu_emulation =
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
 
+# Whether to swizzle and unswizzle textures in a compute shader instead of on the CPU (experimental)
+# 0 (default): Off, 1 : On
+use_gpu_swizzle =
+
+# How finished frames are presented to the window, on their own thread when supported
+# 0: VSync (present every frame, rendering waits for the display), 1 (default): Mailbox (present the
+# latest frame at the display rate), 2: Uncapped (present the latest frame immediately)
+present_mode =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 1.0 for all.
 bg_red =
@@ -224,6 +237,8 @@ gdbstub_port=24689
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# When set, records the GPU command stream to this file so it can be replayed with yuzu-gpu-replay
+gpu_capture_path =
 
 [WebService]
 # Whether or not to enable telemetry
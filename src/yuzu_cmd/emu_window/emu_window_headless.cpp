@@ -0,0 +1,41 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <csignal>
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "core/frontend/framebuffer_layout.h"
+#include "core/settings.h"
+#include "input_common/main.h"
+#include "yuzu_cmd/emu_window/emu_window_headless.h"
+
+namespace {
+std::atomic_bool quit_requested{false};
+
+void OnQuitSignal(int) {
+    quit_requested = true;
+}
+} // Anonymous namespace
+
+EmuWindow_Headless::EmuWindow_Headless() {
+    InputCommon::Init();
+
+    std::signal(SIGINT, OnQuitSignal);
+    std::signal(SIGTERM, OnQuitSignal);
+
+    UpdateCurrentFramebufferLayout(Layout::ScreenUndocked::Width, Layout::ScreenUndocked::Height);
+
+    LOG_INFO(Frontend, "yuzu Version: {} | {}-{}", Common::g_build_fullname, Common::g_scm_branch,
+             Common::g_scm_desc);
+    Settings::LogSettings();
+}
+
+EmuWindow_Headless::~EmuWindow_Headless() {
+    InputCommon::Shutdown();
+}
+
+bool EmuWindow_Headless::IsOpen() const {
+    return !quit_requested;
+}
@@ -0,0 +1,26 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "core/frontend/emu_window.h"
+
+/// Window without any graphics context, used together with the null renderer.
+class EmuWindow_Headless : public Core::Frontend::EmuWindow {
+public:
+    EmuWindow_Headless();
+    ~EmuWindow_Headless();
+
+    void SwapBuffers() override {}
+
+    /// Polls window events
+    void PollEvents() override {}
+
+    void MakeCurrent() override {}
+
+    void DoneCurrent() override {}
+
+    /// Whether the emulation should keep running, this turns false on SIGINT/SIGTERM
+    bool IsOpen() const;
+};
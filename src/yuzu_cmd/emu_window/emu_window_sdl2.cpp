@@ -10,6 +10,7 @@
 #include <fmt/format.h>
 #include <glad/glad.h>
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "common/scm_rev.h"
 #include "common/string_util.h"
 #include "core/settings.h"
@@ -50,6 +51,49 @@ private:
     SDL_GLContext context;
 };
 
+class SDLPresentationContext : public Core::Frontend::GraphicsContext {
+public:
+    explicit SDLPresentationContext(SDL_Window* window) : window{window} {
+        // Creating the context makes it current, give the calling thread its context back
+        SDL_GLContext current_context = SDL_GL_GetCurrentContext();
+        context = SDL_GL_CreateContext(window);
+        SDL_GL_MakeCurrent(window, current_context);
+    }
+
+    ~SDLPresentationContext() {
+        if (context != nullptr) {
+            SDL_GL_DeleteContext(context);
+        }
+    }
+
+    bool IsValid() const {
+        return context != nullptr;
+    }
+
+    void MakeCurrent() override {
+        SDL_GL_MakeCurrent(window, context);
+        if (!is_swap_interval_set) {
+            // The swap interval may be a property of the context, frames are paced by the
+            // presentation mode rather than the driver default
+            SDL_GL_SetSwapInterval(0);
+            is_swap_interval_set = true;
+        }
+    }
+
+    void DoneCurrent() override {
+        SDL_GL_MakeCurrent(window, nullptr);
+    }
+
+    void SwapBuffers() override {
+        SDL_GL_SwapWindow(window);
+    }
+
+private:
+    SDL_Window* window;
+    SDL_GLContext context;
+    bool is_swap_interval_set = false;
+};
+
 void EmuWindow_SDL2::OnMouseMotion(s32 x, s32 y) {
     TouchMoved((unsigned)std::max(x, 0), (unsigned)std::max(y, 0));
     InputCommon::GetMotionEmu()->Tilt(x, y);
@@ -101,6 +145,13 @@ void EmuWindow_SDL2::OnFingerUp() {
 }
 
 void EmuWindow_SDL2::OnKeyEvent(int key, u8 state) {
+    if (key == SDL_SCANCODE_F9) {
+        if (state == SDL_PRESSED && !Common::ProfileCapture::IsActive()) {
+            Common::ProfileCapture::Start(Common::ProfileCapture::GetDefaultPath(),
+                                          Common::ProfileCapture::DEFAULT_FRAME_COUNT);
+        }
+        return;
+    }
     if (state == SDL_PRESSED) {
         InputCommon::GetKeyboard()->PressKey(key);
     } else if (state == SDL_RELEASED) {
@@ -313,3 +364,13 @@ void EmuWindow_SDL2::OnMinimalClientAreaChangeRequest(
 std::unique_ptr<Core::Frontend::GraphicsContext> EmuWindow_SDL2::CreateSharedContext() const {
     return std::make_unique<SDLGLContext>();
 }
+
+std::unique_ptr<Core::Frontend::GraphicsContext> EmuWindow_SDL2::CreatePresentationContext()
+    const {
+    auto context = std::make_unique<SDLPresentationContext>(render_window);
+    if (!context->IsValid()) {
+        LOG_ERROR(Frontend, "Failed to create the presentation context: {}", SDL_GetError());
+        return nullptr;
+    }
+    return context;
+}
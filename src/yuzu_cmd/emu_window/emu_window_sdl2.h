@@ -29,6 +29,8 @@ public:
 
     std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
 
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreatePresentationContext() const override;
+
     /// Whether the window is still open, and a close request hasn't yet been sent
     bool IsOpen() const;
 
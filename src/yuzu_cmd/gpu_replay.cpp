@@ -0,0 +1,340 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/icl/interval_set.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "core/core.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/hle/service/filesystem/filesystem.h"
+#include "core/memory.h"
+#include "core/settings.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+#include "video_core/memory_manager.h"
+#include "yuzu_cmd/config.h"
+#include "yuzu_cmd/emu_window/emu_window_headless.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2.h"
+
+#include <getopt.h>
+
+namespace GPUCapture = VideoCommon::GPUCapture;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Host time spent on a single replay stage
+struct StageTimings {
+    u64 count{};
+    std::chrono::nanoseconds total{};
+    std::chrono::nanoseconds max{};
+
+    void Add(std::chrono::nanoseconds duration) {
+        ++count;
+        total += duration;
+        max = std::max(max, duration);
+    }
+};
+
+/// Copies the fixed size header of a record payload, returns false if the payload is too small.
+template <typename T>
+bool ReadPayload(const std::vector<u8>& payload, T& out) {
+    if (payload.size() < sizeof(T)) {
+        LOG_ERROR(Frontend, "GPU capture record is too small");
+        return false;
+    }
+    std::memcpy(&out, payload.data(), sizeof(T));
+    return true;
+}
+
+/// Replays a capture through the emulated GPU, measuring the host time spent on each stage.
+class Replayer {
+public:
+    explicit Replayer(Core::System& system, Kernel::Process& process)
+        : system{system}, process{process} {}
+
+    /// Maps all the guest memory referenced by the capture, ahead of the replay.
+    bool AllocateGuestMemory(const std::string& path) {
+        GPUCapture::Reader reader{path};
+        if (!reader.IsValid()) {
+            return false;
+        }
+
+        // Regions are merged so each GPU mapping is backed by contiguous host memory, the GPU
+        // memory manager relies on that.
+        boost::icl::interval_set<VAddr> guest_ranges;
+        while (const auto record = reader.Next()) {
+            if (record->type != GPUCapture::RecordType::MapRegion) {
+                continue;
+            }
+            GPUCapture::MapRegionRecord map;
+            if (!ReadPayload(record->payload, map)) {
+                return false;
+            }
+            guest_ranges.add(boost::icl::interval<VAddr>::right_open(
+                map.cpu_addr, map.cpu_addr + map.size));
+        }
+
+        auto& vm_manager = process.VMManager();
+        for (const auto& range : guest_ranges) {
+            const VAddr base{range.lower() & ~Memory::PAGE_MASK};
+            const u64 size{((range.upper() + Memory::PAGE_MASK) & ~Memory::PAGE_MASK) - base};
+            const auto result = vm_manager.MapMemoryBlock(
+                base, std::make_shared<std::vector<u8>>(size), 0, size, Kernel::MemoryState::Heap);
+            if (!result.Succeeded()) {
+                LOG_CRITICAL(Frontend, "Failed to map guest memory at 0x{:016X}-0x{:016X}", base,
+                             base + size);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Replays the capture, stopping after max_frames frames when it's not zero.
+    bool Replay(const std::string& path, u64 max_frames) {
+        GPUCapture::Reader reader{path};
+        if (!reader.IsValid()) {
+            return false;
+        }
+
+        auto& gpu = system.GPU();
+        auto frame_start = Clock::now();
+        while (const auto record = reader.Next()) {
+            const auto& payload = record->payload;
+            const auto start = Clock::now();
+
+            switch (record->type) {
+            case GPUCapture::RecordType::MapRegion: {
+                GPUCapture::MapRegionRecord map;
+                if (!ReadPayload(payload, map)) {
+                    return false;
+                }
+                gpu.MemoryManager().MapBufferEx(map.cpu_addr, map.gpu_addr, map.size);
+                mapping.Add(Clock::now() - start);
+                break;
+            }
+            case GPUCapture::RecordType::UnmapRegion: {
+                GPUCapture::UnmapRegionRecord unmap;
+                if (!ReadPayload(payload, unmap)) {
+                    return false;
+                }
+                gpu.MemoryManager().UnmapBuffer(unmap.gpu_addr, unmap.size);
+                mapping.Add(Clock::now() - start);
+                break;
+            }
+            case GPUCapture::RecordType::MemoryPage: {
+                GPUCapture::MemoryPageRecord page;
+                if (!ReadPayload(payload, page)) {
+                    return false;
+                }
+                // Write through the regular guest memory path, so caches get invalidated just like
+                // they would when the guest CPU writes to memory.
+                Memory::WriteBlock(page.cpu_addr, payload.data() + sizeof(page),
+                                   payload.size() - sizeof(page));
+                memory.Add(Clock::now() - start);
+                break;
+            }
+            case GPUCapture::RecordType::CommandList: {
+                Tegra::CommandList entries(payload.size() / sizeof(Tegra::CommandListHeader));
+                std::memcpy(entries.data(), payload.data(),
+                            entries.size() * sizeof(Tegra::CommandListHeader));
+                gpu.PushGPUEntries(std::move(entries));
+                command_lists.Add(Clock::now() - start);
+                break;
+            }
+            case GPUCapture::RecordType::SwapBuffers: {
+                GPUCapture::SwapBuffersRecord swap;
+                if (!ReadPayload(payload, swap)) {
+                    return false;
+                }
+                if (swap.has_framebuffer) {
+                    gpu.SwapBuffers(swap.framebuffer);
+                } else {
+                    gpu.SwapBuffers({});
+                }
+                const auto end = Clock::now();
+                swap_buffers.Add(end - start);
+                frames.Add(end - frame_start);
+                frame_start = end;
+
+                if (max_frames != 0 && frames.count >= max_frames) {
+                    return true;
+                }
+                break;
+            }
+            default:
+                LOG_ERROR(Frontend, "Unknown GPU capture record type {}",
+                          static_cast<u32>(record->type));
+                break;
+            }
+        }
+        return true;
+    }
+
+    void PrintReport() const {
+        std::cout << fmt::format("{:<16} {:>10} {:>12} {:>12} {:>12}\n", "stage", "count",
+                                 "total (ms)", "avg (us)", "max (us)");
+        PrintStage("mapping", mapping);
+        PrintStage("memory upload", memory);
+        PrintStage("command lists", command_lists);
+        PrintStage("swap buffers", swap_buffers);
+        PrintStage("frame", frames);
+    }
+
+private:
+    static void PrintStage(const char* name, const StageTimings& timings) {
+        using namespace std::chrono;
+        const double total_ms{duration_cast<duration<double, std::milli>>(timings.total).count()};
+        const double max_us{duration_cast<duration<double, std::micro>>(timings.max).count()};
+        const double avg_us{timings.count != 0 ? total_ms * 1000.0 / timings.count : 0.0};
+        std::cout << fmt::format("{:<16} {:>10} {:>12.3f} {:>12.3f} {:>12.3f}\n", name,
+                                 timings.count, total_ms, avg_us, max_us);
+    }
+
+    Core::System& system;
+    Kernel::Process& process;
+
+    StageTimings mapping;
+    StageTimings memory;
+    StageTimings command_lists;
+    StageTimings swap_buffers;
+    StageTimings frames;
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <capture>\n"
+                 "-n, --frames=NUMBER   Stop after replaying NUMBER frames\n"
+                 "-N, --null-renderer   Replay with the null renderer, no window is created\n"
+                 "-h, --help            Display this help and exit\n"
+                 "-v, --version         Output version information and exit\n";
+}
+
+void PrintVersion() {
+    std::cout << "yuzu-gpu-replay " << Common::g_scm_branch << " " << Common::g_scm_desc
+              << std::endl;
+}
+
+void InitializeLogging() {
+    Log::Filter log_filter(Log::Level::Debug);
+    log_filter.ParseFilterString(Settings::values.log_filter);
+    Log::SetGlobalFilter(log_filter);
+
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Config config;
+    InitializeLogging();
+
+    u64 max_frames = 0;
+    std::string filepath;
+
+    int option_index = 0;
+    static struct option long_options[] = {
+        {"frames", required_argument, 0, 'n'},
+        {"null-renderer", no_argument, 0, 'N'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        const int arg = getopt_long(argc, argv, "n:Nhv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'n':
+                max_frames = std::strtoull(optarg, nullptr, 0);
+                break;
+            case 'N':
+                Settings::values.renderer_backend = Settings::RendererBackend::Null;
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            }
+        } else {
+            filepath = argv[optind];
+            optind++;
+        }
+    }
+
+    if (filepath.empty()) {
+        LOG_CRITICAL(Frontend, "No GPU capture specified");
+        return -1;
+    }
+
+    MicroProfileOnThreadCreate("EmuThread");
+    SCOPE_EXIT({ MicroProfileShutdown(); });
+
+    // Replays are always synchronous and unthrottled, so the measured time is the time it takes
+    // to process the command stream.
+    Settings::values.use_asynchronous_gpu_emulation = false;
+    Settings::values.use_frame_limit = false;
+    Settings::values.use_multi_core = false;
+    Settings::values.gpu_capture_path.clear();
+    Settings::Apply();
+
+    std::unique_ptr<EmuWindow_SDL2> sdl_window;
+    std::unique_ptr<EmuWindow_Headless> headless_window;
+    if (Settings::values.renderer_backend == Settings::RendererBackend::Null) {
+        headless_window = std::make_unique<EmuWindow_Headless>();
+    } else {
+        sdl_window = std::make_unique<EmuWindow_SDL2>(false);
+    }
+    Core::Frontend::EmuWindow* const emu_window{
+        sdl_window ? static_cast<Core::Frontend::EmuWindow*>(sdl_window.get())
+                   : headless_window.get()};
+    emu_window->MakeCurrent();
+
+    Core::System& system{Core::System::GetInstance()};
+    system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
+    system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
+    Service::FileSystem::CreateFactories(*system.GetFilesystem());
+
+    SCOPE_EXIT({ system.Shutdown(); });
+
+    if (system.Init(*emu_window) != Core::System::ResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize the emulated system");
+        return -1;
+    }
+
+    auto process = Kernel::Process::Create(system, "GPUReplay");
+    system.Kernel().MakeCurrentProcess(process.get());
+
+    Replayer replayer{system, *process};
+    if (!replayer.AllocateGuestMemory(filepath) || !replayer.Replay(filepath, max_frames)) {
+        LOG_CRITICAL(Frontend, "Failed to replay GPU capture {}", filepath);
+        return -1;
+    }
+
+    replayer.PrintReport();
+    return 0;
+}
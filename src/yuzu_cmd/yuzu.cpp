@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -26,10 +27,13 @@
 #include "core/gdbstub/gdbstub.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
+#include "core/perf_stats.h"
 #include "core/settings.h"
 #include "core/telemetry_session.h"
 #include "video_core/renderer_base.h"
+#include "yuzu_cmd/benchmark.h"
 #include "yuzu_cmd/config.h"
+#include "yuzu_cmd/emu_window/emu_window_headless.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 
 #include <getopt.h>
@@ -61,7 +65,19 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-c, --gpu-capture=FILE  Record the GPU command stream to FILE\n"
+                 "-n, --null-renderer   Emulate the GPU without presenting, no window is created\n"
+                 "-t, --trace-frames=N  Record the profiling scopes of N frames as a Chrome trace\n"
+                 "    --trace-start=N   Skip N frames before starting the trace capture\n"
+                 "    --trace-output=FILE  Write the trace capture to FILE\n"
+                 "    --frame-times=FILE  Write the time of every frame to FILE as CSV on exit\n"
+                 "    --benchmark-frames=N  Run N game frames, write a performance report, exit\n"
+                 "    --benchmark-time=S  Run S seconds of emulated time, write a report and exit\n"
+                 "    --benchmark-input=FILE  Play the input script FILE during the benchmark\n"
+                 "    --benchmark-report=FILE  Write the benchmark report to FILE\n"
+                 "    --unthrottled     Run as fast as possible, without frame limiting\n"
+                 "F9 starts a trace capture while the game is running\n";
 }
 
 static void PrintVersion() {
@@ -108,14 +124,29 @@ int main(int argc, char** argv) {
 
     bool fullscreen = false;
 
+    u32 trace_frames = 0;
+    u32 trace_start = 0;
+    std::string trace_path;
+    std::string frame_times_path;
+    BenchmarkOptions benchmark_options;
+
     static struct option long_options[] = {
-        {"gdbport", required_argument, 0, 'g'}, {"fullscreen", no_argument, 0, 'f'},
-        {"help", no_argument, 0, 'h'},          {"version", no_argument, 0, 'v'},
-        {"program", optional_argument, 0, 'p'}, {0, 0, 0, 0},
+        {"gdbport", required_argument, 0, 'g'},     {"fullscreen", no_argument, 0, 'f'},
+        {"help", no_argument, 0, 'h'},              {"version", no_argument, 0, 'v'},
+        {"program", optional_argument, 0, 'p'},     {"gpu-capture", required_argument, 0, 'c'},
+        {"null-renderer", no_argument, 0, 'n'},     {"trace-frames", required_argument, 0, 't'},
+        {"trace-start", required_argument, 0, 's'}, {"trace-output", required_argument, 0, 'o'},
+        {"frame-times", required_argument, 0, 'r'},
+        {"benchmark-frames", required_argument, 0, 'B'},
+        {"benchmark-time", required_argument, 0, 'T'},
+        {"benchmark-input", required_argument, 0, 'I'},
+        {"benchmark-report", required_argument, 0, 'R'},
+        {"unthrottled", no_argument, 0, 'u'},
+        {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::c:nt:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -143,6 +174,58 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 'c':
+                Settings::values.gpu_capture_path = optarg;
+                break;
+            case 'n':
+                Settings::values.renderer_backend = Settings::RendererBackend::Null;
+                break;
+            case 't':
+                trace_frames = static_cast<u32>(strtoul(optarg, &endarg, 0));
+                if (endarg == optarg || trace_frames == 0) {
+                    std::cerr << "--trace-frames: invalid frame count" << std::endl;
+                    return 1;
+                }
+                break;
+            case 's':
+                trace_start = static_cast<u32>(strtoul(optarg, &endarg, 0));
+                if (endarg == optarg) {
+                    std::cerr << "--trace-start: invalid frame count" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'o':
+                trace_path = optarg;
+                break;
+            case 'r':
+                frame_times_path = optarg;
+                break;
+            case 'B':
+                benchmark_options.num_frames = strtoull(optarg, &endarg, 0);
+                if (endarg == optarg || benchmark_options.num_frames == 0) {
+                    std::cerr << "--benchmark-frames: invalid frame count" << std::endl;
+                    return 1;
+                }
+                break;
+            case 'T': {
+                const double seconds = strtod(optarg, &endarg);
+                if (endarg == optarg || seconds <= 0.0) {
+                    std::cerr << "--benchmark-time: invalid time" << std::endl;
+                    return 1;
+                }
+                benchmark_options.emulated_time =
+                    std::chrono::microseconds{static_cast<s64>(seconds * 1'000'000.0)};
+                break;
+            }
+            case 'I':
+                benchmark_options.input_script_path = optarg;
+                break;
+            case 'R':
+                benchmark_options.report_path = optarg;
+                break;
+            case 'u':
+                Settings::values.use_frame_limit = false;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -171,7 +254,20 @@ int main(int argc, char** argv) {
     Settings::values.use_gdbstub = use_gdbstub;
     Settings::Apply();
 
-    std::unique_ptr<EmuWindow_SDL2> emu_window{std::make_unique<EmuWindow_SDL2>(fullscreen)};
+    // The null renderer doesn't need a graphics context, so no window is created for it
+    std::unique_ptr<EmuWindow_SDL2> sdl_window;
+    std::unique_ptr<EmuWindow_Headless> headless_window;
+    if (Settings::values.renderer_backend == Settings::RendererBackend::Null) {
+        headless_window = std::make_unique<EmuWindow_Headless>();
+    } else {
+        sdl_window = std::make_unique<EmuWindow_SDL2>(fullscreen);
+    }
+    Core::Frontend::EmuWindow* const emu_window{
+        sdl_window ? static_cast<Core::Frontend::EmuWindow*>(sdl_window.get())
+                   : headless_window.get()};
+    const auto is_window_open = [&] {
+        return sdl_window ? sdl_window->IsOpen() : headless_window->IsOpen();
+    };
 
     if (!Settings::values.use_multi_core) {
         // Single core mode must acquire OpenGL context for entire emulation session
@@ -179,6 +275,15 @@ int main(int argc, char** argv) {
     }
 
     Core::System& system{Core::System::GetInstance()};
+
+    std::unique_ptr<Benchmark> benchmark;
+    if (benchmark_options.IsEnabled()) {
+        benchmark = std::make_unique<Benchmark>(system, std::move(benchmark_options));
+        if (!benchmark->LoadInputScript()) {
+            return -1;
+        }
+    }
+
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
     system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
     Service::FileSystem::CreateFactories(*system.GetFilesystem());
@@ -222,8 +327,43 @@ int main(int argc, char** argv) {
 
     system.Renderer().Rasterizer().LoadDiskResources();
 
-    while (emu_window->IsOpen()) {
+    if (trace_frames != 0) {
+        Common::ProfileCapture::Start(
+            trace_path.empty() ? Common::ProfileCapture::GetDefaultPath() : trace_path,
+            trace_frames, trace_start);
+    }
+
+    if (benchmark) {
+        benchmark->Start();
+    }
+
+    while (is_window_open()) {
         system.RunLoop();
+        if (benchmark && benchmark->Update()) {
+            break;
+        }
+    }
+
+    if (benchmark && !benchmark->WriteReport()) {
+        return -1;
+    }
+
+    if (!frame_times_path.empty()) {
+        const auto& perf_stats = system.GetPerfStats();
+        constexpr std::array<std::pair<Core::FrameStage, const char*>, 3> stages{{
+            {Core::FrameStage::Game, "Game"},
+            {Core::FrameStage::System, "System"},
+            {Core::FrameStage::Present, "Present"},
+        }};
+        for (const auto& [stage, name] : stages) {
+            const Core::FrameTimeStats stats = perf_stats.GetFrameTimeStats(stage);
+            LOG_INFO(Frontend,
+                     "{} frame times: {} frames, average {:.2f} ms, p50 {:.2f} ms, p95 {:.2f} ms, "
+                     "p99 {:.2f} ms, max {:.2f} ms, {} stutters",
+                     name, stats.frames, stats.average, stats.p50, stats.p95, stats.p99, stats.max,
+                     stats.stutters);
+        }
+        perf_stats.WriteFrameTimes(frame_times_path);
     }
 
     detached_tasks.WaitForAllTasks();